@@ -31,6 +31,7 @@
 #include <boost/compute/lambda.hpp>
 #include <boost/compute/pipe.hpp>
 #include <boost/compute/platform.hpp>
+#include <boost/compute/prefetch_kernels.hpp>
 #include <boost/compute/program.hpp>
 #include <boost/compute/random.hpp>
 #include <boost/compute/svm.hpp>
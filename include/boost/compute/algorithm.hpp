@@ -39,6 +39,9 @@
 #include <boost/compute/algorithm/gather.hpp>
 #include <boost/compute/algorithm/generate.hpp>
 #include <boost/compute/algorithm/generate_n.hpp>
+#include <boost/compute/algorithm/group_by_aggregate.hpp>
+#include <boost/compute/algorithm/hash_join.hpp>
+#include <boost/compute/algorithm/histogram.hpp>
 #include <boost/compute/algorithm/inclusive_scan.hpp>
 #include <boost/compute/algorithm/includes.hpp>
 #include <boost/compute/algorithm/inner_product.hpp>
@@ -52,6 +55,7 @@
 #include <boost/compute/algorithm/min_element.hpp>
 #include <boost/compute/algorithm/minmax_element.hpp>
 #include <boost/compute/algorithm/mismatch.hpp>
+#include <boost/compute/algorithm/multi_reduce.hpp>
 #include <boost/compute/algorithm/next_permutation.hpp>
 #include <boost/compute/algorithm/none_of.hpp>
 #include <boost/compute/algorithm/partial_sum.hpp>
@@ -72,14 +76,18 @@
 #include <boost/compute/algorithm/scatter.hpp>
 #include <boost/compute/algorithm/search.hpp>
 #include <boost/compute/algorithm/search_n.hpp>
+#include <boost/compute/algorithm/segmented_sort.hpp>
+#include <boost/compute/algorithm/segmented_sort_by_key.hpp>
 #include <boost/compute/algorithm/set_difference.hpp>
 #include <boost/compute/algorithm/set_intersection.hpp>
 #include <boost/compute/algorithm/set_symmetric_difference.hpp>
 #include <boost/compute/algorithm/set_union.hpp>
 #include <boost/compute/algorithm/sort.hpp>
 #include <boost/compute/algorithm/sort_by_key.hpp>
+#include <boost/compute/algorithm/sorted_indices.hpp>
 #include <boost/compute/algorithm/stable_partition.hpp>
 #include <boost/compute/algorithm/stable_sort.hpp>
+#include <boost/compute/algorithm/summation_policy.hpp>
 #include <boost/compute/algorithm/swap_ranges.hpp>
 #include <boost/compute/algorithm/transform.hpp>
 #include <boost/compute/algorithm/transform_reduce.hpp>
@@ -12,12 +12,16 @@
 #define BOOST_COMPUTE_ALGORITHM_ACCUMULATE_HPP
 
 #include <boost/preprocessor/seq/for_each.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/utility/enable_if.hpp>
 
 #include <boost/compute/system.hpp>
 #include <boost/compute/functional.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/summation_policy.hpp>
 #include <boost/compute/algorithm/detail/serial_accumulate.hpp>
+#include <boost/compute/algorithm/detail/summation.hpp>
 #include <boost/compute/container/array.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
@@ -96,18 +100,42 @@ inline bool can_accumulate_with_reduce(T init, max<T>)
 
 #undef BOOST_COMPUTE_DETAIL_DECLARE_CAN_ACCUMULATE_WITH_REDUCE
 
+// true if accumulate() is a floating-point sum which can be computed in
+// parallel with a summation policy
+template<class T, class F>
+struct can_accumulate_with_summation : boost::false_type {};
+
+template<>
+struct can_accumulate_with_summation<float_, plus<float_> > : boost::true_type {};
+
+template<>
+struct can_accumulate_with_summation<double_, plus<double_> > : boost::true_type {};
+
 template<class InputIterator, class T, class BinaryFunction>
 inline T dispatch_accumulate(InputIterator first,
                              InputIterator last,
                              T init,
                              BinaryFunction function,
-                             command_queue &queue)
+                             command_queue &queue,
+                             boost::true_type)
 {
-    size_t size = iterator_range_size(first, last);
-    if(size == 0){
-        return init;
-    }
+    (void) function;
 
+    // the fixed order keeps the result the same on every device, as the
+    // serial accumulate did
+    return summation_accumulate(
+        first, last, init, reproducible_summation(), queue
+    );
+}
+
+template<class InputIterator, class T, class BinaryFunction>
+inline T dispatch_accumulate(InputIterator first,
+                             InputIterator last,
+                             T init,
+                             BinaryFunction function,
+                             command_queue &queue,
+                             boost::false_type)
+{
     if(can_accumulate_with_reduce(init, function)){
         T result;
         reduce(first, last, &result, function, queue);
@@ -118,6 +146,24 @@ inline T dispatch_accumulate(InputIterator first,
     }
 }
 
+template<class InputIterator, class T, class BinaryFunction>
+inline T dispatch_accumulate(InputIterator first,
+                             InputIterator last,
+                             T init,
+                             BinaryFunction function,
+                             command_queue &queue)
+{
+    size_t size = iterator_range_size(first, last);
+    if(size == 0){
+        return init;
+    }
+
+    return dispatch_accumulate(
+        first, last, init, function, queue,
+        typename can_accumulate_with_summation<T, BinaryFunction>::type()
+    );
+}
+
 } // end detail namespace
 
 /// Returns the result of applying \p function to the elements in the
@@ -125,6 +171,9 @@ inline T dispatch_accumulate(InputIterator first,
 ///
 /// If no function is specified, \c plus will be used.
 ///
+/// Sums of \c float and \c double values are computed in parallel with
+/// the reproducible_summation policy.
+///
 /// \see reduce()
 template<class InputIterator, class T, class BinaryFunction>
 inline T accumulate(InputIterator first,
@@ -148,6 +197,45 @@ inline T accumulate(InputIterator first,
     return detail::dispatch_accumulate(first, last, init, plus<IT>(), queue);
 }
 
+/// Returns the sum of \p init and the floating-point values in the range
+/// [\p first, \p last) computed with the summation \p policy, which is
+/// one of fast_summation, compensated_summation or reproducible_summation.
+///
+/// For example, to sum a vector of floats with compensated summation:
+/// \code
+/// float sum = boost::compute::accumulate(
+///     vec.begin(), vec.end(), 0.0f, boost::compute::plus<float>(),
+///     boost::compute::compensated_summation(), queue
+/// );
+/// \endcode
+///
+/// This overload only takes part in overload resolution when \p T is
+/// \c float or \c double, as integer sums have no rounding error for the
+/// policies to control.
+///
+/// \see fast_summation, compensated_summation, reproducible_summation
+template<class InputIterator, class T, class SummationPolicy>
+inline typename boost::enable_if_c<
+    detail::is_summation_policy<SummationPolicy>::value &&
+        detail::can_accumulate_with_summation<T, plus<T> >::value,
+    T
+>::type
+accumulate(InputIterator first,
+           InputIterator last,
+           T init,
+           plus<T> function,
+           SummationPolicy policy,
+           command_queue &queue = system::default_queue())
+{
+    (void) function;
+
+    if(first == last){
+        return init;
+    }
+
+    return detail::summation_accumulate(first, last, init, policy, queue);
+}
+
 } // end compute namespace
 } // end boost namespace
 
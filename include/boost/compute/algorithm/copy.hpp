@@ -20,6 +20,7 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/async/future.hpp>
+#include <boost/compute/container/detail/scalar.hpp>
 #include <boost/compute/iterator/buffer_iterator.hpp>
 #include <boost/compute/detail/is_device_iterator.hpp>
 #include <boost/compute/detail/is_contiguous_iterator.hpp>
@@ -340,6 +341,37 @@ inline OutputIterator copy(InputIterator first,
     return detail::dispatch_copy(first, last, result, queue);
 }
 
+/// Copies the first \p count values of the range [\p first, \p last) to
+/// the range beginning at \p result, where \p count is stored on the
+/// device (e.g. the result size of copy_if()) and is at most the size of
+/// the range.
+///
+/// The count is not read back by the host. The copy is launched for the
+/// whole range and the work-items past \p count exit early, so algorithms
+/// can be chained on the device with a single host sync at the end:
+/// \code
+/// boost::compute::detail::scalar<uint_> count(context);
+/// boost::compute::copy_if(
+///     input.begin(), input.end(), tmp.begin(), _1 > 0, count, queue
+/// );
+/// boost::compute::copy(
+///     tmp.begin(), tmp.begin() + input.size(), count, output.begin(), queue
+/// );
+/// \endcode
+///
+/// Both ranges must be on the device.
+///
+/// \see copy_if()
+template<class InputIterator, class OutputIterator>
+inline void copy(InputIterator first,
+                 InputIterator last,
+                 const detail::scalar<uint_> &count,
+                 OutputIterator result,
+                 command_queue &queue = system::default_queue())
+{
+    detail::copy_on_device(first, last, count, result, queue);
+}
+
 /// Copies the values in the range [\p first, \p last) to the range
 /// beginning at \p result. The copy is performed asynchronously.
 ///
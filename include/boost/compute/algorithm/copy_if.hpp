@@ -11,13 +11,20 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_COPY_IF_HPP
 #define BOOST_COMPUTE_ALGORITHM_COPY_IF_HPP
 
+#include <boost/assert.hpp>
+
 #include <boost/compute/cl.hpp>
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/wait_list.hpp>
 #include <boost/compute/algorithm/count.hpp>
 #include <boost/compute/algorithm/count_if.hpp>
 #include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/async/detail/deferred_read.hpp>
+#include <boost/compute/async/detail/wait_list_barrier.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/detail/scalar.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/iterator/discard_iterator.hpp>
@@ -92,6 +99,78 @@ inline discard_iterator copy_if_impl(InputIterator first,
     return result + count_if(first, last, predicate, queue);
 }
 
+// writes 1 to indices[i] for each value in [first, first + count) for
+// which predicate returns true and 0 otherwise, then scans the indices.
+// indices has an extra trailing element which holds the number of true
+// values after the scan.
+template<class InputIterator, class Predicate>
+inline void scan_predicate_indices(InputIterator first,
+                                   size_t count,
+                                   Predicate predicate,
+                                   vector<uint_> &indices,
+                                   command_queue &queue)
+{
+    BOOST_ASSERT(indices.size() == count + 1);
+
+    ::boost::compute::detail::meta_kernel k("scan_predicate_write_flags");
+    k.add_set_arg<const uint_>("count", static_cast<uint_>(count));
+    k << "const uint i = get_global_id(0);\n"
+      << indices.begin()[k.var<uint_>("i")] << " = "
+      << "(i < count) ? ("
+      << predicate(first[k.var<uint_>("i")]) << " ? 1 : 0) : 0;\n";
+    k.exec_1d(queue, 0, count + 1);
+
+    ::boost::compute::exclusive_scan(indices.begin(),
+                                     indices.end(),
+                                     indices.begin(),
+                                     queue);
+}
+
+// copies the total stored after the scanned indices to result_count
+// on the device
+inline void copy_scanned_count(const vector<uint_> &indices,
+                               scalar<uint_> &result_count,
+                               command_queue &queue)
+{
+    queue.enqueue_copy_buffer(indices.get_buffer(),
+                              result_count.get_buffer(),
+                              (indices.size() - 1) * sizeof(uint_),
+                              0,
+                              sizeof(uint_));
+}
+
+// like copy_if() but stores the number of copied values in result_count
+// on the device instead of reading it back
+template<class InputIterator, class OutputIterator, class Predicate>
+inline void copy_if_with_count(InputIterator first,
+                               InputIterator last,
+                               OutputIterator result,
+                               Predicate predicate,
+                               scalar<uint_> &result_count,
+                               command_queue &queue)
+{
+    size_t count = detail::iterator_range_size(first, last);
+    if(count == 0){
+        result_count.write(0, queue);
+        return;
+    }
+
+    const context &context = queue.get_context();
+
+    // storage for destination indices
+    ::boost::compute::vector<uint_> indices(count + 1, context);
+    scan_predicate_indices(first, count, predicate, indices, queue);
+
+    // copy values
+    ::boost::compute::detail::meta_kernel k("copy_if_with_count_do_copy");
+    k << "if(" << predicate(first[k.get_global_id(0)]) << ")" <<
+         "    " << result[indices.begin()[k.get_global_id(0)]] << "=" <<
+         first[k.get_global_id(0)] << ";\n";
+    k.exec_1d(queue, 0, count);
+
+    copy_scanned_count(indices, result_count, queue);
+}
+
 // like the copy_if() algorithm but writes the indices of the values for which
 // predicate returns true.
 template<class InputIterator, class OutputIterator, class Predicate>
@@ -118,6 +197,66 @@ inline OutputIterator copy_if(InputIterator first,
     return detail::copy_if_impl(first, last, result, predicate, false, queue);
 }
 
+/// Copies each element in the range [\p first, \p last) for which
+/// \p predicate returns \c true to the range beginning at \p result and
+/// stores the number of copied elements in \p count on the device.
+///
+/// Unlike copy_if(), this function does not block the host to read the
+/// number of copied elements. The count can be passed to the algorithms
+/// which accept a device count, e.g. copy() and transform(), so that
+/// pipelines run on the device with a single host sync at the end.
+///
+/// \see copy_if()
+template<class InputIterator, class OutputIterator, class Predicate>
+inline void copy_if(InputIterator first,
+                    InputIterator last,
+                    OutputIterator result,
+                    Predicate predicate,
+                    detail::scalar<uint_> &count,
+                    command_queue &queue = system::default_queue())
+{
+    detail::copy_if_with_count(first, last, result, predicate, count, queue);
+}
+
+/// Asynchronously copies each element in the range [\p first, \p last) for
+/// which \p predicate returns \c true to the range beginning at \p result.
+/// The copy starts after the events in \p events have completed.
+///
+/// Unlike copy_if(), this function does not block the host to read the
+/// number of copied elements. The count is read back with a non-blocking
+/// read which completes the returned future.
+///
+/// \see copy_if()
+template<class InputIterator, class OutputIterator, class Predicate>
+inline future<OutputIterator>
+copy_if_async(InputIterator first,
+              InputIterator last,
+              OutputIterator result,
+              Predicate predicate,
+              command_queue &queue = system::default_queue(),
+              const wait_list &events = wait_list())
+{
+    size_t count = detail::iterator_range_size(first, last);
+
+    detail::enqueue_wait_list_barrier(queue, events);
+
+    if(count == 0){
+        return make_future(result, queue.enqueue_marker());
+    }
+
+    // the number of copied values is read without blocking the host
+    detail::scalar<uint_> copied_count(queue.get_context());
+    detail::copy_if_with_count(
+        first, last, result, predicate, copied_count, queue
+    );
+
+    detail::deferred_advance<OutputIterator, uint_> end(
+        result, copied_count.get_buffer(), 0, queue
+    );
+
+    return future<OutputIterator>(end.get_event(), end);
+}
+
 } // end compute namespace
 } // end boost namespace
 
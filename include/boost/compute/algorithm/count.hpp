@@ -11,18 +11,55 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_COUNT_HPP
 #define BOOST_COMPUTE_ALGORITHM_COUNT_HPP
 
+#include <algorithm>
+#include <iterator>
+
 #include <boost/compute/lambda.hpp>
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/host_dispatch.hpp>
 #include <boost/compute/algorithm/count_if.hpp>
 #include <boost/compute/type_traits/vector_size.hpp>
 
 namespace boost {
 namespace compute {
+namespace detail {
+
+template<class InputIterator, class T>
+inline size_t count_on_host(InputIterator first,
+                            InputIterator last,
+                            const T &value,
+                            command_queue &queue,
+                            boost::true_type)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    scoped_host_map<value_type> values(
+        first, iterator_range_size(first, last), CL_MAP_READ, queue
+    );
+
+    // value is not converted to value_type, the values are compared with
+    // the usual arithmetic conversions like in the kernel of count_if()
+    return static_cast<size_t>(std::count(values.begin(), values.end(), value));
+}
+
+template<class InputIterator, class T>
+inline size_t count_on_host(InputIterator,
+                            InputIterator,
+                            const T&,
+                            command_queue&,
+                            boost::false_type)
+{
+    return 0;
+}
+
+} // end detail namespace
 
 /// Returns the number of occurrences of \p value in the range
 /// [\p first, \p last).
 ///
+/// Small ranges are counted on the host (see host_dispatch).
+///
 /// \see count_if()
 template<class InputIterator, class T>
 inline size_t count(InputIterator first,
@@ -35,6 +72,13 @@ inline size_t count(InputIterator first,
     using ::boost::compute::_1;
     using ::boost::compute::lambda::all;
 
+    if(detail::dispatch_to_host(first, last, host_dispatch::count_algorithm, queue)){
+        return detail::count_on_host(
+            first, last, value, queue,
+            typename detail::is_host_dispatchable<InputIterator>::type()
+        );
+    }
+
     if(vector_size<value_type>::value == 1){
         return ::boost::compute::count_if(first,
                                           last,
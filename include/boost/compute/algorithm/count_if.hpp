@@ -14,6 +14,12 @@
 #include <boost/compute/device.hpp>
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/wait_list.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/async/detail/deferred_read.hpp>
+#include <boost/compute/async/detail/wait_list_barrier.hpp>
+#include <boost/compute/container/detail/scalar.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
 #include <boost/compute/algorithm/detail/count_if_with_ballot.hpp>
 #include <boost/compute/algorithm/detail/count_if_with_reduce.hpp>
 #include <boost/compute/algorithm/detail/count_if_with_threads.hpp>
@@ -56,6 +62,45 @@ inline size_t count_if(InputIterator first,
     }
 }
 
+/// Asynchronously counts the number of elements in the range
+/// [\p first, \p last) for which \p predicate returns \c true. The count
+/// starts after the events in \p events have completed.
+///
+/// This function does not wait for the count to complete. The count is read
+/// back with a non-blocking read which completes the returned future. The
+/// counting kernels are enqueued as by reduce() and may block the host
+/// while they are built.
+///
+/// \see count_if()
+template<class InputIterator, class Predicate>
+inline future<size_t>
+count_if_async(InputIterator first,
+               InputIterator last,
+               Predicate predicate,
+               command_queue &queue = system::default_queue(),
+               const wait_list &events = wait_list())
+{
+    detail::enqueue_wait_list_barrier(queue, events);
+
+    if(first == last){
+        return make_future(size_t(0), queue.enqueue_marker());
+    }
+
+    detail::scalar<ulong_> result(queue.get_context());
+    detail::countable_predicate<Predicate> reduce_predicate(predicate);
+    ::boost::compute::reduce(
+        ::boost::compute::make_transform_iterator(first, reduce_predicate),
+        ::boost::compute::make_transform_iterator(last, reduce_predicate),
+        make_buffer_iterator<ulong_>(result.get_buffer()),
+        ::boost::compute::plus<ulong_>(),
+        queue
+    );
+
+    detail::deferred_read<size_t, ulong_> read(result.get_buffer(), 0, queue);
+
+    return future<size_t>(read.get_event(), read);
+}
+
 } // end compute namespace
 } // end boost namespace
 
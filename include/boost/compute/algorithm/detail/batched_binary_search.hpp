@@ -0,0 +1,414 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_BATCHED_BINARY_SEARCH_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_BATCHED_BINARY_SEARCH_HPP
+
+#include <iterator>
+
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/system.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+/// What is written to the result for each query.
+enum batched_search_mode {
+    /// index of the first element not less than the query
+    batched_lower_bound,
+    /// index of the first element greater than the query
+    batched_upper_bound,
+    /// index of an element equal to the query or the size of the range
+    batched_find,
+    /// 1 if an element equal to the query exists, 0 otherwise
+    batched_contains
+};
+
+/// Number of evenly spaced elements of the searched range cached in local
+/// memory by each work-group of the batched binary search kernel.
+const size_t batched_search_samples = 256;
+
+/// Ranges shorter than this are searched without the local memory cache.
+const size_t batched_search_cache_threshold = 16 * batched_search_samples;
+
+/// Number of consecutive sorted queries searched by each work-item of the
+/// batched sorted search kernel.
+const size_t batched_sorted_search_block = 32;
+
+///
+/// \brief Batched binary search kernel class
+///
+/// Subclass of meta_kernel which performs an independent binary search in
+/// a sorted range for each value in a range of queries. Each work-item
+/// searches for one query so a single kernel launch answers every query.
+///
+/// For large ranges each work-group first caches evenly spaced samples of
+/// the range (the top levels of the search tree) in local memory. Each
+/// query is narrowed down with a search of the samples and only the last
+/// levels of the search read global memory.
+///
+class batched_binary_search_kernel : public meta_kernel
+{
+public:
+    batched_binary_search_kernel() : meta_kernel("batched_binary_search")
+    {
+    }
+
+    template<class InputIterator, class QueryIterator, class OutputIterator>
+    void set_range(InputIterator first,
+                   InputIterator last,
+                   QueryIterator queries_first,
+                   QueryIterator queries_last,
+                   OutputIterator result,
+                   batched_search_mode mode)
+    {
+        typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+        typedef typename std::iterator_traits<QueryIterator>::value_type query_type;
+
+        m_count = iterator_range_size(first, last);
+        m_count_arg = add_arg<const uint_>("count");
+        m_queries = iterator_range_size(queries_first, queries_last);
+        m_queries_arg = add_arg<const uint_>("queries");
+        m_cached = m_count >= batched_search_cache_threshold;
+        m_value_size = sizeof(value_type);
+
+        if(m_cached){
+            m_samples_arg =
+                add_arg<value_type *>(memory_object::local_memory, "samples");
+
+            *this <<
+                "for(uint j = get_local_id(0); j < " << uint_(batched_search_samples) << "; j += get_local_size(0)){\n" <<
+                "    const uint p = (uint)(((ulong) j * count) / " << uint_(batched_search_samples) << ");\n" <<
+                "    samples[j] = " << first[expr<uint_>("p")] << ";\n" <<
+                "}\n" <<
+                "barrier(CLK_LOCAL_MEM_FENCE);\n";
+        }
+
+        *this <<
+            "const uint q = get_global_id(0);\n" <<
+            "if(q >= queries){\n" <<
+            "    return;\n" <<
+            "}\n" <<
+            decl<query_type>("query") << " = " <<
+                queries_first[expr<uint_>("q")] << ";\n" <<
+            "uint lo = 0;\n" <<
+            "uint hi = count;\n";
+
+        if(m_cached){
+            // the answer lies after the last sample before it and at or
+            // before the first sample after it
+            *this <<
+                "uint s_lo = 0;\n" <<
+                "uint s_hi = " << uint_(batched_search_samples) << ";\n" <<
+                "while(s_lo < s_hi){\n" <<
+                "    const uint mid = s_lo + (s_hi - s_lo) / 2;\n";
+            emit_predicate(mode, "samples[mid]");
+            *this <<
+                "        s_lo = mid + 1;\n" <<
+                "    }\n" <<
+                "    else {\n" <<
+                "        s_hi = mid;\n" <<
+                "    }\n" <<
+                "}\n" <<
+                "if(s_lo > 0){\n" <<
+                "    lo = (uint)(((ulong)(s_lo - 1) * count) / " << uint_(batched_search_samples) << ") + 1;\n" <<
+                "}\n" <<
+                "if(s_lo < " << uint_(batched_search_samples) << "){\n" <<
+                "    hi = (uint)(((ulong) s_lo * count) / " << uint_(batched_search_samples) << ");\n" <<
+                "}\n";
+        }
+
+        *this <<
+            "while(lo < hi){\n" <<
+            "    const uint mid = lo + (hi - lo) / 2;\n";
+        emit_predicate(mode, first[expr<uint_>("mid")]);
+        *this <<
+            "        lo = mid + 1;\n" <<
+            "    }\n" <<
+            "    else {\n" <<
+            "        hi = mid;\n" <<
+            "    }\n" <<
+            "}\n";
+
+        emit_result(first, result, mode);
+    }
+
+    event exec(command_queue &queue)
+    {
+        if(m_queries == 0){
+            return event();
+        }
+
+        set_arg(m_count_arg, static_cast<uint_>(m_count));
+        set_arg(m_queries_arg, static_cast<uint_>(m_queries));
+
+        if(!m_cached){
+            return exec_1d(queue, 0, m_queries);
+        }
+
+        const size_t local_size = 128;
+        const size_t global_size =
+            ((m_queries + local_size - 1) / local_size) * local_size;
+
+        ::boost::compute::kernel kernel = compile(queue.get_context());
+        kernel.set_arg(
+            m_samples_arg, batched_search_samples * m_value_size, 0
+        );
+
+        return queue.enqueue_1d_range_kernel(
+            kernel, 0, global_size, local_size
+        );
+    }
+
+private:
+    // emits the opening of an if statement which is true if the answer for
+    // the query is after the element given by value
+    template<class Expr>
+    void emit_predicate(batched_search_mode mode, const Expr &value)
+    {
+        if(mode == batched_upper_bound){
+            *this << "    if(!(query < " << value << ")){\n";
+        }
+        else {
+            *this << "    if(" << value << " < query){\n";
+        }
+    }
+
+    template<class InputIterator, class OutputIterator>
+    void emit_result(InputIterator first,
+                     OutputIterator result,
+                     batched_search_mode mode)
+    {
+        if(mode == batched_find){
+            *this <<
+                result[expr<uint_>("q")] << " = (lo < count && " <<
+                    first[expr<uint_>("lo")] << " == query) ? lo : count;\n";
+        }
+        else if(mode == batched_contains){
+            *this <<
+                result[expr<uint_>("q")] << " = (lo < count && " <<
+                    first[expr<uint_>("lo")] << " == query) ? 1 : 0;\n";
+        }
+        else {
+            *this <<
+                result[expr<uint_>("q")] << " = lo;\n";
+        }
+    }
+
+private:
+    size_t m_count;
+    size_t m_count_arg;
+    size_t m_queries;
+    size_t m_queries_arg;
+    size_t m_samples_arg;
+    size_t m_value_size;
+    bool m_cached;
+};
+
+///
+/// \brief Batched sorted search kernel class
+///
+/// Subclass of meta_kernel which searches a sorted range for each value in
+/// a sorted range of queries. As the answers are non-decreasing each
+/// work-item searches a block of consecutive queries and, like a merge,
+/// starts the search for each query from the answer to the previous one.
+/// The next answer is found with an exponential (galloping) search so the
+/// cost of each query grows with the logarithm of the distance between
+/// consecutive answers rather than of the size of the range.
+///
+class batched_sorted_search_kernel : public meta_kernel
+{
+public:
+    batched_sorted_search_kernel() : meta_kernel("batched_sorted_search")
+    {
+    }
+
+    template<class InputIterator, class QueryIterator, class OutputIterator>
+    void set_range(InputIterator first,
+                   InputIterator last,
+                   QueryIterator queries_first,
+                   QueryIterator queries_last,
+                   OutputIterator result,
+                   batched_search_mode mode)
+    {
+        typedef typename std::iterator_traits<QueryIterator>::value_type query_type;
+
+        m_count = iterator_range_size(first, last);
+        m_count_arg = add_arg<const uint_>("count");
+        m_queries = iterator_range_size(queries_first, queries_last);
+        m_queries_arg = add_arg<const uint_>("queries");
+
+        *this <<
+            "const uint start = get_global_id(0) * " << uint_(batched_sorted_search_block) << ";\n" <<
+            "const uint end = min(start + " << uint_(batched_sorted_search_block) << ", queries);\n" <<
+            "uint lo = 0;\n" <<
+            "for(uint q = start; q < end; q++){\n" <<
+            "    " << decl<query_type>("query") << " = " <<
+                         queries_first[expr<uint_>("q")] << ";\n" <<
+            // gallop forward from the previous answer
+            "    uint hi = lo;\n" <<
+            "    uint step = 1;\n" <<
+            "    while(hi < count){\n";
+        emit_predicate(mode, first[expr<uint_>("hi")]);
+        *this <<
+            "            lo = hi + 1;\n" <<
+            "            hi += step;\n" <<
+            "            step <<= 1;\n" <<
+            "        }\n" <<
+            "        else {\n" <<
+            "            break;\n" <<
+            "        }\n" <<
+            "    }\n" <<
+            "    hi = min(hi, count);\n" <<
+            // binary search between the last two probes
+            "    while(lo < hi){\n" <<
+            "        const uint mid = lo + (hi - lo) / 2;\n";
+        emit_predicate(mode, first[expr<uint_>("mid")]);
+        *this <<
+            "            lo = mid + 1;\n" <<
+            "        }\n" <<
+            "        else {\n" <<
+            "            hi = mid;\n" <<
+            "        }\n" <<
+            "    }\n";
+
+        if(mode == batched_find){
+            *this <<
+            "    " << result[expr<uint_>("q")] << " = (lo < count && " <<
+                         first[expr<uint_>("lo")] << " == query) ? lo : count;\n";
+        }
+        else if(mode == batched_contains){
+            *this <<
+            "    " << result[expr<uint_>("q")] << " = (lo < count && " <<
+                         first[expr<uint_>("lo")] << " == query) ? 1 : 0;\n";
+        }
+        else {
+            *this <<
+            "    " << result[expr<uint_>("q")] << " = lo;\n";
+        }
+
+        *this <<
+            "}\n";
+    }
+
+    event exec(command_queue &queue)
+    {
+        if(m_queries == 0){
+            return event();
+        }
+
+        set_arg(m_count_arg, static_cast<uint_>(m_count));
+        set_arg(m_queries_arg, static_cast<uint_>(m_queries));
+
+        const size_t blocks =
+            (m_queries + batched_sorted_search_block - 1) / batched_sorted_search_block;
+
+        return exec_1d(queue, 0, blocks);
+    }
+
+private:
+    template<class Expr>
+    void emit_predicate(batched_search_mode mode, const Expr &value)
+    {
+        if(mode == batched_upper_bound){
+            *this << "        if(!(query < " << value << ")){\n";
+        }
+        else {
+            *this << "        if(" << value << " < query){\n";
+        }
+    }
+
+private:
+    size_t m_count;
+    size_t m_count_arg;
+    size_t m_queries;
+    size_t m_queries_arg;
+};
+
+///
+/// \brief Batched binary search algorithm
+///
+/// Searches the sorted range [\p first, \p last) for each value in
+/// [\p queries_first, \p queries_last) and writes an unsigned integer
+/// per query (see batched_search_mode) to \p result.
+///
+template<class InputIterator, class QueryIterator, class OutputIterator>
+inline event batched_binary_search(InputIterator first,
+                                   InputIterator last,
+                                   QueryIterator queries_first,
+                                   QueryIterator queries_last,
+                                   OutputIterator result,
+                                   batched_search_mode mode,
+                                   command_queue &queue = system::default_queue())
+{
+    batched_binary_search_kernel kernel;
+    kernel.set_range(first, last, queries_first, queries_last, result, mode);
+
+    return kernel.exec(queue);
+}
+
+///
+/// \brief Batched sorted search algorithm
+///
+/// Same as batched_binary_search() but the queries must be sorted, which
+/// allows consecutive queries to share the work of the search.
+///
+template<class InputIterator, class QueryIterator, class OutputIterator>
+inline event batched_sorted_search(InputIterator first,
+                                   InputIterator last,
+                                   QueryIterator queries_first,
+                                   QueryIterator queries_last,
+                                   OutputIterator result,
+                                   batched_search_mode mode,
+                                   command_queue &queue = system::default_queue())
+{
+    batched_sorted_search_kernel kernel;
+    kernel.set_range(first, last, queries_first, queries_last, result, mode);
+
+    return kernel.exec(queue);
+}
+
+///
+/// Searches with batched_sorted_search() if the caller has declared the
+/// queries sorted and there are enough of them for it to pay off, and with
+/// batched_binary_search() otherwise.
+///
+template<class InputIterator, class QueryIterator, class OutputIterator>
+inline event dispatch_batched_search(InputIterator first,
+                                     InputIterator last,
+                                     QueryIterator queries_first,
+                                     QueryIterator queries_last,
+                                     OutputIterator result,
+                                     batched_search_mode mode,
+                                     bool queries_sorted,
+                                     command_queue &queue)
+{
+    const size_t queries = iterator_range_size(queries_first, queries_last);
+
+    if(queries_sorted && queries >= 4 * batched_sorted_search_block){
+        return batched_sorted_search(
+            first, last, queries_first, queries_last, result, mode, queue
+        );
+    }
+
+    return batched_binary_search(
+        first, last, queries_first, queries_last, result, mode, queue
+    );
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_BATCHED_BINARY_SEARCH_HPP
@@ -0,0 +1,110 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_COPY_BY_MAPPING_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_COPY_BY_MAPPING_HPP
+
+#include <algorithm>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/device.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/detail/iterator_plus_distance.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// returns true if device accesses the host's memory directly (i.e. it is a
+// cpu or an integrated gpu)
+inline bool is_host_unified_device(const device &device)
+{
+    if(device.type() & device::cpu){
+        return true;
+    }
+
+    #ifdef CL_VERSION_1_1
+    if(device.check_version(1, 1)){
+        return device.get_info<CL_DEVICE_HOST_UNIFIED_MEMORY>();
+    }
+    #endif
+
+    return false;
+}
+
+// memory flags of the buffers which zero_copy_allocator allocates on devices
+// which share the host's memory. no access flag is given (the buffers are
+// read-write by default) which sets them apart from host memory buffers
+// created elsewhere, e.g. by pinned_allocator
+const cl_mem_flags zero_copy_mem_flags = CL_MEM_ALLOC_HOST_PTR;
+
+// returns true if copies to and from buffer are faster by mapping it than
+// with a read or write command. this is only assumed for buffers allocated
+// by zero_copy_allocator, which checks the device once when it is created,
+// where mapping returns a pointer to the buffer's own storage rather than a
+// staging copy of it. other buffers keep using read and write commands
+inline bool can_copy_by_mapping(const buffer &buffer)
+{
+    return buffer.get_memory_flags() == zero_copy_mem_flags;
+}
+
+// copies count values from the host to buffer at offset by mapping it
+template<class T, class HostIterator>
+inline void copy_to_device_by_mapping(HostIterator first,
+                                      size_t count,
+                                      const buffer &buffer,
+                                      size_t offset,
+                                      command_queue &queue)
+{
+    cl_map_flags flags = CL_MAP_WRITE;
+    #ifdef CL_VERSION_1_2
+    if(queue.check_device_version(1, 2)){
+        // the previous contents are overwritten and need not be made
+        // visible to the host
+        flags = CL_MAP_WRITE_INVALIDATE_REGION;
+    }
+    #endif
+
+    T *pointer = static_cast<T *>(
+        queue.enqueue_map_buffer(
+            buffer, flags, offset * sizeof(T), count * sizeof(T)
+        )
+    );
+    std::copy(first, iterator_plus_distance(first, count), pointer);
+
+    // wait for the unmap so that, like a blocking write, the values are
+    // visible to commands in other queues when the copy returns
+    queue.enqueue_unmap_buffer(buffer, pointer).wait();
+}
+
+// copies count values from buffer at offset to the host by mapping it
+template<class T, class HostIterator>
+inline HostIterator copy_to_host_by_mapping(const buffer &buffer,
+                                            size_t offset,
+                                            size_t count,
+                                            HostIterator result,
+                                            command_queue &queue)
+{
+    T *pointer = static_cast<T *>(
+        queue.enqueue_map_buffer(
+            buffer, CL_MAP_READ, offset * sizeof(T), count * sizeof(T)
+        )
+    );
+    result = std::copy(pointer, pointer + count, result);
+    queue.enqueue_unmap_buffer(buffer, pointer);
+
+    return result;
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_COPY_BY_MAPPING_HPP
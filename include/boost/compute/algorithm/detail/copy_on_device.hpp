@@ -18,76 +18,45 @@
 #include <boost/compute/iterator/buffer_iterator.hpp>
 #include <boost/compute/iterator/discard_iterator.hpp>
 #include <boost/compute/memory/svm_ptr.hpp>
-#include <boost/compute/detail/meta_kernel.hpp>
-#include <boost/compute/detail/work_size.hpp>
+#include <boost/compute/container/detail/scalar.hpp>
+#include <boost/compute/detail/elementwise_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
 namespace compute {
 namespace detail {
 
-inline size_t pick_copy_work_group_size(size_t n, const device &device)
-{
-    (void) device;
-
-    if(n % 32 == 0) return 32;
-    else if(n % 16 == 0) return 16;
-    else if(n % 8 == 0) return 8;
-    else if(n % 4 == 0) return 4;
-    else if(n % 2 == 0) return 2;
-    else return 1;
-}
-
 template<class InputIterator, class OutputIterator>
-class copy_kernel : public meta_kernel
+class copy_kernel : public elementwise_kernel
 {
 public:
-    copy_kernel()
-        : meta_kernel("copy")
+    explicit copy_kernel(const device &device)
+        : elementwise_kernel("copy", device)
     {
         m_count = 0;
-        m_vpt = 4;
-        m_tpb = 128;
     }
 
     void set_range(InputIterator first,
                    InputIterator last,
                    OutputIterator result)
     {
-        m_count_arg = add_arg<uint_>("count");
-
+        begin_loop();
         *this <<
-            "uint index = get_local_id(0) + " <<
-               "(" << m_vpt * m_tpb << " * get_group_id(0));\n" <<
-            "for(uint i = 0; i < " << m_vpt << "; i++){\n" <<
-            "    if(index < count){\n" <<
-                     result[expr<uint_>("index")] << '=' <<
-                         first[expr<uint_>("index")] << ";\n" <<
-            "        index += " << m_tpb << ";\n"
-            "    }\n"
-            "}\n";
+            make_store_expr(
+                result, expr<uint_>("index"), first[expr<uint_>("index")]
+            ) << ";\n";
+        end_loop();
 
         m_count = detail::iterator_range_size(first, last);
     }
 
     event exec(command_queue &queue)
     {
-        if(m_count == 0){
-            // nothing to do
-            return event();
-        }
-
-        size_t global_work_size = calculate_work_size(m_count, m_vpt, m_tpb);
-
-        set_arg(m_count_arg, uint_(m_count));
-
-        return exec_1d(queue, 0, global_work_size, m_tpb);
+        return elementwise_kernel::exec(queue, m_count);
     }
 
 private:
     size_t m_count;
-    size_t m_count_arg;
-    uint_ m_vpt;
-    uint_ m_tpb;
 };
 
 template<class InputIterator, class OutputIterator>
@@ -96,7 +65,7 @@ inline OutputIterator copy_on_device(InputIterator first,
                                      OutputIterator result,
                                      command_queue &queue)
 {
-    copy_kernel<InputIterator, OutputIterator> kernel;
+    copy_kernel<InputIterator, OutputIterator> kernel(queue.get_device());
 
     kernel.set_range(first, last, result);
     kernel.exec(queue);
@@ -104,6 +73,24 @@ inline OutputIterator copy_on_device(InputIterator first,
     return result + std::distance(first, last);
 }
 
+// copies the first count values of [first, last) where count is stored
+// on the device. the kernel is launched for the whole range and exits
+// early past count.
+template<class InputIterator, class OutputIterator>
+inline event copy_on_device(InputIterator first,
+                            InputIterator last,
+                            const scalar<uint_> &count,
+                            OutputIterator result,
+                            command_queue &queue)
+{
+    copy_kernel<InputIterator, OutputIterator> kernel(queue.get_device());
+
+    kernel.set_device_count(count.get_buffer());
+    kernel.set_range(first, last, result);
+
+    return kernel.exec(queue);
+}
+
 template<class InputIterator>
 inline discard_iterator copy_on_device(InputIterator first,
                                        InputIterator last,
@@ -121,7 +108,7 @@ inline future<OutputIterator> copy_on_device_async(InputIterator first,
                                                    OutputIterator result,
                                                    command_queue &queue)
 {
-    copy_kernel<InputIterator, OutputIterator> kernel;
+    copy_kernel<InputIterator, OutputIterator> kernel(queue.get_device());
 
     kernel.set_range(first, last, result);
     event event_ = kernel.exec(queue);
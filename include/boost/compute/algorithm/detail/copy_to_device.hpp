@@ -19,6 +19,7 @@
 #include <boost/compute/async/future.hpp>
 #include <boost/compute/iterator/buffer_iterator.hpp>
 #include <boost/compute/memory/svm_ptr.hpp>
+#include <boost/compute/algorithm/detail/copy_by_mapping.hpp>
 
 namespace boost {
 namespace compute {
@@ -44,6 +45,14 @@ inline DeviceIterator copy_to_device(HostIterator first,
 
     size_t offset = result.get_index();
 
+    if(can_copy_by_mapping(result.get_buffer())){
+        copy_to_device_by_mapping<value_type>(
+            first, count, result.get_buffer(), offset, queue
+        );
+
+        return result + static_cast<difference_type>(count);
+    }
+
     queue.enqueue_write_buffer(result.get_buffer(),
                                offset * sizeof(value_type),
                                count * sizeof(value_type),
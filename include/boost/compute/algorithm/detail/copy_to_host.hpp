@@ -20,6 +20,7 @@
 #include <boost/compute/iterator/buffer_iterator.hpp>
 #include <boost/compute/memory/svm_ptr.hpp>
 #include <boost/compute/detail/iterator_plus_distance.hpp>
+#include <boost/compute/algorithm/detail/copy_by_mapping.hpp>
 
 namespace boost {
 namespace compute {
@@ -43,6 +44,12 @@ inline HostIterator copy_to_host(DeviceIterator first,
     const buffer &buffer = first.get_buffer();
     size_t offset = first.get_index();
 
+    if(can_copy_by_mapping(buffer)){
+        return copy_to_host_by_mapping<value_type>(
+            buffer, offset, count, result, queue
+        );
+    }
+
     queue.enqueue_read_buffer(buffer,
                               offset * sizeof(value_type),
                               count * sizeof(value_type),
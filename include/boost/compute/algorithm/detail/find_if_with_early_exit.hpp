@@ -0,0 +1,120 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_FIND_IF_WITH_EARLY_EXIT_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_FIND_IF_WITH_EARLY_EXIT_HPP
+
+#include <iterator>
+#include <algorithm>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/device.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/functional.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/container/detail/scalar.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// searches the range in windows of increasing size, starting small so that
+// a match near the beginning is found after touching little of the range.
+// each window is searched by a fixed number of persistent work-items which
+// process chunks of the window in increasing order and stop as soon as the
+// index found so far is before their next chunk. all windows are enqueued
+// at once, the windows after a match exit immediately and only the final
+// index is read back.
+//
+// on gpus each work-item checks the index before every element while on
+// cpus each thread searches contiguous chunks and checks the index per
+// chunk.
+template<class InputIterator, class UnaryPredicate>
+inline InputIterator find_if_with_early_exit(InputIterator first,
+                                             InputIterator last,
+                                             UnaryPredicate predicate,
+                                             command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    typedef typename std::iterator_traits<InputIterator>::difference_type difference_type;
+
+    size_t count = detail::iterator_range_size(first, last);
+    if(count == 0){
+        return last;
+    }
+
+    const context &context = queue.get_context();
+    const device &device = queue.get_device();
+    const bool is_cpu = (device.type() & device::cpu) != 0;
+
+    const size_t chunk = is_cpu ? 4096 : 1;
+    const size_t threads = is_cpu ?
+        device.compute_units() : device.compute_units() * size_t(2048);
+    const size_t max_window = (std::max)(size_t(1) << 24, threads * chunk);
+
+    detail::meta_kernel k("find_if_with_early_exit");
+    size_t index_arg = k.add_arg<uint_ *>(memory_object::global_memory, "index");
+    size_t begin_arg = k.add_arg<const uint_>("window_begin");
+    size_t end_arg = k.add_arg<const uint_>("window_end");
+    atomic_min<uint_> atomic_min_uint;
+
+    k << "const uint stride = get_global_size(0) * " << uint_(chunk) << ";\n"
+      << "for(uint begin = window_begin + get_global_id(0) * " << uint_(chunk) << ";\n"
+      << "    begin < window_end;\n"
+      << "    begin += stride){\n"
+      << "    if(*((volatile __global uint *) index) < begin){\n"
+      << "        break;\n"
+      << "    }\n"
+      << "    const uint end = min(begin + " << uint_(chunk) << ", window_end);\n"
+      << "    for(uint i = begin; i < end; i++){\n"
+      << "        " << k.decl<const value_type>("value") << " = "
+      <<              first[k.var<const uint_>("i")] << ";\n"
+      << "        if(" << predicate(k.var<const value_type>("value")) << "){\n"
+      << "            " << atomic_min_uint(k.var<uint_ *>("index"), k.var<uint_>("i")) << ";\n"
+      << "            break;\n"
+      << "        }\n"
+      << "    }\n"
+      << "}\n";
+
+    kernel kernel = k.compile(context);
+
+    scalar<uint_> index(context);
+    kernel.set_arg(index_arg, index.get_buffer());
+
+    // initialize index to the last iterator's index
+    index.write(static_cast<uint_>(count), queue);
+
+    size_t begin = 0;
+    size_t window = (std::min)(threads * chunk * 4, max_window);
+    while(begin < count){
+        const size_t end = (std::min)(begin + window, count);
+
+        kernel.set_arg(begin_arg, static_cast<uint_>(begin));
+        kernel.set_arg(end_arg, static_cast<uint_>(end));
+
+        const size_t work_items =
+            (std::min)(threads, (end - begin + chunk - 1) / chunk);
+        queue.enqueue_1d_range_kernel(kernel, 0, work_items, 0);
+
+        begin = end;
+        window = (std::min)(window * 2, max_window);
+    }
+
+    // read index and return iterator
+    return first + static_cast<difference_type>(index.read(queue));
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_FIND_IF_WITH_EARLY_EXIT_HPP
@@ -0,0 +1,351 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_HISTOGRAM_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_HISTOGRAM_HPP
+
+#include <cmath>
+#include <iterator>
+#include <algorithm>
+
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/device.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/group_by_aggregate.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// the binners below emit code which computes the bin (of type uint) for
+// the variable "value". bins greater than or equal to the number of bins
+// are ignored.
+
+// uses the value itself as the bin
+class histogram_key_binner
+{
+public:
+    template<class T>
+    void emit(meta_kernel &k) const
+    {
+        k << "bin = (uint) value;\n";
+    }
+};
+
+// uses the result of a user-defined function as the bin
+template<class Function>
+class histogram_function_binner
+{
+public:
+    explicit histogram_function_binner(Function function)
+        : m_function(function)
+    {
+    }
+
+    template<class T>
+    void emit(meta_kernel &k) const
+    {
+        k << "bin = (uint) " << m_function(k.var<T>("value")) << ";\n";
+    }
+
+private:
+    Function m_function;
+};
+
+// splits [lower, upper) into bins of equal width
+class histogram_even_binner
+{
+public:
+    histogram_even_binner(float lower, float upper, uint_ bins)
+        : m_lower(lower),
+          m_upper(upper),
+          m_scale(bins / (upper - lower))
+    {
+    }
+
+    template<class T>
+    void emit(meta_kernel &k) const
+    {
+        k.add_set_arg<const float>("lower", m_lower);
+        k.add_set_arg<const float>("upper", m_upper);
+        k.add_set_arg<const float>("scale", m_scale);
+
+        k << "{\n"
+          << "    const float x = (float) value;\n"
+          << "    bin = (x >= lower && x < upper) ?\n"
+          << "              min((uint)((x - lower) * scale), num_bins - 1) : num_bins;\n"
+          << "}\n";
+    }
+
+private:
+    float m_lower;
+    float m_upper;
+    float m_scale;
+};
+
+// finds the bin with a binary search of num_bins + 1 sorted bin edges
+template<class EdgeIterator>
+class histogram_range_binner
+{
+public:
+    explicit histogram_range_binner(EdgeIterator edges)
+        : m_edges(edges)
+    {
+    }
+
+    template<class T>
+    void emit(meta_kernel &k) const
+    {
+        k << "{\n"
+          << "    uint lo = 0;\n"
+          << "    uint hi = num_bins + 1;\n"
+          << "    while(lo < hi){\n"
+          << "        const uint mid = (lo + hi) / 2;\n"
+          << "        if(" << m_edges[k.var<uint_>("mid")] << " <= value){\n"
+          << "            lo = mid + 1;\n"
+          << "        }\n"
+          << "        else {\n"
+          << "            hi = mid;\n"
+          << "        }\n"
+          << "    }\n"
+          // lo is zero (and bin wraps around) for values below the first
+          // edge and num_bins + 1 for values at or after the last edge
+          << "    bin = lo - 1;\n"
+          << "}\n";
+    }
+
+private:
+    EdgeIterator m_edges;
+};
+
+// adds the weight of each value to its bin in a sub-histogram in local
+// memory for each work-group. the sub-histograms are then added to the
+// result with global atomics. if the bins do not fit in local memory each
+// value is added to the result directly.
+template<class InputIterator,
+         class WeightIterator,
+         class BinIterator,
+         class Binner>
+inline void histogram_with_local_memory(InputIterator first,
+                                        size_t count,
+                                        WeightIterator weights,
+                                        BinIterator result,
+                                        size_t num_bins,
+                                        const Binner &binner,
+                                        command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+    typedef typename std::iterator_traits<BinIterator>::value_type R;
+    typedef group_by_aggregate_op<plus<R> > add_op;
+
+    const device &device = queue.get_device();
+    const size_t local_size = 128;
+    const bool privatize =
+        num_bins * sizeof(R) <= static_cast<size_t>(device.local_memory_size() / 2);
+
+    ::boost::compute::fill(result, result + num_bins, R(0), queue);
+
+    meta_kernel k("histogram");
+    k.add_function(
+        "histogram_add_global",
+        make_group_by_update_function<R, add_op>("histogram_add_global", "__global")
+    );
+    k.add_set_arg<const uint_>("count", static_cast<uint_>(count));
+    k.add_set_arg<const uint_>("num_bins", static_cast<uint_>(num_bins));
+    k.add_set_arg<const uint_>("offset", static_cast<uint_>(result.get_index()));
+    const size_t bins_arg = k.add_arg<R *>(memory_object::global_memory, "bins");
+    const size_t local_bins_arg = privatize ?
+        k.add_arg<R *>(memory_object::local_memory, "local_bins") : 0;
+
+    if(privatize){
+        k.add_function(
+            "histogram_add_local",
+            make_group_by_update_function<R, add_op>("histogram_add_local", "__local")
+        );
+        k << "for(uint b = get_local_id(0); b < num_bins; b += get_local_size(0)){\n"
+          << "    local_bins[b] = 0;\n"
+          << "}\n"
+          << "barrier(CLK_LOCAL_MEM_FENCE);\n";
+    }
+
+    k << "for(uint i = get_global_id(0); i < count; i += get_global_size(0)){\n"
+      << "    " << k.decl<T>("value") << " = " << first[k.var<uint_>("i")] << ";\n"
+      << "    uint bin;\n";
+    binner.template emit<T>(k);
+    k << "    if(bin < num_bins){\n";
+    if(privatize){
+        k << "        histogram_add_local(&local_bins[bin], "
+          <<              weights[k.var<uint_>("i")] << ");\n";
+    }
+    else {
+        k << "        histogram_add_global(&bins[offset + bin], "
+          <<              weights[k.var<uint_>("i")] << ");\n";
+    }
+    k << "    }\n"
+      << "}\n";
+
+    if(privatize){
+        k << "barrier(CLK_LOCAL_MEM_FENCE);\n"
+          << "for(uint b = get_local_id(0); b < num_bins; b += get_local_size(0)){\n"
+          << "    if(local_bins[b] != 0){\n"
+          << "        histogram_add_global(&bins[offset + b], local_bins[b]);\n"
+          << "    }\n"
+          << "}\n";
+    }
+
+    k.set_arg(bins_arg, result.get_buffer());
+
+    ::boost::compute::kernel kernel = k.compile(queue.get_context());
+    if(privatize){
+        kernel.set_arg(local_bins_arg, num_bins * sizeof(R), 0);
+    }
+
+    // enough work-groups to fill the device, each processing many values
+    // so that the cost of merging its sub-histogram is amortized
+    const size_t block_count = (std::min)(
+        static_cast<size_t>(device.compute_units()) * 8,
+        (count + local_size - 1) / local_size
+    );
+    queue.enqueue_1d_range_kernel(
+        kernel, 0, block_count * local_size, local_size
+    );
+}
+
+// computes a private histogram for each thread over a contiguous block of
+// the input and then adds the private histograms together. this avoids
+// atomics entirely and is optimized for cpu-type devices with a small
+// number of compute units.
+template<class InputIterator,
+         class WeightIterator,
+         class BinIterator,
+         class Binner>
+inline void histogram_with_threads(InputIterator first,
+                                   size_t count,
+                                   WeightIterator weights,
+                                   BinIterator result,
+                                   size_t num_bins,
+                                   const Binner &binner,
+                                   command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+    typedef typename std::iterator_traits<BinIterator>::value_type R;
+
+    const device &device = queue.get_device();
+    const context &context = queue.get_context();
+
+    size_t threads = device.compute_units();
+
+    const size_t minimum_block_size = 2048;
+    if(count / threads < minimum_block_size){
+        threads = static_cast<size_t>(
+                      (std::max)(
+                          std::ceil(float(count) / minimum_block_size),
+                          1.0f
+                      )
+                  );
+    }
+
+    vector<R> partial(threads * num_bins, context);
+    ::boost::compute::fill(partial.begin(), partial.end(), R(0), queue);
+
+    meta_kernel k("histogram_with_threads");
+    k.add_set_arg<const uint_>("count", static_cast<uint_>(count));
+    k.add_set_arg<const uint_>("num_bins", static_cast<uint_>(num_bins));
+    const size_t partial_arg =
+        k.add_arg<R *>(memory_object::global_memory, "partial");
+
+    k << "const uint gid = get_global_id(0);\n"
+      << "const uint block_size = count / get_global_size(0);\n"
+      << "const uint start = block_size * gid;\n"
+      << "const uint end = gid == get_global_size(0) - 1 ? count : start + block_size;\n"
+      << "__global " << type_name<R>() << " *private_bins = partial + gid * num_bins;\n"
+      << "for(uint i = start; i < end; i++){\n"
+      << "    " << k.decl<T>("value") << " = " << first[k.var<uint_>("i")] << ";\n"
+      << "    uint bin;\n";
+    binner.template emit<T>(k);
+    k << "    if(bin < num_bins){\n"
+      << "        private_bins[bin] += " << weights[k.var<uint_>("i")] << ";\n"
+      << "    }\n"
+      << "}\n";
+
+    k.set_arg(partial_arg, partial.get_buffer());
+    k.exec_1d(queue, 0, threads, 1);
+
+    meta_kernel merge("histogram_merge_threads");
+    merge.add_set_arg<const uint_>("threads", static_cast<uint_>(threads));
+    merge.add_set_arg<const uint_>("num_bins", static_cast<uint_>(num_bins));
+    const size_t merge_partial_arg =
+        merge.add_arg<const R *>(memory_object::global_memory, "partial");
+
+    merge << "const uint b = get_global_id(0);\n"
+          << type_name<R>() << " sum = 0;\n"
+          << "for(uint t = 0; t < threads; t++){\n"
+          << "    sum += partial[t * num_bins + b];\n"
+          << "}\n"
+          << result[merge.var<uint_>("b")] << " = sum;\n";
+
+    merge.set_arg(merge_partial_arg, partial.get_buffer());
+    merge.exec_1d(queue, 0, num_bins);
+}
+
+template<class InputIterator,
+         class WeightIterator,
+         class BinIterator,
+         class Binner>
+inline void dispatch_histogram(InputIterator first,
+                               InputIterator last,
+                               WeightIterator weights,
+                               BinIterator result,
+                               size_t num_bins,
+                               const Binner &binner,
+                               command_queue &queue)
+{
+    typedef typename std::iterator_traits<BinIterator>::value_type R;
+
+    BOOST_STATIC_ASSERT_MSG(
+        sizeof(R) == 4,
+        "histogram bins must be int_, uint_ or float_"
+    );
+
+    if(num_bins == 0){
+        return;
+    }
+
+    const size_t count = iterator_range_size(first, last);
+    if(count == 0){
+        ::boost::compute::fill(result, result + num_bins, R(0), queue);
+        return;
+    }
+
+    if(queue.get_device().type() & device::cpu){
+        histogram_with_threads(
+            first, count, weights, result, num_bins, binner, queue
+        );
+    }
+    else {
+        histogram_with_local_memory(
+            first, count, weights, result, num_bins, binner, queue
+        );
+    }
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_HISTOGRAM_HPP
@@ -14,6 +14,7 @@
 #include <iterator>
 
 #include <boost/assert.hpp>
+#include <boost/type_traits/is_same.hpp>
 #include <boost/type_traits/is_signed.hpp>
 #include <boost/type_traits/is_floating_point.hpp>
 
@@ -234,7 +235,8 @@ inline void radix_sort_impl(const buffer_iterator<T> first,
         options << " -DT=" << type_name<sort_type>();
         options << " -DBLOCK_SIZE=" << block_size;
 
-        if(boost::is_floating_point<value_type>::value){
+        if(boost::is_floating_point<value_type>::value ||
+           boost::is_same<value_type, half_>::value){
             options << " -DIS_FLOATING_POINT";
         }
 
@@ -0,0 +1,321 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_SEGMENTED_SORT_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_SEGMENTED_SORT_HPP
+
+#include <iterator>
+
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/detail/scalar.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/functional/atomic.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// number of elements sorted in local memory by each work-group at a time.
+// segments longer than this are sorted in tiles which are then merged.
+const size_t segmented_sort_tile_size = 256;
+const size_t segmented_sort_local_size = 128;
+
+// sorts the segments of [keys_first, keys_last) delimited by the offsets
+// in [offsets_first, offsets_last) and, if HasValues is true, permutes the
+// values beginning at values_first in the same way.
+//
+// each segment is sorted by one work-group with a bitonic network in local
+// memory (sized to the next power of two of the segment length up to the
+// tile size). segments longer than a tile are sorted tile by tile and then
+// merged with one pass per doubling of the run width, where each element
+// finds its position in the merged run by a binary search of the other run.
+template<bool HasValues,
+         class KeyIterator,
+         class ValueIterator,
+         class OffsetIterator,
+         class Compare>
+inline void dispatch_segmented_sort(KeyIterator keys_first,
+                                    KeyIterator keys_last,
+                                    ValueIterator values_first,
+                                    OffsetIterator offsets_first,
+                                    OffsetIterator offsets_last,
+                                    Compare compare,
+                                    command_queue &queue)
+{
+    typedef typename std::iterator_traits<KeyIterator>::value_type key_type;
+    typedef typename std::iterator_traits<ValueIterator>::value_type value_type;
+
+    const size_t count = iterator_range_size(keys_first, keys_last);
+    const size_t offsets_count = iterator_range_size(offsets_first, offsets_last);
+    if(count < 2 || offsets_count < 2){
+        return;
+    }
+    const size_t segments = offsets_count - 1;
+    const context &context = queue.get_context();
+
+    // sort each segment (or each tile of long segments) in local memory
+    meta_kernel k("segmented_sort_local");
+    const size_t local_keys_arg =
+        k.add_arg<key_type *>(memory_object::local_memory, "local_keys");
+    const size_t local_values_arg = HasValues ?
+        k.add_arg<value_type *>(memory_object::local_memory, "local_values") : 0;
+    const size_t local_valid_arg =
+        k.add_arg<uchar_ *>(memory_object::local_memory, "local_valid");
+
+    k <<
+        "const uint segment = get_group_id(0);\n" <<
+        "const uint lid = get_local_id(0);\n" <<
+        "const uint lsize = get_local_size(0);\n" <<
+        "const uint begin = (uint) " << offsets_first[k.var<uint_>("segment")] << ";\n" <<
+        "const uint end = (uint) " << offsets_first[k.expr<uint_>("segment+1")] << ";\n" <<
+        "if(end - begin < 2){\n" <<
+        "    return;\n" <<
+        "}\n" <<
+        "uint tile = 2;\n" <<
+        "while(tile < end - begin && tile < " << uint_(segmented_sort_tile_size) << "){\n" <<
+        "    tile <<= 1;\n" <<
+        "}\n" <<
+        "for(uint tile_begin = begin; tile_begin < end; tile_begin += tile){\n" <<
+        "    const uint n = min(end - tile_begin, tile);\n" <<
+        // load the tile, padding it with invalid elements
+        "    for(uint t = lid; t < tile; t += lsize){\n" <<
+        "        local_valid[t] = t < n;\n" <<
+        "        if(t < n){\n" <<
+        "            const uint g = tile_begin + t;\n" <<
+        "            local_keys[t] = " << keys_first[k.var<uint_>("g")] << ";\n";
+    if(HasValues){
+        k <<
+        "            local_values[t] = " << values_first[k.var<uint_>("g")] << ";\n";
+    }
+    k <<
+        "        }\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        // bitonic sort, invalid elements compare greater than all others
+        "    for(uint size = 2; size <= tile; size <<= 1){\n" <<
+        "        for(uint stride = size >> 1; stride > 0; stride >>= 1){\n" <<
+        "            for(uint t = lid; t < tile; t += lsize){\n" <<
+        "                const uint p = t ^ stride;\n" <<
+        "                if(p > t){\n" <<
+        "                    " << k.decl<key_type>("a") << " = local_keys[t];\n" <<
+        "                    " << k.decl<key_type>("b") << " = local_keys[p];\n" <<
+        "                    const uchar valid_a = local_valid[t];\n" <<
+        "                    const uchar valid_b = local_valid[p];\n" <<
+        "                    const bool exchange = (t & size) == 0 ?\n" <<
+        "                        valid_b && (!valid_a || " <<
+                                     compare(k.var<key_type>("b"), k.var<key_type>("a")) << ") :\n" <<
+        "                        valid_a && (!valid_b || " <<
+                                     compare(k.var<key_type>("a"), k.var<key_type>("b")) << ");\n" <<
+        "                    if(exchange){\n" <<
+        "                        local_keys[t] = b;\n" <<
+        "                        local_keys[p] = a;\n" <<
+        "                        local_valid[t] = valid_b;\n" <<
+        "                        local_valid[p] = valid_a;\n";
+    if(HasValues){
+        k <<
+        "                        " << k.decl<value_type>("value") << " = local_values[t];\n" <<
+        "                        local_values[t] = local_values[p];\n" <<
+        "                        local_values[p] = value;\n";
+    }
+    k <<
+        "                    }\n" <<
+        "                }\n" <<
+        "            }\n" <<
+        "            barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "        }\n" <<
+        "    }\n" <<
+        // store the sorted tile
+        "    for(uint t = lid; t < n; t += lsize){\n" <<
+        "        const uint g = tile_begin + t;\n" <<
+        "        " << keys_first[k.var<uint_>("g")] << " = local_keys[t];\n";
+    if(HasValues){
+        k <<
+        "        " << values_first[k.var<uint_>("g")] << " = local_values[t];\n";
+    }
+    k <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "}\n";
+
+    kernel local_kernel = k.compile(context);
+    const uint_ tile_size = static_cast<uint_>(segmented_sort_tile_size);
+    local_kernel.set_arg(local_keys_arg, tile_size * sizeof(key_type), 0);
+    if(HasValues){
+        local_kernel.set_arg(local_values_arg, tile_size * sizeof(value_type), 0);
+    }
+    local_kernel.set_arg(local_valid_arg, tile_size * sizeof(uchar_), 0);
+    queue.enqueue_1d_range_kernel(
+        local_kernel,
+        0,
+        segments * segmented_sort_local_size,
+        segmented_sort_local_size
+    );
+
+    // find the length of the longest segment to see if merging is needed
+    scalar<uint_> max_length(context);
+    max_length.write(0, queue);
+
+    meta_kernel length_kernel("segmented_sort_max_length");
+    const size_t max_length_arg =
+        length_kernel.add_arg<uint_ *>(memory_object::global_memory, "max_length");
+    length_kernel <<
+        "const uint i = get_global_id(0);\n" <<
+        "const uint length = (uint) " << offsets_first[length_kernel.expr<uint_>("i+1")] <<
+            " - (uint) " << offsets_first[length_kernel.var<uint_>("i")] << ";\n" <<
+        atomic_max<uint_>()(length_kernel.var<uint_ *>("max_length"),
+                            length_kernel.var<uint_>("length")) << ";\n";
+    length_kernel.set_arg(max_length_arg, max_length.get_buffer());
+    length_kernel.exec_1d(queue, 0, segments);
+
+    const size_t longest = max_length.read(queue);
+    if(longest <= segmented_sort_tile_size){
+        return;
+    }
+
+    // find the segment of each element
+    vector<uint_> segment_ids(count, context);
+
+    meta_kernel ids_kernel("segmented_sort_segment_ids");
+    ids_kernel.add_set_arg<const uint_>("segments", static_cast<uint_>(segments));
+    ids_kernel <<
+        "const uint i = get_global_id(0);\n" <<
+        "uint lo = 0;\n" <<
+        "uint hi = segments;\n" <<
+        "while(lo < hi){\n" <<
+        "    const uint mid = (lo + hi) / 2;\n" <<
+        "    if((uint) " << offsets_first[ids_kernel.var<uint_>("mid")] << " <= i){\n" <<
+        "        lo = mid + 1;\n" <<
+        "    }\n" <<
+        "    else {\n" <<
+        "        hi = mid;\n" <<
+        "    }\n" <<
+        "}\n" <<
+        segment_ids.begin()[ids_kernel.var<uint_>("i")] << " = lo > 0 ? lo - 1 : 0;\n";
+    ids_kernel.exec_1d(queue, 0, count);
+
+    // merge sorted runs within each segment, doubling the run width each
+    // pass and alternating between two temporary buffers
+    vector<key_type> keys_a(count, context);
+    vector<key_type> keys_b(count, context);
+    vector<value_type> values_a(HasValues ? count : 0, context);
+    vector<value_type> values_b(HasValues ? count : 0, context);
+
+    ::boost::compute::copy(
+        keys_first, keys_last, keys_a.begin(), queue
+    );
+    if(HasValues){
+        ::boost::compute::copy(
+            values_first, values_first + count, values_a.begin(), queue
+        );
+    }
+
+    meta_kernel m("segmented_sort_merge");
+    const size_t width_arg = m.add_arg<const uint_>("width");
+    const size_t src_keys_arg =
+        m.add_arg<const key_type *>(memory_object::global_memory, "src_keys");
+    const size_t dst_keys_arg =
+        m.add_arg<key_type *>(memory_object::global_memory, "dst_keys");
+    const size_t src_values_arg = HasValues ?
+        m.add_arg<const value_type *>(memory_object::global_memory, "src_values") : 0;
+    const size_t dst_values_arg = HasValues ?
+        m.add_arg<value_type *>(memory_object::global_memory, "dst_values") : 0;
+
+    m <<
+        "const uint i = get_global_id(0);\n" <<
+        "const uint segment = " << segment_ids.begin()[m.var<uint_>("i")] << ";\n" <<
+        "const uint begin = (uint) " << offsets_first[m.var<uint_>("segment")] << ";\n" <<
+        "const uint end = (uint) " << offsets_first[m.expr<uint_>("segment+1")] << ";\n" <<
+        m.decl<key_type>("x") << " = src_keys[i];\n" <<
+        "uint pos = i;\n" <<
+        "if(i >= begin && i < end){\n" <<
+        "    const uint run = (i - begin) / width;\n" <<
+        "    const uint run_begin = begin + run * width;\n" <<
+        "    if((run & 1) == 0){\n" <<
+        "        const uint other_begin = run_begin + width;\n" <<
+        "        if(other_begin < end){\n" <<
+        "            uint lo = other_begin;\n" <<
+        "            uint hi = min(other_begin + width, end);\n" <<
+        "            while(lo < hi){\n" <<
+        "                const uint mid = (lo + hi) / 2;\n" <<
+        "                " << m.decl<key_type>("y") << " = src_keys[mid];\n" <<
+        "                if(" << compare(m.var<key_type>("y"), m.var<key_type>("x")) << "){\n" <<
+        "                    lo = mid + 1;\n" <<
+        "                }\n" <<
+        "                else {\n" <<
+        "                    hi = mid;\n" <<
+        "                }\n" <<
+        "            }\n" <<
+        "            pos = i + (lo - other_begin);\n" <<
+        "        }\n" <<
+        "    }\n" <<
+        "    else {\n" <<
+        "        const uint other_begin = run_begin - width;\n" <<
+        "        uint lo = other_begin;\n" <<
+        "        uint hi = run_begin;\n" <<
+        "        while(lo < hi){\n" <<
+        "            const uint mid = (lo + hi) / 2;\n" <<
+        "            " << m.decl<key_type>("y") << " = src_keys[mid];\n" <<
+        "            if(!(" << compare(m.var<key_type>("x"), m.var<key_type>("y")) << ")){\n" <<
+        "                lo = mid + 1;\n" <<
+        "            }\n" <<
+        "            else {\n" <<
+        "                hi = mid;\n" <<
+        "            }\n" <<
+        "        }\n" <<
+        "        pos = i - width + (lo - other_begin);\n" <<
+        "    }\n" <<
+        "}\n" <<
+        "dst_keys[pos] = x;\n";
+    if(HasValues){
+        m << "dst_values[pos] = src_values[i];\n";
+    }
+
+    kernel merge_kernel = m.compile(context);
+
+    bool result_in_a = true;
+    for(size_t width = segmented_sort_tile_size; width < longest; width *= 2){
+        vector<key_type> &src_keys = result_in_a ? keys_a : keys_b;
+        vector<key_type> &dst_keys = result_in_a ? keys_b : keys_a;
+        merge_kernel.set_arg(width_arg, static_cast<uint_>(width));
+        merge_kernel.set_arg(src_keys_arg, src_keys.get_buffer());
+        merge_kernel.set_arg(dst_keys_arg, dst_keys.get_buffer());
+        if(HasValues){
+            vector<value_type> &src_values = result_in_a ? values_a : values_b;
+            vector<value_type> &dst_values = result_in_a ? values_b : values_a;
+            merge_kernel.set_arg(src_values_arg, src_values.get_buffer());
+            merge_kernel.set_arg(dst_values_arg, dst_values.get_buffer());
+        }
+        queue.enqueue_1d_range_kernel(merge_kernel, 0, count, 0);
+
+        result_in_a = !result_in_a;
+    }
+
+    const vector<key_type> &keys_result = result_in_a ? keys_a : keys_b;
+    ::boost::compute::copy(
+        keys_result.begin(), keys_result.end(), keys_first, queue
+    );
+    if(HasValues){
+        const vector<value_type> &values_result = result_in_a ? values_a : values_b;
+        ::boost::compute::copy(
+            values_result.begin(), values_result.end(), values_first, queue
+        );
+    }
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_SEGMENTED_SORT_HPP
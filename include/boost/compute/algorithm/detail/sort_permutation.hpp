@@ -0,0 +1,260 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_SORT_PERMUTATION_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_SORT_PERMUTATION_HPP
+
+#include <string>
+#include <vector>
+#include <iterator>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/gather.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/detail/insertion_sort.hpp>
+#include <boost/compute/algorithm/detail/radix_sort.hpp>
+#include <boost/compute/algorithm/detail/segmented_sort.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/iterator/zip_iterator.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// sorts with a user-defined comparison as a single segment of the
+// segmented sort (local memory bitonic tiles followed by merge passes)
+template<class KeyIterator, class Compare>
+inline void sort_keys_with_indices(KeyIterator keys_first,
+                                   KeyIterator keys_last,
+                                   vector<uint_> &indices,
+                                   Compare compare,
+                                   command_queue &queue)
+{
+    const size_t count = iterator_range_size(keys_first, keys_last);
+
+    uint_ offsets_data[] = { 0, static_cast<uint_>(count) };
+    vector<uint_> offsets(offsets_data, offsets_data + 2, queue);
+
+    dispatch_segmented_sort<true>(
+        keys_first, keys_last, indices.begin(),
+        offsets.begin(), offsets.end(), compare, queue
+    );
+}
+
+// sorts keys stored in a buffer along with indices, using the stable radix
+// sort (radix_sort_by_key() reads the keys from their buffer directly)
+template<class KeyIterator>
+inline void radix_sort_keys_with_indices(KeyIterator keys_first,
+                                         KeyIterator keys_last,
+                                         vector<uint_> &indices,
+                                         boost::true_type /* buffer keys */,
+                                         command_queue &queue)
+{
+    typedef typename std::iterator_traits<KeyIterator>::value_type key_type;
+
+    const size_t count = iterator_range_size(keys_first, keys_last);
+    if(count < 32){
+        serial_insertion_sort_by_key(
+            keys_first, keys_last, indices.begin(), less<key_type>(), queue
+        );
+    }
+    else {
+        radix_sort_by_key(keys_first, keys_last, indices.begin(), queue);
+    }
+}
+
+// keys from other device iterators are sorted with less
+template<class KeyIterator>
+inline void radix_sort_keys_with_indices(KeyIterator keys_first,
+                                         KeyIterator keys_last,
+                                         vector<uint_> &indices,
+                                         boost::false_type /* buffer keys */,
+                                         command_queue &queue)
+{
+    typedef typename std::iterator_traits<KeyIterator>::value_type key_type;
+
+    sort_keys_with_indices(keys_first, keys_last, indices, less<key_type>(), queue);
+}
+
+// sorts the keys in [keys_first, keys_last) in place and applies the same
+// permutation to indices (typically filled with 0..n-1 beforehand). uses
+// the stable radix sort for arithmetic keys in buffers compared with less.
+template<class KeyIterator>
+inline void sort_keys_with_indices(KeyIterator keys_first,
+                                   KeyIterator keys_last,
+                                   vector<uint_> &indices,
+                                   boost::true_type /* radix sortable */,
+                                   command_queue &queue)
+{
+    typedef typename std::iterator_traits<KeyIterator>::value_type key_type;
+
+    radix_sort_keys_with_indices(
+        keys_first,
+        keys_last,
+        indices,
+        typename boost::is_same<KeyIterator, buffer_iterator<key_type> >::type(),
+        queue
+    );
+}
+
+template<class KeyIterator>
+inline void sort_keys_with_indices(KeyIterator keys_first,
+                                   KeyIterator keys_last,
+                                   vector<uint_> &indices,
+                                   boost::false_type /* radix sortable */,
+                                   command_queue &queue)
+{
+    typedef typename std::iterator_traits<KeyIterator>::value_type key_type;
+
+    sort_keys_with_indices(keys_first, keys_last, indices, less<key_type>(), queue);
+}
+
+// appends code to k which writes each column of the zip iterator at
+// index i from a copy of the column at index "index"
+template<size_t N, size_t Size>
+struct zip_gather_columns
+{
+    template<class IteratorTuple>
+    static void apply(meta_kernel &k,
+                      const IteratorTuple &iterators,
+                      size_t count,
+                      std::vector<buffer> &copies,
+                      command_queue &queue)
+    {
+        typedef typename
+            boost::tuples::element<N, IteratorTuple>::type iterator_type;
+        typedef typename
+            std::iterator_traits<iterator_type>::value_type value_type;
+
+        iterator_type column = boost::get<N>(iterators);
+
+        buffer column_copy(queue.get_context(), count * sizeof(value_type));
+        ::boost::compute::copy(
+            column,
+            column + count,
+            make_buffer_iterator<value_type>(column_copy, 0),
+            queue
+        );
+        copies.push_back(column_copy);
+
+        const std::string name =
+            "column" + boost::lexical_cast<std::string>(N);
+        const size_t arg =
+            k.add_arg<const value_type *>(memory_object::global_memory, name);
+        k.set_arg(arg, column_copy);
+
+        k << column[k.var<uint_>("i")] << " = " << name << "[index];\n";
+
+        zip_gather_columns<N + 1, Size>::apply(k, iterators, count, copies, queue);
+    }
+};
+
+template<size_t Size>
+struct zip_gather_columns<Size, Size>
+{
+    template<class IteratorTuple>
+    static void apply(meta_kernel &,
+                      const IteratorTuple &,
+                      size_t,
+                      std::vector<buffer> &,
+                      command_queue &)
+    {
+    }
+};
+
+// permutes every column of values in place so that column[i] becomes
+// column[indices[i]], with a single kernel for all of the columns
+template<class IteratorTuple>
+inline void gather_zip_columns(const vector<uint_> &indices,
+                               zip_iterator<IteratorTuple> values,
+                               command_queue &queue)
+{
+    const size_t count = indices.size();
+    if(count == 0){
+        return;
+    }
+
+    // keeps the column copies alive until the kernel has been enqueued
+    std::vector<buffer> copies;
+
+    meta_kernel k("gather_zip_columns");
+    k << "const uint i = get_global_id(0);\n"
+      << "const uint index = " << indices.begin()[k.var<uint_>("i")] << ";\n";
+    zip_gather_columns<
+        0, boost::tuples::length<IteratorTuple>::value
+    >::apply(k, values.get_iterator_tuple(), count, copies, queue);
+
+    k.exec_1d(queue, 0, count);
+}
+
+// stably sorts indices by the key column N-1, then N-2 and so on down to
+// column 0, which leaves them in lexicographic order of the key tuples
+template<size_t N>
+struct lexicographic_sort_indices
+{
+    template<class IteratorTuple>
+    static void apply(const IteratorTuple &keys,
+                      size_t count,
+                      vector<uint_> &indices,
+                      command_queue &queue)
+    {
+        typedef typename
+            boost::tuples::element<N - 1, IteratorTuple>::type iterator_type;
+        typedef typename
+            std::iterator_traits<iterator_type>::value_type key_type;
+
+        BOOST_STATIC_ASSERT_MSG(
+            boost::is_arithmetic<key_type>::value,
+            "lexicographic sorting requires arithmetic key columns"
+        );
+
+        iterator_type column = boost::get<N - 1>(keys);
+
+        vector<key_type> permuted(count, queue.get_context());
+        ::boost::compute::gather(
+            indices.begin(), indices.end(), column, permuted.begin(), queue
+        );
+        sort_keys_with_indices(
+            permuted.begin(), permuted.end(), indices, boost::true_type(), queue
+        );
+
+        lexicographic_sort_indices<N - 1>::apply(keys, count, indices, queue);
+    }
+};
+
+template<>
+struct lexicographic_sort_indices<0>
+{
+    template<class IteratorTuple>
+    static void apply(const IteratorTuple &,
+                      size_t,
+                      vector<uint_> &,
+                      command_queue &)
+    {
+    }
+};
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_SORT_PERMUTATION_HPP
@@ -0,0 +1,292 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_SUMMATION_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_SUMMATION_HPP
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <boost/compute/functional.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/summation_policy.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// elements summed by each lane of a block in the reproducible summation
+static const uint_ reproducible_sum_lanes = 32;
+
+// elements in each block of the reproducible summation. the blocks and
+// the order in which they are summed do not depend on the device
+static const uint_ reproducible_sum_block =
+    reproducible_sum_lanes * reproducible_sum_lanes;
+
+// work-items per group in the summation kernels, a multiple of the lanes
+static const size_t summation_local_size = 128;
+
+// adds x to the compensated sum (s, c) on the host
+template<class T>
+inline void neumaier_add(T &s, T &c, T x)
+{
+    const T t = s + x;
+    if(std::fabs(s) >= std::fabs(x)){
+        c += (s - t) + x;
+    }
+    else {
+        c += (x - t) + s;
+    }
+    s = t;
+}
+
+// adds the function neumaier_add_T() which adds x to the compensated sum
+// (s, c) in the kernel
+template<class T>
+inline std::string add_neumaier_function(meta_kernel &k)
+{
+    const std::string type = type_name<T>();
+    const std::string name = std::string("boost_neumaier_add_") + type;
+
+    k.add_function(name,
+        "inline void " + name + "(" + type + " *s, " + type + " *c, "
+            "const " + type + " x)\n"
+        "{\n"
+        "    const " + type + " t = *s + x;\n"
+        "    if(fabs(*s) >= fabs(x)){\n"
+        "        *c += (*s - t) + x;\n"
+        "    }\n"
+        "    else {\n"
+        "        *c += (x - t) + *s;\n"
+        "    }\n"
+        "    *s = t;\n"
+        "}\n"
+    );
+
+    return name;
+}
+
+// merges the compensated sums of lid and lid + offset in local memory
+inline void emit_neumaier_local_merge(meta_kernel &k,
+                                      const std::string &add,
+                                      const std::string &offset)
+{
+    k <<
+        "{\n" <<
+        "    s = scratch_s[lid];\n" <<
+        "    c = scratch_c[lid];\n" <<
+        "    " << add << "(&s, &c, scratch_s[lid + " << offset << "]);\n" <<
+        "    scratch_s[lid] = s;\n" <<
+        "    scratch_c[lid] = c + scratch_c[lid + " << offset << "];\n" <<
+        "}\n";
+}
+
+// sums each block of reproducible_sum_block values in [first, first +
+// count) into result. every block is split into lanes which each sum every
+// lanes'th value of the block and the lane sums are merged with a fixed
+// pairwise tree, so the order of the additions depends only on the index
+// of each value
+template<class InputIterator, class T>
+inline void reproducible_sum_blocks(InputIterator first,
+                                    size_t count,
+                                    vector<T> &result,
+                                    command_queue &queue)
+{
+    const size_t blocks =
+        (count + reproducible_sum_block - 1) / reproducible_sum_block;
+    const size_t local_size = summation_local_size;
+
+    meta_kernel k("reproducible_sum_blocks");
+    const std::string add = add_neumaier_function<T>(k);
+    size_t count_arg = k.add_arg<const uint_>("count");
+    size_t result_arg = k.add_arg<T *>(memory_object::global_memory, "result");
+
+    k <<
+        // the compiler must not contract the additions into fma's
+        "#pragma OPENCL FP_CONTRACT OFF\n" <<
+        "__local " << type_name<T>() << " scratch_s[" << uint_(local_size) << "];\n" <<
+        "__local " << type_name<T>() << " scratch_c[" << uint_(local_size) << "];\n" <<
+        "const uint lid = get_local_id(0);\n" <<
+        "const uint block = get_global_id(0) / " << reproducible_sum_lanes << ";\n" <<
+        "const uint lane = get_global_id(0) % " << reproducible_sum_lanes << ";\n" <<
+        "const uint start = block * " << reproducible_sum_block << " + lane;\n" <<
+        k.decl<T>("s") << " = 0;\n" <<
+        k.decl<T>("c") << " = 0;\n" <<
+        "for(uint j = 0; j < " << reproducible_sum_lanes << "; j++){\n" <<
+        "    const uint i = start + j * " << reproducible_sum_lanes << ";\n" <<
+        "    if(i < count){\n" <<
+        "        " << add << "(&s, &c, (" << type_name<T>() << ")" <<
+                     first[k.var<uint_>("i")] << ");\n" <<
+        "    }\n" <<
+        "}\n" <<
+        "scratch_s[lid] = s;\n" <<
+        "scratch_c[lid] = c;\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "for(uint d = " << reproducible_sum_lanes / 2 << "; d > 0; d >>= 1){\n" <<
+        "    if(lane < d)";
+    emit_neumaier_local_merge(k, add, "d");
+    k <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "}\n" <<
+        "if(lane == 0 && block < " << uint_(blocks) << "){\n" <<
+        "    result[block] = scratch_s[lid] + scratch_c[lid];\n" <<
+        "}\n";
+
+    const size_t work_items = blocks * reproducible_sum_lanes;
+    const size_t global_size =
+        (work_items + local_size - 1) / local_size * local_size;
+
+    result.resize(blocks, queue);
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(count_arg, uint_(count));
+    kernel.set_arg(result_arg, result.get_buffer());
+    queue.enqueue_1d_range_kernel(kernel, 0, global_size, local_size);
+}
+
+// sums the values on the host in their order with compensated summation
+template<class T>
+inline T compensated_host_sum(T init,
+                              const std::vector<T> &sums,
+                              const std::vector<T> &corrections)
+{
+    T s = init;
+    T c = 0;
+    for(size_t i = 0; i < sums.size(); i++){
+        neumaier_add(s, c, sums[i]);
+        if(!corrections.empty()){
+            c += corrections[i];
+        }
+    }
+
+    return s + c;
+}
+
+template<class InputIterator, class T>
+inline T summation_accumulate(InputIterator first,
+                              InputIterator last,
+                              T init,
+                              fast_summation,
+                              command_queue &queue)
+{
+    T sum;
+    reduce(first, last, &sum, plus<T>(), queue);
+
+    return init + sum;
+}
+
+template<class InputIterator, class T>
+inline T summation_accumulate(InputIterator first,
+                              InputIterator last,
+                              T init,
+                              compensated_summation,
+                              command_queue &queue)
+{
+    const context &context = queue.get_context();
+    const size_t count = iterator_range_size(first, last);
+    const size_t local_size = summation_local_size;
+
+    size_t groups = (count + local_size - 1) / local_size;
+    groups = (std::min)(groups, size_t(queue.get_device().compute_units()) * 4);
+
+    // each work-item sums a strided part of the range and the work-group
+    // merges the compensated sums of its work-items
+    meta_kernel k("compensated_sum");
+    const std::string add = add_neumaier_function<T>(k);
+    size_t count_arg = k.add_arg<const uint_>("count");
+    size_t result_arg = k.add_arg<T *>(memory_object::global_memory, "result");
+
+    k <<
+        "__local " << type_name<T>() << " scratch_s[" << uint_(local_size) << "];\n" <<
+        "__local " << type_name<T>() << " scratch_c[" << uint_(local_size) << "];\n" <<
+        "const uint lid = get_local_id(0);\n" <<
+        k.decl<T>("s") << " = 0;\n" <<
+        k.decl<T>("c") << " = 0;\n" <<
+        "for(uint i = get_global_id(0); i < count; i += get_global_size(0)){\n" <<
+        "    " << add << "(&s, &c, (" << type_name<T>() << ")" <<
+                 first[k.var<uint_>("i")] << ");\n" <<
+        "}\n" <<
+        "scratch_s[lid] = s;\n" <<
+        "scratch_c[lid] = c;\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "for(uint d = get_local_size(0) / 2; d > 0; d >>= 1){\n" <<
+        "    if(lid < d)";
+    emit_neumaier_local_merge(k, add, "d");
+    k <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "}\n" <<
+        "if(lid == 0){\n" <<
+        "    result[get_group_id(0)] = scratch_s[0];\n" <<
+        "    result[get_num_groups(0) + get_group_id(0)] = scratch_c[0];\n" <<
+        "}\n";
+
+    vector<T> partials(2 * groups, context);
+
+    kernel kernel = k.compile(context);
+    kernel.set_arg(count_arg, uint_(count));
+    kernel.set_arg(result_arg, partials.get_buffer());
+    queue.enqueue_1d_range_kernel(kernel, 0, groups * local_size, local_size);
+
+    // merge the partial sums of the work-groups on the host
+    std::vector<T> host_partials(2 * groups);
+    copy(partials.begin(), partials.end(), host_partials.begin(), queue);
+
+    return compensated_host_sum(
+        init,
+        std::vector<T>(host_partials.begin(), host_partials.begin() + groups),
+        std::vector<T>(host_partials.begin() + groups, host_partials.end())
+    );
+}
+
+template<class InputIterator, class T>
+inline T summation_accumulate(InputIterator first,
+                              InputIterator last,
+                              T init,
+                              reproducible_summation,
+                              command_queue &queue)
+{
+    const context &context = queue.get_context();
+    size_t count = iterator_range_size(first, last);
+
+    // sum the range into block sums and then the block sums into block
+    // sums of their own until few enough are left to sum on the host
+    vector<T> sums(context);
+    vector<T> next(context);
+    reproducible_sum_blocks(first, count, sums, queue);
+    count = sums.size();
+
+    while(count > reproducible_sum_block){
+        reproducible_sum_blocks(
+            make_buffer_iterator<T>(sums.get_buffer()), count, next, queue
+        );
+        sums.swap(next);
+        count = sums.size();
+    }
+
+    std::vector<T> host_sums(count);
+    copy(sums.begin(), sums.begin() + count, host_sums.begin(), queue);
+
+    return compensated_host_sum(init, host_sums, std::vector<T>());
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_SUMMATION_HPP
@@ -0,0 +1,206 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_TRANSFORM_ON_DEVICE_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_TRANSFORM_ON_DEVICE_HPP
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/iterator/transform_iterator.hpp>
+#include <boost/compute/iterator/zip_iterator.hpp>
+#include <boost/compute/functional/detail/unpack.hpp>
+#include <boost/compute/detail/elementwise_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// element-wise kernel which loads and stores its values as vectors of
+// width values. the function is applied to each component of the loaded
+// vectors so it does not need to support vector types.
+class vector_transform_kernel : public elementwise_kernel
+{
+public:
+    vector_transform_kernel(const device &device, uint_ width)
+        : elementwise_kernel("transform_vector", device),
+          m_width(width)
+    {
+    }
+
+    // declares the pointer name to the values starting at iter. the
+    // offset is passed as an argument so that the program is reused for
+    // ranges starting anywhere in a buffer.
+    template<class T>
+    void add_pointer(const std::string &name, const buffer_iterator<T> &iter)
+    {
+        const std::string offset = name + "_offset";
+        m_offsets.push_back(
+            std::make_pair(add_arg<uint_>(offset), iter.get_index())
+        );
+
+        *this <<
+            "__global " << type<T *>() << " " << name << " = " <<
+                get_buffer_identifier<T>(iter.get_buffer()) << " + " << offset << ";\n";
+    }
+
+    event exec(command_queue &queue, size_t count, size_t head)
+    {
+        for(size_t i = 0; i < m_offsets.size(); i++){
+            set_arg(m_offsets[i].first, uint_(m_offsets[i].second));
+        }
+
+        return exec_vectors(queue, count, head, m_width);
+    }
+
+private:
+    uint_ m_width;
+    std::vector<std::pair<size_t, size_t> > m_offsets;
+};
+
+// returns the vector width to transform values of type T to values of
+// type U on device, or 0 if they should be transformed one at a time
+template<class T, class U>
+inline uint_ transform_vector_width(size_t count, const device &device)
+{
+    const uint_ input_width = elementwise_kernel::vector_width<T>(device);
+    const uint_ output_width = elementwise_kernel::vector_width<U>(device);
+    if(input_width == 0 || output_width == 0){
+        return 0;
+    }
+
+    const uint_ width = (std::min)(input_width, output_width);
+
+    // too few values to fill a vector after the aligned head
+    if(count < 2 * width){
+        return 0;
+    }
+
+    return width;
+}
+
+template<class T, class U, class UnaryOperator>
+inline buffer_iterator<U> transform_on_device(buffer_iterator<T> first,
+                                              buffer_iterator<T> last,
+                                              buffer_iterator<U> result,
+                                              UnaryOperator op,
+                                              command_queue &queue)
+{
+    typedef typename kernel_value_type<T>::type input_type;
+
+    const size_t count = detail::iterator_range_size(first, last);
+    const uint_ width =
+        transform_vector_width<T, U>(count, queue.get_device());
+    if(width == 0){
+        return ::boost::compute::copy(
+                   ::boost::compute::make_transform_iterator(first, op),
+                   ::boost::compute::make_transform_iterator(last, op),
+                   result,
+                   queue
+               );
+    }
+
+    vector_transform_kernel k(queue.get_device(), width);
+    k.add_pointer("input", first);
+    k.add_pointer("output", result);
+
+    k.begin_scalar_loop(width);
+    k.store<U>("output", op(k.load<T>("input")));
+    k.end_scalar_loop();
+
+    k.begin_loop();
+    k.vload<T>("x", "input", width);
+    k << k.type<U>() << width << " y;\n";
+    for(uint_ i = 0; i < width; i++){
+        const std::string c = elementwise_kernel::vector_component(i);
+        k << "y." << c << " = " << op(k.var<input_type>("x." + c)) << ";\n";
+    }
+    k.vstore<U>("y", "output", width);
+    k.end_loop();
+
+    const size_t head =
+        elementwise_kernel::vector_head(result.get_index(), count, width);
+    k.exec(queue, count, head);
+
+    return result + count;
+}
+
+template<class T1, class T2, class U, class BinaryOperator>
+inline buffer_iterator<U> transform_on_device(buffer_iterator<T1> first1,
+                                              buffer_iterator<T1> last1,
+                                              buffer_iterator<T2> first2,
+                                              buffer_iterator<U> result,
+                                              BinaryOperator op,
+                                              command_queue &queue)
+{
+    typedef typename kernel_value_type<T1>::type input_type1;
+    typedef typename kernel_value_type<T2>::type input_type2;
+
+    const size_t count = detail::iterator_range_size(first1, last1);
+    uint_ width = transform_vector_width<T1, U>(count, queue.get_device());
+    if(width != 0){
+        width = (std::min)(
+            width, transform_vector_width<T2, U>(count, queue.get_device())
+        );
+    }
+    if(width == 0){
+        return ::boost::compute::copy(
+                   ::boost::compute::make_transform_iterator(
+                       make_zip_iterator(boost::make_tuple(first1, first2)),
+                       detail::unpack(op)
+                   ),
+                   ::boost::compute::make_transform_iterator(
+                       make_zip_iterator(boost::make_tuple(last1, first2 + count)),
+                       detail::unpack(op)
+                   ),
+                   result,
+                   queue
+               );
+    }
+
+    vector_transform_kernel k(queue.get_device(), width);
+    k.add_pointer("input1", first1);
+    k.add_pointer("input2", first2);
+    k.add_pointer("output", result);
+
+    k.begin_scalar_loop(width);
+    k.store<U>("output", op(k.load<T1>("input1"), k.load<T2>("input2")));
+    k.end_scalar_loop();
+
+    k.begin_loop();
+    k.vload<T1>("x1", "input1", width);
+    k.vload<T2>("x2", "input2", width);
+    k << k.type<U>() << width << " y;\n";
+    for(uint_ i = 0; i < width; i++){
+        const std::string c = elementwise_kernel::vector_component(i);
+        k << "y." << c << " = " <<
+            op(k.var<input_type1>("x1." + c), k.var<input_type2>("x2." + c)) << ";\n";
+    }
+    k.vstore<U>("y", "output", width);
+    k.end_loop();
+
+    const size_t head =
+        elementwise_kernel::vector_head(result.get_index(), count, width);
+    k.exec(queue, count, head);
+
+    return result + count;
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_TRANSFORM_ON_DEVICE_HPP
@@ -17,6 +17,8 @@
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/lower_bound.hpp>
 #include <boost/compute/algorithm/upper_bound.hpp>
+#include <boost/compute/algorithm/detail/batched_binary_search.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
 namespace compute {
@@ -36,6 +38,58 @@ equal_range(InputIterator first,
            );
 }
 
+/// Stores the range of elements equal to each value in the range
+/// [\p values_first, \p values_last) in the sorted range
+/// [\p first, \p last): the index of the first element in the range is
+/// stored in the range beginning at \p lower_result and the index one
+/// past the last element in the range beginning at \p upper_result.
+/// Returns iterators to the ends of both results.
+///
+/// The number of occurrences of each value is the difference between its
+/// upper and lower result. Pass \c true for \p values_sorted if the values
+/// are sorted (see lower_bound()).
+///
+/// \see lower_bound(), upper_bound()
+template<class InputIterator, class ValueIterator, class OutputIterator>
+inline std::pair<OutputIterator, OutputIterator>
+equal_range(InputIterator first,
+            InputIterator last,
+            ValueIterator values_first,
+            ValueIterator values_last,
+            OutputIterator lower_result,
+            OutputIterator upper_result,
+            bool values_sorted,
+            command_queue &queue = system::default_queue())
+{
+    return std::make_pair(
+               ::boost::compute::lower_bound(
+                   first, last, values_first, values_last, lower_result,
+                   values_sorted, queue
+               ),
+               ::boost::compute::upper_bound(
+                   first, last, values_first, values_last, upper_result,
+                   values_sorted, queue
+               )
+           );
+}
+
+/// \overload
+template<class InputIterator, class ValueIterator, class OutputIterator>
+inline std::pair<OutputIterator, OutputIterator>
+equal_range(InputIterator first,
+            InputIterator last,
+            ValueIterator values_first,
+            ValueIterator values_last,
+            OutputIterator lower_result,
+            OutputIterator upper_result,
+            command_queue &queue = system::default_queue())
+{
+    return ::boost::compute::equal_range(
+        first, last, values_first, values_last, lower_result, upper_result,
+        false, queue
+    );
+}
+
 } // end compute namespace
 } // end boost namespace
 
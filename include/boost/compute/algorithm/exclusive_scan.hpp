@@ -11,9 +11,15 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_EXCLUSIVE_SCAN_HPP
 #define BOOST_COMPUTE_ALGORITHM_EXCLUSIVE_SCAN_HPP
 
+#include <boost/utility/enable_if.hpp>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/wait_list.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/async/detail/wait_list_barrier.hpp>
 #include <boost/compute/algorithm/detail/scan.hpp>
+#include <boost/compute/detail/is_device_iterator.hpp>
 
 namespace boost {
 namespace compute {
@@ -44,6 +50,35 @@ exclusive_scan(InputIterator first,
     return detail::scan(first, last, result, true, queue);
 }
 
+/// Asynchronously performs an exclusive scan of the elements in the range
+/// [\p first, \p last) and stores the results in the range beginning at
+/// \p result. The scan starts after the events in \p events have
+/// completed.
+///
+/// This function only enqueues the scan and returns without blocking the
+/// host. Unlike exclusive_scan(), it only accepts device iterators. The
+/// returned future completes with the scan.
+///
+/// \see exclusive_scan()
+template<class InputIterator, class OutputIterator>
+inline typename boost::enable_if_c<
+    detail::is_device_iterator<InputIterator>::value &&
+    detail::is_device_iterator<OutputIterator>::value,
+    future<OutputIterator>
+>::type
+exclusive_scan_async(InputIterator first,
+                     InputIterator last,
+                     OutputIterator result,
+                     command_queue &queue = system::default_queue(),
+                     const wait_list &events = wait_list())
+{
+    detail::enqueue_wait_list_barrier(queue, events);
+
+    OutputIterator end = detail::scan(first, last, result, true, queue);
+
+    return make_future(end, queue.enqueue_marker());
+}
+
 } // end compute namespace
 } // end boost namespace
 
@@ -11,17 +11,56 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_FIND_HPP
 #define BOOST_COMPUTE_ALGORITHM_FIND_HPP
 
+#include <algorithm>
+#include <iterator>
+
 #include <boost/compute/lambda.hpp>
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/host_dispatch.hpp>
 #include <boost/compute/algorithm/find_if.hpp>
 #include <boost/compute/type_traits/vector_size.hpp>
 
 namespace boost {
 namespace compute {
+namespace detail {
+
+template<class InputIterator, class T>
+inline InputIterator find_on_host(InputIterator first,
+                                  InputIterator last,
+                                  const T &value,
+                                  command_queue &queue,
+                                  boost::true_type)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    scoped_host_map<value_type> values(
+        first, iterator_range_size(first, last), CL_MAP_READ, queue
+    );
+
+    // value is not converted to value_type, the values are compared with
+    // the usual arithmetic conversions like in the kernel of find_if()
+    const value_type *position = std::find(values.begin(), values.end(), value);
+
+    return first + (position - values.begin());
+}
+
+template<class InputIterator, class T>
+inline InputIterator find_on_host(InputIterator first,
+                                  InputIterator,
+                                  const T&,
+                                  command_queue&,
+                                  boost::false_type)
+{
+    return first;
+}
+
+} // end detail namespace
 
 /// Returns an iterator pointing to the first element in the range
 /// [\p first, \p last) that equals \p value.
+///
+/// Small ranges are searched on the host (see host_dispatch).
 template<class InputIterator, class T>
 inline InputIterator find(InputIterator first,
                           InputIterator last,
@@ -33,6 +72,13 @@ inline InputIterator find(InputIterator first,
     using ::boost::compute::_1;
     using ::boost::compute::lambda::all;
 
+    if(detail::dispatch_to_host(first, last, host_dispatch::find_algorithm, queue)){
+        return detail::find_on_host(
+            first, last, value, queue,
+            typename detail::is_host_dispatchable<InputIterator>::type()
+        );
+    }
+
     if(vector_size<value_type>::value == 1){
         return ::boost::compute::find_if(
                    first,
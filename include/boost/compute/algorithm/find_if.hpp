@@ -14,19 +14,32 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/detail/find_if_with_atomics.hpp>
+#include <boost/compute/algorithm/detail/find_if_with_early_exit.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
 namespace compute {
 
 /// Returns an iterator pointing to the first element in the range
 /// [\p first, \p last) for which \p predicate returns \c true.
+///
+/// Large ranges are searched in windows of increasing size and the search
+/// stops soon after a match is found, so finding a match near the
+/// beginning of the range is much faster than scanning all of it. This
+/// also applies to the algorithms implemented with find_if() such as
+/// find(), any_of(), all_of(), none_of(), mismatch() and equal().
 template<class InputIterator, class UnaryPredicate>
 inline InputIterator find_if(InputIterator first,
                              InputIterator last,
                              UnaryPredicate predicate,
                              command_queue &queue = system::default_queue())
 {
-    return detail::find_if_with_atomics(first, last, predicate, queue);
+    if(detail::iterator_range_size(first, last) < 65536){
+        return detail::find_if_with_atomics(first, last, predicate, queue);
+    }
+    else {
+        return detail::find_if_with_early_exit(first, last, predicate, queue);
+    }
 }
 
 } // end compute namespace
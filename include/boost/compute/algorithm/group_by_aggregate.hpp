@@ -0,0 +1,339 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_GROUP_BY_AGGREGATE_HPP
+#define BOOST_COMPUTE_ALGORITHM_GROUP_BY_AGGREGATE_HPP
+
+#include <limits>
+#include <sstream>
+#include <string>
+#include <iterator>
+
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/fill_n.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/detail/hash_table.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/functional/atomic.hpp>
+#include <boost/compute/functional/integer.hpp>
+#include <boost/compute/functional/math.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// describes how group_by_aggregate() combines values with Function. the
+// atomic function is used for integers, floats use a compare-and-swap
+// loop around combine().
+template<class Function>
+struct group_by_aggregate_op;
+
+template<class T>
+struct group_by_aggregate_op<plus<T> >
+{
+    static const char* atomic_function()
+    {
+        return BOOST_COMPUTE_DETAIL_ATOMIC_PREFIX "add";
+    }
+
+    static std::string combine(const std::string &a, const std::string &b)
+    {
+        return a + " + " + b;
+    }
+
+    static T identity()
+    {
+        return T(0);
+    }
+};
+
+template<class T>
+struct group_by_aggregate_op<min<T> >
+{
+    static const char* atomic_function()
+    {
+        return BOOST_COMPUTE_DETAIL_ATOMIC_PREFIX "min";
+    }
+
+    static std::string combine(const std::string &a, const std::string &b)
+    {
+        return "min(" + a + ", " + b + ")";
+    }
+
+    static T identity()
+    {
+        return (std::numeric_limits<T>::max)();
+    }
+};
+
+template<class T>
+struct group_by_aggregate_op<max<T> >
+{
+    static const char* atomic_function()
+    {
+        return BOOST_COMPUTE_DETAIL_ATOMIC_PREFIX "max";
+    }
+
+    static std::string combine(const std::string &a, const std::string &b)
+    {
+        return "max(" + a + ", " + b + ")";
+    }
+
+    static T identity()
+    {
+        return std::numeric_limits<T>::is_integer ?
+                   (std::numeric_limits<T>::min)() :
+                   -(std::numeric_limits<T>::max)();
+    }
+};
+
+template<class T>
+struct group_by_aggregate_op<fmin<T> > : group_by_aggregate_op<min<T> >
+{
+    static std::string combine(const std::string &a, const std::string &b)
+    {
+        return "fmin(" + a + ", " + b + ")";
+    }
+};
+
+template<class T>
+struct group_by_aggregate_op<fmax<T> > : group_by_aggregate_op<max<T> >
+{
+    static std::string combine(const std::string &a, const std::string &b)
+    {
+        return "fmax(" + a + ", " + b + ")";
+    }
+};
+
+// returns the source for a function which atomically combines v into *p
+template<class T, class Op>
+inline std::string make_group_by_update_function(const std::string &name,
+                                                 const std::string &address_space)
+{
+    std::stringstream s;
+    s << "inline void " << name << "(volatile " << address_space << " "
+      << type_name<T>() << " *p, const " << type_name<T>() << " v)\n"
+      << "{\n";
+    if(std::numeric_limits<T>::is_integer){
+        s << "    " << Op::atomic_function() << "(p, v);\n";
+    }
+    else {
+        s << "    union { uint u; float f; } expected, desired;\n"
+          << "    do {\n"
+          << "        expected.f = *p;\n"
+          << "        desired.f = " << Op::combine("expected.f", "v") << ";\n"
+          << "    } while(" << BOOST_COMPUTE_DETAIL_ATOMIC_PREFIX "cmpxchg("
+          <<          "(volatile " << address_space << " uint *) p, "
+          <<          "expected.u, desired.u) != expected.u);\n";
+    }
+    s << "}\n";
+
+    return s.str();
+}
+
+} // end detail namespace
+
+/// Groups the values in the range beginning at \p values_first by the
+/// corresponding key in the range [\p keys_first, \p keys_last) and
+/// combines the values of each group with \p function. The distinct keys
+/// are stored in \p keys_result and the aggregated values in
+/// \p values_result, both of which are resized to the number of groups.
+/// Returns the number of groups.
+///
+/// \p function may be plus<T> (sum), min<T>, max<T>, fmin<T> or fmax<T>.
+/// The number of values per key can be computed by summing a
+/// constant_iterator with value \c 1.
+///
+/// Unlike sorting by key and reducing, the keys are grouped with a hash
+/// table and each value is combined into its group's accumulator with an
+/// atomic operation, so the payload is never reordered. Values are first
+/// pre-aggregated in a small hash table in local memory per work-group,
+/// which greatly reduces global atomic contention for skewed keys.
+///
+/// The output size is determined on the device in a first pass (building
+/// the hash table) before any output is written, so it does not need to
+/// be guessed on the host.
+///
+/// Keys must be 32-bit integers and values must be \c int_, \c uint_ or
+/// \c float_. The two largest key values are reserved (see unordered_map)
+/// and rows with these keys are ignored. The order of the groups in the
+/// output is unspecified.
+///
+/// For example, to sum the sales for each product:
+/// \code
+/// vector<int> products_result(context);
+/// vector<float> totals(context);
+/// size_t n = group_by_aggregate(product_ids.begin(), product_ids.end(),
+///                               sales.begin(), products_result, totals,
+///                               plus<float>(), queue);
+/// \endcode
+///
+/// \see reduce_by_key(), hash_join()
+template<class InputKeyIterator,
+         class InputValueIterator,
+         class Key,
+         class T,
+         class Function>
+inline size_t group_by_aggregate(InputKeyIterator keys_first,
+                                 InputKeyIterator keys_last,
+                                 InputValueIterator values_first,
+                                 vector<Key> &keys_result,
+                                 vector<T> &values_result,
+                                 Function function,
+                                 command_queue &queue = system::default_queue())
+{
+    typedef detail::group_by_aggregate_op<Function> op;
+
+    BOOST_STATIC_ASSERT_MSG(
+        sizeof(T) == 4,
+        "group_by_aggregate() values must be int_, uint_ or float_"
+    );
+    (void) function;
+
+    const context &context = queue.get_context();
+    const size_t count = detail::iterator_range_size(keys_first, keys_last);
+    if(count == 0){
+        keys_result.resize(0, queue);
+        values_result.resize(0, queue);
+        return 0;
+    }
+
+    // first pass: insert the keys into a hash table which gives the number
+    // of groups and a slot for each group's accumulator
+    detail::hash_table<Key, uchar_, false> table(
+        0,
+        detail::hash_table_key_traits<Key>::empty_key(),
+        detail::hash_table_key_traits<Key>::deleted_key(),
+        context
+    );
+    table.reserve(count, queue);
+    const size_t groups = table.insert(keys_first, count, queue);
+
+    const size_t buckets = table.bucket_count();
+    vector<T> accumulators(buckets, context);
+    ::boost::compute::fill(
+        accumulators.begin(), accumulators.end(), op::identity(), queue
+    );
+
+    // second pass: aggregate each value into its group's accumulator
+    const size_t local_size = 128;
+    const size_t local_slots = 256;
+
+    detail::meta_kernel k("group_by_aggregate");
+    k.add_function(
+        "group_by_update_global",
+        detail::make_group_by_update_function<T, op>(
+            "group_by_update_global", "__global"
+        )
+    );
+    k.add_function(
+        "group_by_update_local",
+        detail::make_group_by_update_function<T, op>(
+            "group_by_update_local", "__local"
+        )
+    );
+    k.add_set_arg<const uint_>("count", static_cast<uint_>(count));
+    const size_t accumulators_arg =
+        k.add_arg<T *>(memory_object::global_memory, "accumulators");
+
+    k << "__local uint local_slots[" << uint_(local_slots) << "];\n"
+      << "__local " << type_name<T>() << " local_values[" << uint_(local_slots) << "];\n"
+      << "for(uint j = get_local_id(0); j < " << uint_(local_slots) << "; j += get_local_size(0)){\n"
+      << "    local_slots[j] = 0xffffffff;\n"
+      << "    local_values[j] = " << k.lit(op::identity()) << ";\n"
+      << "}\n"
+      << "barrier(CLK_LOCAL_MEM_FENCE);\n"
+      << "const uint i = get_global_id(0);\n"
+      << k.decl<Key>("key") << " = i < count ? "
+      <<     keys_first[k.var<uint_>("i")] << " : table_empty_key;\n";
+    table.emit_find_slot(k);
+    k << "if(slot <= table_mask){\n"
+      << "    " << k.decl<T>("value") << " = " << values_first[k.var<uint_>("i")] << ";\n"
+      << "    uint local_slot = slot & " << uint_(local_slots - 1) << ";\n"
+      << "    int done = 0;\n"
+      << "    for(uint local_probe = 0; local_probe < 8; local_probe++){\n"
+      << "        const uint previous = "
+      <<              BOOST_COMPUTE_DETAIL_ATOMIC_PREFIX "cmpxchg("
+      <<              "&local_slots[local_slot], 0xffffffff, slot);\n"
+      << "        if(previous == 0xffffffff || previous == slot){\n"
+      << "            group_by_update_local(&local_values[local_slot], value);\n"
+      << "            done = 1;\n"
+      << "            break;\n"
+      << "        }\n"
+      << "        local_slot = (local_slot + 1) & " << uint_(local_slots - 1) << ";\n"
+      << "    }\n"
+      << "    if(!done){\n"
+      << "        group_by_update_global(&accumulators[slot], value);\n"
+      << "    }\n"
+      << "}\n"
+      << "barrier(CLK_LOCAL_MEM_FENCE);\n"
+      << "for(uint j = get_local_id(0); j < " << uint_(local_slots) << "; j += get_local_size(0)){\n"
+      << "    const uint s = local_slots[j];\n"
+      << "    if(s != 0xffffffff){\n"
+      << "        group_by_update_global(&accumulators[s], local_values[j]);\n"
+      << "    }\n"
+      << "}\n";
+
+    k.set_arg(accumulators_arg, accumulators.get_buffer());
+
+    const size_t global_size =
+        ((count + local_size - 1) / local_size) * local_size;
+    k.exec_1d(queue, 0, global_size, local_size);
+
+    // write the occupied slots to the output
+    keys_result.resize(groups, queue);
+    values_result.resize(groups, queue);
+
+    const vector<Key> &table_keys = table.keys();
+    vector<uint_> offsets(buckets + 1, context);
+
+    detail::meta_kernel flags_kernel("group_by_aggregate_flags");
+    flags_kernel.add_set_arg<const Key>("empty_key", table.empty_key());
+    flags_kernel.add_set_arg<const Key>("deleted_key", table.deleted_key());
+    flags_kernel <<
+        "const uint j = get_global_id(0);\n" <<
+        flags_kernel.decl<Key>("key") << " = " <<
+            table_keys.begin()[flags_kernel.var<uint_>("j")] << ";\n" <<
+        offsets.begin()[flags_kernel.var<uint_>("j")] <<
+            " = (key != empty_key && key != deleted_key) ? 1 : 0;\n";
+    flags_kernel.exec_1d(queue, 0, buckets);
+    ::boost::compute::fill_n(offsets.end() - 1, 1, uint_(0), queue);
+
+    ::boost::compute::exclusive_scan(
+        offsets.begin(), offsets.end(), offsets.begin(), queue
+    );
+
+    detail::meta_kernel write_kernel("group_by_aggregate_write");
+    write_kernel <<
+        "const uint j = get_global_id(0);\n" <<
+        "const uint dst = " << offsets.begin()[write_kernel.var<uint_>("j")] << ";\n" <<
+        "if(dst != " << offsets.begin()[write_kernel.expr<uint_>("j+1")] << "){\n" <<
+        "    " << keys_result.begin()[write_kernel.var<uint_>("dst")] << " = " <<
+                 table_keys.begin()[write_kernel.var<uint_>("j")] << ";\n" <<
+        "    " << values_result.begin()[write_kernel.var<uint_>("dst")] << " = " <<
+                 accumulators.begin()[write_kernel.var<uint_>("j")] << ";\n" <<
+        "}\n";
+    write_kernel.exec_1d(queue, 0, buckets);
+
+    return groups;
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_GROUP_BY_AGGREGATE_HPP
@@ -0,0 +1,227 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_HASH_JOIN_HPP
+#define BOOST_COMPUTE_ALGORITHM_HASH_JOIN_HPP
+
+#include <iterator>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/fill_n.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/detail/hash_table.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+#include <boost/compute/functional/atomic.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Performs an inner equi-join of the keys in the range
+/// [\p build_first, \p build_last) with the keys in the range
+/// [\p probe_first, \p probe_last). For each pair of matching keys the
+/// index of the build row is stored in \p build_indices and the index of
+/// the probe row in \p probe_indices. Both vectors are resized to the
+/// number of matches, which is returned.
+///
+/// The build keys are inserted into a hash table along with, for each
+/// distinct key, the list of build rows with that key. The probe keys are
+/// then looked up in two passes: the first counts the matches of each
+/// probe row and the second writes the pairs at the offsets given by an
+/// exclusive scan of the counts. The output size is therefore known
+/// before any output is written and never needs to be estimated.
+///
+/// The result is ordered by probe row. The order of the build rows
+/// matching the same probe row is unspecified. The smaller input should
+/// generally be used as the build side.
+///
+/// Keys must be 32-bit integers. The two largest key values are reserved
+/// (see unordered_map) and rows with these keys never match.
+///
+/// For example, to join orders with customers:
+/// \code
+/// vector<uint_> customer_rows(context);
+/// vector<uint_> order_rows(context);
+/// size_t n = hash_join(customer_ids.begin(), customer_ids.end(),
+///                      order_customer_ids.begin(), order_customer_ids.end(),
+///                      customer_rows, order_rows, queue);
+///
+/// // gather the joined columns
+/// vector<float> balances(n, context);
+/// gather(customer_rows.begin(), customer_rows.end(),
+///        customer_balances.begin(), balances.begin(), queue);
+/// \endcode
+///
+/// \see group_by_aggregate(), unordered_map, gather()
+template<class BuildIterator, class ProbeIterator>
+inline size_t hash_join(BuildIterator build_first,
+                        BuildIterator build_last,
+                        ProbeIterator probe_first,
+                        ProbeIterator probe_last,
+                        vector<uint_> &build_indices,
+                        vector<uint_> &probe_indices,
+                        command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<BuildIterator>::value_type key_type;
+
+    const context &context = queue.get_context();
+    const size_t build_count =
+        detail::iterator_range_size(build_first, build_last);
+    const size_t probe_count =
+        detail::iterator_range_size(probe_first, probe_last);
+    if(build_count == 0 || probe_count == 0){
+        build_indices.resize(0, queue);
+        probe_indices.resize(0, queue);
+        return 0;
+    }
+
+    // build phase: insert the distinct build keys into the hash table and
+    // store the build rows grouped by the slot of their key
+    detail::hash_table<key_type, uchar_, false> table(
+        0,
+        detail::hash_table_key_traits<key_type>::empty_key(),
+        detail::hash_table_key_traits<key_type>::deleted_key(),
+        context
+    );
+    table.reserve(build_count, queue);
+    table.insert(build_first, build_count, queue);
+
+    const size_t buckets = table.bucket_count();
+    vector<uint_> offsets(buckets + 1, context);
+    vector<uint_> cursors(buckets + 1, context);
+    vector<uint_> rows(build_count, context);
+    ::boost::compute::fill(offsets.begin(), offsets.end(), uint_(0), queue);
+
+    detail::meta_kernel count_kernel("hash_join_count_rows");
+    const size_t count_offsets_arg =
+        count_kernel.add_arg<uint_ *>(memory_object::global_memory, "offsets");
+    count_kernel <<
+        "const uint i = get_global_id(0);\n" <<
+        count_kernel.decl<key_type>("key") << " = " <<
+            build_first[count_kernel.var<uint_>("i")] << ";\n";
+    table.emit_find_slot(count_kernel);
+    count_kernel <<
+        "if(slot <= table_mask){\n" <<
+        "    " << atomic_inc<uint_>()(count_kernel.expr<uint_ *>("offsets + slot")) << ";\n" <<
+        "}\n";
+    count_kernel.set_arg(count_offsets_arg, offsets.get_buffer());
+    count_kernel.exec_1d(queue, 0, build_count);
+
+    // cursors keep the number of rows per slot for the probe phase
+    ::boost::compute::copy(
+        offsets.begin(), offsets.end(), cursors.begin(), queue
+    );
+    ::boost::compute::exclusive_scan(
+        offsets.begin(), offsets.end(), offsets.begin(), queue
+    );
+
+    detail::meta_kernel rows_kernel("hash_join_fill_rows");
+    const size_t rows_offsets_arg =
+        rows_kernel.add_arg<const uint_ *>(memory_object::global_memory, "offsets");
+    const size_t rows_cursors_arg =
+        rows_kernel.add_arg<uint_ *>(memory_object::global_memory, "cursors");
+    const size_t rows_arg =
+        rows_kernel.add_arg<uint_ *>(memory_object::global_memory, "rows");
+    rows_kernel <<
+        "const uint i = get_global_id(0);\n" <<
+        rows_kernel.decl<key_type>("key") << " = " <<
+            build_first[rows_kernel.var<uint_>("i")] << ";\n";
+    table.emit_find_slot(rows_kernel);
+    rows_kernel <<
+        "if(slot <= table_mask){\n" <<
+        "    const uint n = " <<
+                 atomic_dec<uint_>()(rows_kernel.expr<uint_ *>("cursors + slot")) << ";\n" <<
+        "    rows[offsets[slot] + n - 1] = i;\n" <<
+        "}\n";
+    rows_kernel.set_arg(rows_offsets_arg, offsets.get_buffer());
+    rows_kernel.set_arg(rows_cursors_arg, cursors.get_buffer());
+    rows_kernel.set_arg(rows_arg, rows.get_buffer());
+    rows_kernel.exec_1d(queue, 0, build_count);
+
+    // probe count phase: count the matches for each probe row
+    vector<uint_> matches(probe_count + 1, context);
+
+    detail::meta_kernel match_kernel("hash_join_count_matches");
+    const size_t match_offsets_arg =
+        match_kernel.add_arg<const uint_ *>(memory_object::global_memory, "offsets");
+    const size_t matches_arg =
+        match_kernel.add_arg<uint_ *>(memory_object::global_memory, "matches");
+    match_kernel <<
+        "const uint i = get_global_id(0);\n" <<
+        match_kernel.decl<key_type>("key") << " = " <<
+            probe_first[match_kernel.var<uint_>("i")] << ";\n";
+    table.emit_find_slot(match_kernel);
+    match_kernel <<
+        "matches[i] = slot <= table_mask ? offsets[slot+1] - offsets[slot] : 0;\n";
+    match_kernel.set_arg(match_offsets_arg, offsets.get_buffer());
+    match_kernel.set_arg(matches_arg, matches.get_buffer());
+    match_kernel.exec_1d(queue, 0, probe_count);
+    ::boost::compute::fill_n(matches.end() - 1, 1, uint_(0), queue);
+
+    ::boost::compute::exclusive_scan(
+        matches.begin(), matches.end(), matches.begin(), queue
+    );
+    const size_t total = static_cast<size_t>(
+        detail::read_single_value<uint_>(matches.get_buffer(), probe_count, queue)
+    );
+
+    build_indices.resize(total, queue);
+    probe_indices.resize(total, queue);
+    if(total == 0){
+        return 0;
+    }
+
+    // probe write phase: write the pairs for each probe row
+    detail::meta_kernel write_kernel("hash_join_write");
+    const size_t write_offsets_arg =
+        write_kernel.add_arg<const uint_ *>(memory_object::global_memory, "offsets");
+    const size_t write_matches_arg =
+        write_kernel.add_arg<const uint_ *>(memory_object::global_memory, "matches");
+    const size_t write_rows_arg =
+        write_kernel.add_arg<const uint_ *>(memory_object::global_memory, "rows");
+    const size_t build_indices_arg =
+        write_kernel.add_arg<uint_ *>(memory_object::global_memory, "build_indices");
+    const size_t probe_indices_arg =
+        write_kernel.add_arg<uint_ *>(memory_object::global_memory, "probe_indices");
+    write_kernel <<
+        "const uint i = get_global_id(0);\n" <<
+        "const uint first = matches[i];\n" <<
+        "const uint n = matches[i+1] - first;\n" <<
+        "if(n == 0){\n" <<
+        "    return;\n" <<
+        "}\n" <<
+        write_kernel.decl<key_type>("key") << " = " <<
+            probe_first[write_kernel.var<uint_>("i")] << ";\n";
+    table.emit_find_slot(write_kernel);
+    write_kernel <<
+        "const uint row = offsets[slot];\n" <<
+        "for(uint j = 0; j < n; j++){\n" <<
+        "    build_indices[first + j] = rows[row + j];\n" <<
+        "    probe_indices[first + j] = i;\n" <<
+        "}\n";
+    write_kernel.set_arg(write_offsets_arg, offsets.get_buffer());
+    write_kernel.set_arg(write_matches_arg, matches.get_buffer());
+    write_kernel.set_arg(write_rows_arg, rows.get_buffer());
+    write_kernel.set_arg(build_indices_arg, build_indices.get_buffer());
+    write_kernel.set_arg(probe_indices_arg, probe_indices.get_buffer());
+    write_kernel.exec_1d(queue, 0, probe_count);
+
+    return total;
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_HASH_JOIN_HPP
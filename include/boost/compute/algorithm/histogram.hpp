@@ -0,0 +1,235 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_HISTOGRAM_HPP
+#define BOOST_COMPUTE_ALGORITHM_HISTOGRAM_HPP
+
+#include <iterator>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/histogram.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/iterator/constant_iterator.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Counts the values in the range [\p first, \p last) falling into each
+/// of \p num_bins bins and stores the counts in the range beginning at
+/// \p result. The bin of each value is given by \p bin_function, values
+/// whose bin is not in [\c 0, \p num_bins) are ignored.
+///
+/// On GPUs each work-group counts into a sub-histogram in local memory
+/// which is then added to the result with atomics, so contention on
+/// popular bins stays within the work-group. On CPU devices each thread
+/// counts a contiguous block into a private histogram and the private
+/// histograms are summed without atomics.
+///
+/// The bins (\p result) must be a buffer iterator of \c uint_ or \c int_.
+///
+/// For example, to count values by their last decimal digit:
+/// \code
+/// BOOST_COMPUTE_FUNCTION(uint_, last_digit, (int x),
+/// {
+///     return x % 10;
+/// });
+///
+/// histogram(values.begin(), values.end(), bins.begin(), 10, last_digit, queue);
+/// \endcode
+///
+/// \see histogram_even(), histogram_range(), weighted_histogram()
+template<class InputIterator, class BinIterator, class Function>
+inline void histogram(InputIterator first,
+                      InputIterator last,
+                      BinIterator result,
+                      size_t num_bins,
+                      Function bin_function,
+                      command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<BinIterator>::value_type R;
+
+    detail::dispatch_histogram(
+        first, last, make_constant_iterator(R(1)), result, num_bins,
+        detail::histogram_function_binner<Function>(bin_function), queue
+    );
+}
+
+/// Counts the occurrences of each integer key in [\c 0, \p num_bins) in
+/// the range [\p first, \p last). Other keys are ignored.
+template<class InputIterator, class BinIterator>
+inline void histogram(InputIterator first,
+                      InputIterator last,
+                      BinIterator result,
+                      size_t num_bins,
+                      command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<BinIterator>::value_type R;
+
+    detail::dispatch_histogram(
+        first, last, make_constant_iterator(R(1)), result, num_bins,
+        detail::histogram_key_binner(), queue
+    );
+}
+
+/// Counts the values in the range [\p first, \p last) falling into each
+/// of \p num_bins bins of equal width dividing [\p lower, \p upper).
+/// Values outside of [\p lower, \p upper) are ignored.
+///
+/// Bins are computed in single precision.
+///
+/// For example, to build a latency distribution with 1ms buckets:
+/// \code
+/// histogram_even(latencies.begin(), latencies.end(), bins.begin(),
+///                100, 0.0f, 100.0f, queue);
+/// \endcode
+template<class InputIterator, class BinIterator>
+inline void histogram_even(InputIterator first,
+                           InputIterator last,
+                           BinIterator result,
+                           size_t num_bins,
+                           float lower,
+                           float upper,
+                           command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<BinIterator>::value_type R;
+
+    detail::dispatch_histogram(
+        first, last, make_constant_iterator(R(1)), result, num_bins,
+        detail::histogram_even_binner(lower, upper, static_cast<uint_>(num_bins)),
+        queue
+    );
+}
+
+/// Counts the values in the range [\p first, \p last) falling into each
+/// of the bins delimited by the sorted edges in the range
+/// [\p edges_first, \p edges_last). Bin \c i counts the values in
+/// [\c edges[i], \c edges[i+1]) and values outside of the edges are
+/// ignored. The number of bins is one less than the number of edges.
+///
+/// This allows bins of varying widths, for example logarithmic buckets.
+template<class InputIterator, class BinIterator, class EdgeIterator>
+inline void histogram_range(InputIterator first,
+                            InputIterator last,
+                            BinIterator result,
+                            EdgeIterator edges_first,
+                            EdgeIterator edges_last,
+                            command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<BinIterator>::value_type R;
+
+    const size_t edges = detail::iterator_range_size(edges_first, edges_last);
+    if(edges < 2){
+        return;
+    }
+
+    detail::dispatch_histogram(
+        first, last, make_constant_iterator(R(1)), result, edges - 1,
+        detail::histogram_range_binner<EdgeIterator>(edges_first), queue
+    );
+}
+
+/// Adds the weight of each value in the range [\p first, \p last) (given
+/// by the range beginning at \p weights_first) to its bin, as given by
+/// \p bin_function, and stores the sums in the range beginning at
+/// \p result.
+///
+/// The bins (\p result) must be a buffer iterator of \c float_, \c int_
+/// or \c uint_. Floating-point bins are accumulated with atomic
+/// compare-and-swap loops so the order (and rounding) of the additions is
+/// unspecified.
+///
+/// \see histogram()
+template<class InputIterator,
+         class WeightIterator,
+         class BinIterator,
+         class Function>
+inline void weighted_histogram(InputIterator first,
+                               InputIterator last,
+                               WeightIterator weights_first,
+                               BinIterator result,
+                               size_t num_bins,
+                               Function bin_function,
+                               command_queue &queue = system::default_queue())
+{
+    detail::dispatch_histogram(
+        first, last, weights_first, result, num_bins,
+        detail::histogram_function_binner<Function>(bin_function), queue
+    );
+}
+
+/// \overload
+template<class InputIterator, class WeightIterator, class BinIterator>
+inline void weighted_histogram(InputIterator first,
+                               InputIterator last,
+                               WeightIterator weights_first,
+                               BinIterator result,
+                               size_t num_bins,
+                               command_queue &queue = system::default_queue())
+{
+    detail::dispatch_histogram(
+        first, last, weights_first, result, num_bins,
+        detail::histogram_key_binner(), queue
+    );
+}
+
+/// Adds the weight of each value in the range [\p first, \p last) to the
+/// bin of equal width dividing [\p lower, \p upper) the value falls into.
+///
+/// \see histogram_even(), weighted_histogram()
+template<class InputIterator, class WeightIterator, class BinIterator>
+inline void weighted_histogram_even(InputIterator first,
+                                    InputIterator last,
+                                    WeightIterator weights_first,
+                                    BinIterator result,
+                                    size_t num_bins,
+                                    float lower,
+                                    float upper,
+                                    command_queue &queue = system::default_queue())
+{
+    detail::dispatch_histogram(
+        first, last, weights_first, result, num_bins,
+        detail::histogram_even_binner(lower, upper, static_cast<uint_>(num_bins)),
+        queue
+    );
+}
+
+/// Adds the weight of each value in the range [\p first, \p last) to the
+/// bin delimited by the sorted edges in [\p edges_first, \p edges_last)
+/// the value falls into.
+///
+/// \see histogram_range(), weighted_histogram()
+template<class InputIterator,
+         class WeightIterator,
+         class BinIterator,
+         class EdgeIterator>
+inline void weighted_histogram_range(InputIterator first,
+                                     InputIterator last,
+                                     WeightIterator weights_first,
+                                     BinIterator result,
+                                     EdgeIterator edges_first,
+                                     EdgeIterator edges_last,
+                                     command_queue &queue = system::default_queue())
+{
+    const size_t edges = detail::iterator_range_size(edges_first, edges_last);
+    if(edges < 2){
+        return;
+    }
+
+    detail::dispatch_histogram(
+        first, last, weights_first, result, edges - 1,
+        detail::histogram_range_binner<EdgeIterator>(edges_first), queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_HISTOGRAM_HPP
@@ -15,6 +15,8 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/detail/binary_find.hpp>
+#include <boost/compute/algorithm/detail/batched_binary_search.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
 namespace compute {
@@ -38,6 +40,60 @@ lower_bound(InputIterator first,
     return position;
 }
 
+/// Stores in the range beginning at \p result, for each value in the range
+/// [\p values_first, \p values_last), the index of the first element in
+/// the sorted range [\p first, \p last) that is not less than the value.
+/// Returns an iterator to the end of the results.
+///
+/// All of the values are searched for with a single kernel in which each
+/// work-item performs one binary search. For large ranges the top levels
+/// of the search are cached in local memory. If the values are themselves
+/// sorted, pass \c true for \p values_sorted so that consecutive searches
+/// start from the previous result as in a merge, which is considerably
+/// faster.
+///
+/// For example, to find the position of each of many ids in a sorted
+/// table:
+/// \code
+/// vector<uint_> positions(ids.size(), context);
+/// lower_bound(table.begin(), table.end(), ids.begin(), ids.end(),
+///             positions.begin(), queue);
+/// \endcode
+///
+/// \see upper_bound(), equal_range()
+template<class InputIterator, class ValueIterator, class OutputIterator>
+inline OutputIterator
+lower_bound(InputIterator first,
+            InputIterator last,
+            ValueIterator values_first,
+            ValueIterator values_last,
+            OutputIterator result,
+            bool values_sorted,
+            command_queue &queue = system::default_queue())
+{
+    detail::dispatch_batched_search(
+        first, last, values_first, values_last, result,
+        detail::batched_lower_bound, values_sorted, queue
+    );
+
+    return result + detail::iterator_range_size(values_first, values_last);
+}
+
+/// \overload
+template<class InputIterator, class ValueIterator, class OutputIterator>
+inline OutputIterator
+lower_bound(InputIterator first,
+            InputIterator last,
+            ValueIterator values_first,
+            ValueIterator values_last,
+            OutputIterator result,
+            command_queue &queue = system::default_queue())
+{
+    return ::boost::compute::lower_bound(
+        first, last, values_first, values_last, result, false, queue
+    );
+}
+
 } // end compute namespace
 } // end boost namespace
 
@@ -12,20 +12,75 @@
 #define BOOST_COMPUTE_ALGORITHM_MINMAX_ELEMENT_HPP
 
 #include <utility>
+#include <iterator>
+
+#include <boost/tuple/tuple.hpp>
+#include <boost/type_traits/remove_cv.hpp>
 
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/max_element.hpp>
 #include <boost/compute/algorithm/min_element.hpp>
+#include <boost/compute/algorithm/multi_reduce.hpp>
 
 namespace boost {
 namespace compute {
+namespace detail {
+
+// finds both extrema in a single pass over the input
+template<class InputIterator>
+inline std::pair<InputIterator, InputIterator>
+dispatch_minmax_element(InputIterator first,
+                        InputIterator last,
+                        command_queue &queue,
+                        boost::true_type)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    boost::tuple<uint_, uint_> indices = multi_reduce(
+        first,
+        last,
+        boost::make_tuple(argmin_reducer<value_type>(),
+                          argmax_reducer<value_type>()),
+        queue
+    );
+
+    // the indices are only unset if every value is NaN
+    uint_ min_index = boost::get<0>(indices);
+    uint_ max_index = boost::get<1>(indices);
+    if(min_index == uint_(-1)){
+        min_index = 0;
+    }
+    if(max_index == uint_(-1)){
+        max_index = 0;
+    }
+
+    return std::make_pair(first + min_index, first + max_index);
+}
+
+// other types fall back to a pass per extremum
+template<class InputIterator>
+inline std::pair<InputIterator, InputIterator>
+dispatch_minmax_element(InputIterator first,
+                        InputIterator last,
+                        command_queue &queue,
+                        boost::false_type)
+{
+    return std::make_pair(min_element(first, last, queue),
+                          max_element(first, last, queue));
+}
+
+} // end detail namespace
 
 /// Returns a pair of iterators with the first pointing to the minimum
 /// element and the second pointing to the maximum element in the range
-/// [\p first, \p last).
+/// [\p first, \p last). If there are several equal extrema the first of
+/// each is returned.
+///
+/// For the OpenCL scalar types both extrema are found in a single pass
+/// over the range.
 ///
-/// \see max_element(), min_element()
+/// \see max_element(), min_element(), multi_reduce()
 template<class InputIterator>
 inline std::pair<InputIterator, InputIterator>
 minmax_element(InputIterator first,
@@ -37,8 +92,16 @@ minmax_element(InputIterator first,
         return std::make_pair(first, first);
     }
 
-    return std::make_pair(min_element(first, last, queue),
-                          max_element(first, last, queue));
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    return detail::dispatch_minmax_element(
+        first,
+        last,
+        queue,
+        typename detail::has_multi_reduce_limits<
+            typename boost::remove_cv<value_type>::type
+        >::type()
+    );
 }
 
 } // end compute namespace
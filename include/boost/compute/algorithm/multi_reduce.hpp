@@ -0,0 +1,858 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_MULTI_REDUCE_HPP
+#define BOOST_COMPUTE_ALGORITHM_MULTI_REDUCE_HPP
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+
+#include <boost/tuple/tuple.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// the smallest and largest values of a type as opencl c expressions
+template<class T> struct multi_reduce_limits;
+
+// true if multi_reduce_limits is specialized for T
+template<class T>
+struct has_multi_reduce_limits : public boost::false_type {};
+
+#define BOOST_COMPUTE_DETAIL_DECLARE_MULTI_REDUCE_LIMITS(type, low, high) \
+    template<> \
+    struct multi_reduce_limits<type> \
+    { \
+        static const char* lowest() { return low; } \
+        static const char* highest() { return high; } \
+    }; \
+    template<> \
+    struct has_multi_reduce_limits<type> : public boost::true_type {};
+
+BOOST_COMPUTE_DETAIL_DECLARE_MULTI_REDUCE_LIMITS(char_, "CHAR_MIN", "CHAR_MAX")
+BOOST_COMPUTE_DETAIL_DECLARE_MULTI_REDUCE_LIMITS(uchar_, "0", "UCHAR_MAX")
+BOOST_COMPUTE_DETAIL_DECLARE_MULTI_REDUCE_LIMITS(short_, "SHRT_MIN", "SHRT_MAX")
+BOOST_COMPUTE_DETAIL_DECLARE_MULTI_REDUCE_LIMITS(ushort_, "0", "USHRT_MAX")
+BOOST_COMPUTE_DETAIL_DECLARE_MULTI_REDUCE_LIMITS(int_, "INT_MIN", "INT_MAX")
+BOOST_COMPUTE_DETAIL_DECLARE_MULTI_REDUCE_LIMITS(uint_, "0", "UINT_MAX")
+BOOST_COMPUTE_DETAIL_DECLARE_MULTI_REDUCE_LIMITS(long_, "LONG_MIN", "LONG_MAX")
+BOOST_COMPUTE_DETAIL_DECLARE_MULTI_REDUCE_LIMITS(ulong_, "0", "ULONG_MAX")
+BOOST_COMPUTE_DETAIL_DECLARE_MULTI_REDUCE_LIMITS(float_, "-INFINITY", "INFINITY")
+BOOST_COMPUTE_DETAIL_DECLARE_MULTI_REDUCE_LIMITS(double_, "-INFINITY", "INFINITY")
+
+#undef BOOST_COMPUTE_DETAIL_DECLARE_MULTI_REDUCE_LIMITS
+
+// type name and size of a field in a reducer's accumulator
+typedef std::pair<std::string, size_t> multi_reduce_field;
+
+template<class T>
+inline void push_multi_reduce_field(std::vector<multi_reduce_field> &fields)
+{
+    fields.push_back(multi_reduce_field(type_name<T>(), sizeof(T)));
+}
+
+template<class T>
+inline std::string multi_reduce_cast(const std::string &value)
+{
+    return std::string("((") + type_name<T>() + ")(" + value + "))";
+}
+
+// shared implementation of argmin_reducer and argmax_reducer. ties are
+// resolved towards the smaller index so that the result does not depend
+// on how the range is split between work-items
+template<class T>
+inline std::string argext_update(const std::string &a,
+                                 const std::string &value,
+                                 const std::string &index,
+                                 char op)
+{
+    std::stringstream s;
+    s << "if(" << value << " " << op << " " << a << "0 || "
+      << "(" << value << " == " << a << "0 && " << index << " < " << a << "1)){\n"
+      << "    " << a << "0 = " << value << ";\n"
+      << "    " << a << "1 = " << index << ";\n"
+      << "}\n";
+    return s.str();
+}
+
+} // end detail namespace
+
+/// \class min_reducer
+/// \brief Computes the smallest value in a range with multi_reduce().
+///
+/// Reducers describe one statistic of a multi_reduce() call. Each reducer
+/// provides the fields of its accumulator along with the OpenCL code to
+/// initialize, update and merge them. Accumulator fields are accessed by
+/// appending the field's index to the prefix passed to the code generating
+/// functions (e.g. \c "acc.r0_" followed by \c "0").
+///
+/// The result for an empty range is the largest value of \c T.
+///
+/// \see multi_reduce()
+template<class T>
+class min_reducer
+{
+public:
+    typedef T result_type;
+
+    void fields(std::vector<detail::multi_reduce_field> &fields) const
+    {
+        detail::push_multi_reduce_field<T>(fields);
+    }
+
+    std::string init(const std::string &a) const
+    {
+        return a + "0 = " + detail::multi_reduce_limits<T>::highest() + ";\n";
+    }
+
+    std::string update(const std::string &a,
+                       const std::string &value,
+                       const std::string &index) const
+    {
+        (void) index;
+
+        return a + "0 = min(" + a + "0, " +
+               detail::multi_reduce_cast<T>(value) + ");\n";
+    }
+
+    std::string merge(const std::string &a, const std::string &b) const
+    {
+        return a + "0 = min(" + a + "0, " + b + "0);\n";
+    }
+
+    std::string result(const std::string &a) const
+    {
+        return a + "0";
+    }
+};
+
+/// \class max_reducer
+/// \brief Computes the largest value in a range with multi_reduce().
+///
+/// The result for an empty range is the smallest value of \c T.
+///
+/// \see min_reducer, multi_reduce()
+template<class T>
+class max_reducer
+{
+public:
+    typedef T result_type;
+
+    void fields(std::vector<detail::multi_reduce_field> &fields) const
+    {
+        detail::push_multi_reduce_field<T>(fields);
+    }
+
+    std::string init(const std::string &a) const
+    {
+        return a + "0 = " + detail::multi_reduce_limits<T>::lowest() + ";\n";
+    }
+
+    std::string update(const std::string &a,
+                       const std::string &value,
+                       const std::string &index) const
+    {
+        (void) index;
+
+        return a + "0 = max(" + a + "0, " +
+               detail::multi_reduce_cast<T>(value) + ");\n";
+    }
+
+    std::string merge(const std::string &a, const std::string &b) const
+    {
+        return a + "0 = max(" + a + "0, " + b + "0);\n";
+    }
+
+    std::string result(const std::string &a) const
+    {
+        return a + "0";
+    }
+};
+
+/// \class sum_reducer
+/// \brief Computes the sum of the values in a range with multi_reduce().
+///
+/// Values are converted to \c T before being added, so a wider type can
+/// be used to avoid overflow (e.g. \c sum_reducer<ulong_> over \c uint_
+/// values).
+///
+/// \see min_reducer, multi_reduce()
+template<class T>
+class sum_reducer
+{
+public:
+    typedef T result_type;
+
+    void fields(std::vector<detail::multi_reduce_field> &fields) const
+    {
+        detail::push_multi_reduce_field<T>(fields);
+    }
+
+    std::string init(const std::string &a) const
+    {
+        return a + "0 = 0;\n";
+    }
+
+    std::string update(const std::string &a,
+                       const std::string &value,
+                       const std::string &index) const
+    {
+        (void) index;
+
+        return a + "0 += " + detail::multi_reduce_cast<T>(value) + ";\n";
+    }
+
+    std::string merge(const std::string &a, const std::string &b) const
+    {
+        return a + "0 += " + b + "0;\n";
+    }
+
+    std::string result(const std::string &a) const
+    {
+        return a + "0";
+    }
+};
+
+/// \class sum_of_squares_reducer
+/// \brief Computes the sum of the squares of the values in a range with
+///        multi_reduce().
+///
+/// \see sum_reducer, multi_reduce()
+template<class T>
+class sum_of_squares_reducer
+{
+public:
+    typedef T result_type;
+
+    void fields(std::vector<detail::multi_reduce_field> &fields) const
+    {
+        detail::push_multi_reduce_field<T>(fields);
+    }
+
+    std::string init(const std::string &a) const
+    {
+        return a + "0 = 0;\n";
+    }
+
+    std::string update(const std::string &a,
+                       const std::string &value,
+                       const std::string &index) const
+    {
+        (void) index;
+
+        const std::string x = detail::multi_reduce_cast<T>(value);
+        return a + "0 += " + x + " * " + x + ";\n";
+    }
+
+    std::string merge(const std::string &a, const std::string &b) const
+    {
+        return a + "0 += " + b + "0;\n";
+    }
+
+    std::string result(const std::string &a) const
+    {
+        return a + "0";
+    }
+};
+
+/// \class count_reducer
+/// \brief Counts the values in a range with multi_reduce().
+///
+/// \see multi_reduce()
+class count_reducer
+{
+public:
+    typedef ulong_ result_type;
+
+    void fields(std::vector<detail::multi_reduce_field> &fields) const
+    {
+        detail::push_multi_reduce_field<ulong_>(fields);
+    }
+
+    std::string init(const std::string &a) const
+    {
+        return a + "0 = 0;\n";
+    }
+
+    std::string update(const std::string &a,
+                       const std::string &value,
+                       const std::string &index) const
+    {
+        (void) value;
+        (void) index;
+
+        return a + "0++;\n";
+    }
+
+    std::string merge(const std::string &a, const std::string &b) const
+    {
+        return a + "0 += " + b + "0;\n";
+    }
+
+    std::string result(const std::string &a) const
+    {
+        return a + "0";
+    }
+};
+
+/// \class mean_reducer
+/// \brief Computes the arithmetic mean of the values in a range with
+///        multi_reduce().
+///
+/// \c T must be a floating-point type. The result for an empty range is
+/// \c NaN.
+///
+/// \see variance_reducer, multi_reduce()
+template<class T>
+class mean_reducer
+{
+public:
+    typedef T result_type;
+
+    void fields(std::vector<detail::multi_reduce_field> &fields) const
+    {
+        detail::push_multi_reduce_field<T>(fields);
+        detail::push_multi_reduce_field<ulong_>(fields);
+    }
+
+    std::string init(const std::string &a) const
+    {
+        return a + "0 = 0;\n" + a + "1 = 0;\n";
+    }
+
+    std::string update(const std::string &a,
+                       const std::string &value,
+                       const std::string &index) const
+    {
+        (void) index;
+
+        return a + "0 += " + detail::multi_reduce_cast<T>(value) + ";\n" +
+               a + "1++;\n";
+    }
+
+    std::string merge(const std::string &a, const std::string &b) const
+    {
+        return a + "0 += " + b + "0;\n" + a + "1 += " + b + "1;\n";
+    }
+
+    std::string result(const std::string &a) const
+    {
+        return a + "0 / " + detail::multi_reduce_cast<T>(a + "1");
+    }
+};
+
+/// \class variance_reducer
+/// \brief Computes the population variance of the values in a range with
+///        multi_reduce().
+///
+/// The variance is accumulated with Welford's update and merged with
+/// Chan's parallel formula which, unlike deriving it from the sum and
+/// the sum of squares, does not lose precision when the mean is large
+/// compared to the spread of the values.
+///
+/// \c T must be a floating-point type. The result for an empty range is
+/// \c NaN.
+///
+/// \see mean_reducer, multi_reduce()
+template<class T>
+class variance_reducer
+{
+public:
+    typedef T result_type;
+
+    void fields(std::vector<detail::multi_reduce_field> &fields) const
+    {
+        // mean, sum of squared differences from the mean, count
+        detail::push_multi_reduce_field<T>(fields);
+        detail::push_multi_reduce_field<T>(fields);
+        detail::push_multi_reduce_field<ulong_>(fields);
+    }
+
+    std::string init(const std::string &a) const
+    {
+        return a + "0 = 0;\n" + a + "1 = 0;\n" + a + "2 = 0;\n";
+    }
+
+    std::string update(const std::string &a,
+                       const std::string &value,
+                       const std::string &index) const
+    {
+        (void) index;
+
+        const std::string t = type_name<T>();
+        std::stringstream s;
+        s << "{\n"
+          << "    const " << t << " x = " << detail::multi_reduce_cast<T>(value) << ";\n"
+          << "    const " << t << " d = x - " << a << "0;\n"
+          << "    " << a << "2++;\n"
+          << "    " << a << "0 += d / " << detail::multi_reduce_cast<T>(a + "2") << ";\n"
+          << "    " << a << "1 += d * (x - " << a << "0);\n"
+          << "}\n";
+        return s.str();
+    }
+
+    std::string merge(const std::string &a, const std::string &b) const
+    {
+        const std::string t = type_name<T>();
+        std::stringstream s;
+        s << "if(" << a << "2 == 0){\n"
+          << "    " << a << "0 = " << b << "0;\n"
+          << "    " << a << "1 = " << b << "1;\n"
+          << "    " << a << "2 = " << b << "2;\n"
+          << "}\n"
+          << "else if(" << b << "2 != 0){\n"
+          << "    const " << t << " na = " << detail::multi_reduce_cast<T>(a + "2") << ";\n"
+          << "    const " << t << " nb = " << detail::multi_reduce_cast<T>(b + "2") << ";\n"
+          << "    const " << t << " n = na + nb;\n"
+          << "    const " << t << " d = " << b << "0 - " << a << "0;\n"
+          << "    " << a << "0 += d * (nb / n);\n"
+          << "    " << a << "1 += " << b << "1 + d * d * (na * nb / n);\n"
+          << "    " << a << "2 += " << b << "2;\n"
+          << "}\n";
+        return s.str();
+    }
+
+    std::string result(const std::string &a) const
+    {
+        return a + "1 / " + detail::multi_reduce_cast<T>(a + "2");
+    }
+};
+
+/// \class argmin_reducer
+/// \brief Computes the index of the smallest value in a range with
+///        multi_reduce().
+///
+/// If the smallest value occurs more than once the index of the first
+/// occurrence is returned. The result for an empty range is the largest
+/// value of \c uint_.
+///
+/// \see argmax_reducer, multi_reduce()
+template<class T>
+class argmin_reducer
+{
+public:
+    typedef uint_ result_type;
+
+    void fields(std::vector<detail::multi_reduce_field> &fields) const
+    {
+        detail::push_multi_reduce_field<T>(fields);
+        detail::push_multi_reduce_field<uint_>(fields);
+    }
+
+    std::string init(const std::string &a) const
+    {
+        return a + "0 = " + detail::multi_reduce_limits<T>::highest() + ";\n" +
+               a + "1 = UINT_MAX;\n";
+    }
+
+    std::string update(const std::string &a,
+                       const std::string &value,
+                       const std::string &index) const
+    {
+        return detail::argext_update<T>(
+            a, detail::multi_reduce_cast<T>(value), index, '<'
+        );
+    }
+
+    std::string merge(const std::string &a, const std::string &b) const
+    {
+        return detail::argext_update<T>(a, b + "0", b + "1", '<');
+    }
+
+    std::string result(const std::string &a) const
+    {
+        return a + "1";
+    }
+};
+
+/// \class argmax_reducer
+/// \brief Computes the index of the largest value in a range with
+///        multi_reduce().
+///
+/// Ties and empty ranges are handled as with argmin_reducer.
+///
+/// \see argmin_reducer, multi_reduce()
+template<class T>
+class argmax_reducer
+{
+public:
+    typedef uint_ result_type;
+
+    void fields(std::vector<detail::multi_reduce_field> &fields) const
+    {
+        detail::push_multi_reduce_field<T>(fields);
+        detail::push_multi_reduce_field<uint_>(fields);
+    }
+
+    std::string init(const std::string &a) const
+    {
+        return a + "0 = " + detail::multi_reduce_limits<T>::lowest() + ";\n" +
+               a + "1 = UINT_MAX;\n";
+    }
+
+    std::string update(const std::string &a,
+                       const std::string &value,
+                       const std::string &index) const
+    {
+        return detail::argext_update<T>(
+            a, detail::multi_reduce_cast<T>(value), index, '>'
+        );
+    }
+
+    std::string merge(const std::string &a, const std::string &b) const
+    {
+        return detail::argext_update<T>(a, b + "0", b + "1", '>');
+    }
+
+    std::string result(const std::string &a) const
+    {
+        return a + "1";
+    }
+};
+
+namespace detail {
+
+// maps a cons list of reducers to a cons list of their result types
+template<class Reducers>
+struct multi_reduce_result;
+
+template<>
+struct multi_reduce_result<boost::tuples::null_type>
+{
+    typedef boost::tuples::null_type type;
+};
+
+template<class Head, class Tail>
+struct multi_reduce_result<boost::tuples::cons<Head, Tail> >
+{
+    typedef boost::tuples::cons<
+        typename Head::result_type,
+        typename multi_reduce_result<Tail>::type
+    > type;
+};
+
+// returns the prefix of the fields of reducer index accessed through acc
+inline std::string multi_reduce_prefix(const std::string &acc, size_t index)
+{
+    std::stringstream s;
+    s << acc << "r" << index << "_";
+    return s.str();
+}
+
+inline size_t multi_reduce_align(size_t offset, size_t alignment)
+{
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+// generates the accumulator struct along with the init, update, merge and
+// result code for every reducer in a cons list
+struct multi_reduce_codegen
+{
+    multi_reduce_codegen()
+        : uses_double(false),
+          struct_size(0),
+          struct_alignment(1),
+          result_size(0)
+    {
+    }
+
+    void visit(const boost::tuples::null_type&, size_t)
+    {
+        // round the struct size up to its alignment, as the device does
+        struct_size = multi_reduce_align(struct_size, struct_alignment);
+        result_size = multi_reduce_align(result_size, sizeof(ulong_));
+    }
+
+    template<class Head, class Tail>
+    void visit(const boost::tuples::cons<Head, Tail> &reducers, size_t index)
+    {
+        const Head &reducer = reducers.get_head();
+
+        std::vector<multi_reduce_field> fields;
+        reducer.fields(fields);
+        for(size_t i = 0; i < fields.size(); i++){
+            declaration << "    " << fields[i].first << " r" << index << "_" << i << ";\n";
+
+            struct_size = multi_reduce_align(struct_size, fields[i].second);
+            struct_size += fields[i].second;
+            struct_alignment = (std::max)(struct_alignment, fields[i].second);
+            uses_double = uses_double || fields[i].first == type_name<double_>();
+        }
+
+        const std::string a = multi_reduce_prefix("a->", index);
+        const std::string b = multi_reduce_prefix("b->", index);
+
+        init << reducer.init(a);
+        update << reducer.update(multi_reduce_prefix("acc.", index), "value", "index");
+        merge << reducer.merge(a, b);
+
+        // results are packed at their natural alignment
+        typedef typename Head::result_type result_type;
+        result_size = multi_reduce_align(result_size, sizeof(result_type));
+        result << "*((__global " << type_name<result_type>() << " *)"
+               << "(result + " << result_size << ")) = "
+               << reducer.result(a) << ";\n";
+        result_offsets.push_back(result_size);
+        result_size += sizeof(result_type);
+
+        visit(reducers.get_tail(), index + 1);
+    }
+
+    void add_to(meta_kernel &k) const
+    {
+        if(uses_double){
+            k.inject_type<double_>();
+        }
+
+        k.add_function("multi_reduce_acc", source());
+    }
+
+    std::string source() const
+    {
+        std::stringstream s;
+        s << "typedef struct {\n"
+          << declaration.str()
+          << "} multi_reduce_acc;\n"
+          << "inline void multi_reduce_init(multi_reduce_acc *a)\n"
+          << "{\n" << init.str() << "}\n"
+          << "inline void multi_reduce_merge(multi_reduce_acc *a, "
+          << "const multi_reduce_acc *b)\n"
+          << "{\n" << merge.str() << "}\n"
+          << "inline void multi_reduce_write(const multi_reduce_acc *a, "
+          << "__global uchar *result)\n"
+          << "{\n" << result.str() << "}\n";
+        return s.str();
+    }
+
+    std::stringstream declaration;
+    std::stringstream init;
+    std::stringstream update;
+    std::stringstream merge;
+    std::stringstream result;
+    std::vector<size_t> result_offsets;
+    bool uses_double;
+    size_t struct_size;
+    size_t struct_alignment;
+    size_t result_size;
+};
+
+// unpacks the results of the reducers from the bytes read back from the
+// device
+inline boost::tuples::null_type
+multi_reduce_unpack(const boost::tuples::null_type&,
+                    const std::vector<char>&,
+                    const std::vector<size_t>&,
+                    size_t)
+{
+    return boost::tuples::null_type();
+}
+
+template<class Head, class Tail>
+inline typename multi_reduce_result<boost::tuples::cons<Head, Tail> >::type
+multi_reduce_unpack(const boost::tuples::cons<Head, Tail> &reducers,
+                    const std::vector<char> &bytes,
+                    const std::vector<size_t> &offsets,
+                    size_t index)
+{
+    typedef typename Head::result_type result_type;
+    typedef typename multi_reduce_result<boost::tuples::cons<Head, Tail> >::type
+        cons_type;
+
+    result_type value;
+    std::copy(&bytes[offsets[index]],
+              &bytes[offsets[index]] + sizeof(result_type),
+              reinterpret_cast<char *>(&value));
+
+    return cons_type(
+        value,
+        multi_reduce_unpack(reducers.get_tail(), bytes, offsets, index + 1)
+    );
+}
+
+// work-items per group for both reduction kernels, must be a power of two
+static const size_t multi_reduce_local_size = 128;
+
+// emits the reduction of the private accumulators of a work-group into
+// local memory. leaves the result in scratch[0]
+inline void emit_multi_reduce_local(meta_kernel &k)
+{
+    k <<
+        "scratch[lid] = acc;\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "for(uint s = get_local_size(0) / 2; s > 0; s >>= 1){\n" <<
+        "    if(lid < s){\n" <<
+        "        multi_reduce_acc a = scratch[lid];\n" <<
+        "        const multi_reduce_acc b = scratch[lid + s];\n" <<
+        "        multi_reduce_merge(&a, &b);\n" <<
+        "        scratch[lid] = a;\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "}\n";
+}
+
+template<class InputIterator, class Reducers>
+inline typename multi_reduce_result<Reducers>::type
+dispatch_multi_reduce(InputIterator first,
+                      InputIterator last,
+                      const Reducers &reducers,
+                      command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    const context &context = queue.get_context();
+    const device &device = queue.get_device();
+    const size_t count = detail::iterator_range_size(first, last);
+    const size_t local_size = multi_reduce_local_size;
+
+    multi_reduce_codegen codegen;
+    codegen.visit(reducers, 0);
+
+    // one accumulator per work-group, or a single group for small ranges
+    size_t groups = (count + local_size - 1) / local_size;
+    groups = (std::min)(groups, size_t(device.compute_units()) * 4);
+    groups = (std::max)(groups, size_t(1));
+
+    buffer result_buffer(context, codegen.result_size);
+
+    // reduce the range into per-group partial accumulators, or straight
+    // into the results if the range fits in a single work-group
+    meta_kernel k1("multi_reduce");
+    codegen.add_to(k1);
+    size_t count_arg = k1.add_arg<const uint_>("count");
+    size_t partials_arg =
+        k1.add_arg<uchar_ *>(memory_object::global_memory, "partials");
+    size_t result_arg =
+        k1.add_arg<uchar_ *>(memory_object::global_memory, "result");
+    k1 <<
+        "__local multi_reduce_acc scratch[" << uint_(local_size) << "];\n" <<
+        "const uint lid = get_local_id(0);\n" <<
+        "multi_reduce_acc acc;\n" <<
+        "multi_reduce_init(&acc);\n" <<
+        "for(uint index = get_global_id(0); index < count; " <<
+        "index += get_global_size(0)){\n" <<
+        "    const " << type_name<value_type>() << " value = " <<
+            first[k1.var<uint_>("index")] << ";\n" <<
+        codegen.update.str() <<
+        "}\n";
+    emit_multi_reduce_local(k1);
+    k1 <<
+        "if(lid == 0){\n";
+    if(groups == 1){
+        k1 << "    const multi_reduce_acc r = scratch[0];\n" <<
+              "    multi_reduce_write(&r, result);\n";
+    }
+    else {
+        k1 << "    ((__global multi_reduce_acc *) partials)[get_group_id(0)] = scratch[0];\n";
+    }
+    k1 << "}\n";
+
+    buffer partials(context, (std::max)(groups * codegen.struct_size, size_t(1)));
+
+    kernel kernel1 = k1.compile(context);
+    kernel1.set_arg(count_arg, uint_(count));
+    kernel1.set_arg(partials_arg, partials);
+    kernel1.set_arg(result_arg, result_buffer);
+    queue.enqueue_1d_range_kernel(kernel1, 0, groups * local_size, local_size);
+
+    if(groups > 1){
+        // merge the partial accumulators with a single work-group
+        meta_kernel k2("multi_reduce_partials");
+        codegen.add_to(k2);
+        size_t k2_count_arg = k2.add_arg<const uint_>("count");
+        size_t k2_partials_arg =
+            k2.add_arg<uchar_ *>(memory_object::global_memory, "partials");
+        size_t k2_result_arg =
+            k2.add_arg<uchar_ *>(memory_object::global_memory, "result");
+        k2 <<
+            "__local multi_reduce_acc scratch[" << uint_(local_size) << "];\n" <<
+            "const uint lid = get_local_id(0);\n" <<
+            "multi_reduce_acc acc;\n" <<
+            "multi_reduce_init(&acc);\n" <<
+            "for(uint i = lid; i < count; i += get_local_size(0)){\n" <<
+            "    const multi_reduce_acc b = " <<
+                "((__global const multi_reduce_acc *) partials)[i];\n" <<
+            "    multi_reduce_merge(&acc, &b);\n" <<
+            "}\n";
+        emit_multi_reduce_local(k2);
+        k2 <<
+            "if(lid == 0){\n" <<
+            "    const multi_reduce_acc r = scratch[0];\n" <<
+            "    multi_reduce_write(&r, result);\n" <<
+            "}\n";
+
+        kernel kernel2 = k2.compile(context);
+        kernel2.set_arg(k2_count_arg, uint_(groups));
+        kernel2.set_arg(k2_partials_arg, partials);
+        kernel2.set_arg(k2_result_arg, result_buffer);
+        queue.enqueue_1d_range_kernel(kernel2, 0, local_size, local_size);
+    }
+
+    // read back every result at once
+    std::vector<char> bytes(codegen.result_size);
+    queue.enqueue_read_buffer(result_buffer, 0, bytes.size(), &bytes[0]);
+
+    return multi_reduce_unpack(reducers, bytes, codegen.result_offsets, 0);
+}
+
+} // end detail namespace
+
+/// Computes several reductions of the values in the range [\p first,
+/// \p last) in a single pass and returns their results.
+///
+/// The \p reducers tuple can contain any combination of min_reducer,
+/// max_reducer, sum_reducer, sum_of_squares_reducer, count_reducer,
+/// mean_reducer, variance_reducer, argmin_reducer and argmax_reducer (or
+/// user-defined classes with the same interface). The input is read
+/// once and the results of all the reducers are read back to the host
+/// together, which for bandwidth-bound summaries is several times faster
+/// than calling an algorithm per statistic.
+///
+/// For example, to compute the minimum, maximum and sum of a vector:
+/// \code
+/// boost::tuple<float, float, float> stats = boost::compute::multi_reduce(
+///     vec.begin(), vec.end(),
+///     boost::make_tuple(boost::compute::min_reducer<float>(),
+///                       boost::compute::max_reducer<float>(),
+///                       boost::compute::sum_reducer<float>()),
+///     queue
+/// );
+/// \endcode
+///
+/// The returned \c boost::tuples::cons list converts to a \c boost::tuple
+/// of the reducers' result types.
+///
+/// \see reduce(), minmax_element()
+template<class InputIterator, class Head, class Tail>
+inline typename detail::multi_reduce_result<boost::tuples::cons<Head, Tail> >::type
+multi_reduce(InputIterator first,
+             InputIterator last,
+             const boost::tuples::cons<Head, Tail> &reducers,
+             command_queue &queue = system::default_queue())
+{
+    return detail::dispatch_multi_reduce(first, last, reducers, queue);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_MULTI_REDUCE_HPP
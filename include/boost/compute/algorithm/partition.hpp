@@ -33,6 +33,23 @@ inline Iterator partition(Iterator first,
     return stable_partition(first, last, predicate, queue);
 }
 
+///
+/// Partitions the elements in the range [\p first, \p last) according to
+/// \p predicate and stores the number of true values in \p count on the
+/// device instead of returning the end of the true values.
+///
+/// \see stable_partition()
+///
+template<class Iterator, class UnaryPredicate>
+inline void partition(Iterator first,
+                      Iterator last,
+                      UnaryPredicate predicate,
+                      detail::scalar<uint_> &count,
+                      command_queue &queue = system::default_queue())
+{
+    stable_partition(first, last, predicate, count, queue);
+}
+
 } // end compute namespace
 } // end boost namespace
 
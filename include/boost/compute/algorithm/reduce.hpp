@@ -13,18 +13,28 @@
 
 #include <iterator>
 
+#include <boost/type_traits/is_same.hpp>
+#include <boost/utility/enable_if.hpp>
 #include <boost/utility/result_of.hpp>
 
 #include <boost/compute/system.hpp>
 #include <boost/compute/functional.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/wait_list.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/async/detail/deferred_read.hpp>
+#include <boost/compute/async/detail/wait_list_barrier.hpp>
+#include <boost/compute/container/detail/scalar.hpp>
 #include <boost/compute/container/array.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/iterator/transform_iterator.hpp>
 #include <boost/compute/algorithm/copy_n.hpp>
 #include <boost/compute/algorithm/detail/inplace_reduce.hpp>
 #include <boost/compute/algorithm/detail/reduce_on_gpu.hpp>
 #include <boost/compute/algorithm/detail/serial_reduce.hpp>
+#include <boost/compute/detail/is_device_iterator.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
@@ -235,6 +245,47 @@ inline void dispatch_reduce(InputIterator first,
     generic_reduce(first, last, result, function, queue);
 }
 
+// half values are reduced as floats so that the temporary values of the
+// reduction are floats as well
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline void dispatch_reduce_values(InputIterator first,
+                                   InputIterator last,
+                                   OutputIterator result,
+                                   BinaryFunction function,
+                                   command_queue &queue)
+{
+    dispatch_reduce(first, last, result, function, queue);
+}
+
+template<class OutputIterator, class BinaryFunction>
+inline void dispatch_reduce_values(buffer_iterator<half_> first,
+                                   buffer_iterator<half_> last,
+                                   OutputIterator result,
+                                   BinaryFunction function,
+                                   command_queue &queue)
+{
+    dispatch_reduce(
+        ::boost::compute::make_transform_iterator(first, convert<float_>()),
+        ::boost::compute::make_transform_iterator(last, convert<float_>()),
+        result,
+        function,
+        queue
+    );
+}
+
+// the future type returned by reduce_async()
+template<class InputIterator, class BinaryFunction>
+struct reduce_async_future
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type input_type;
+
+    typedef future<
+        typename boost::tr1_result_of<
+            BinaryFunction(input_type, input_type)
+        >::type
+    > type;
+};
+
 } // end detail namespace
 
 /// Returns the result of applying \p function to the elements in the
@@ -267,7 +318,7 @@ inline void reduce(InputIterator first,
         return;
     }
 
-    detail::dispatch_reduce(first, last, result, function, queue);
+    detail::dispatch_reduce_values(first, last, result, function, queue);
 }
 
 /// \overload
@@ -277,13 +328,91 @@ inline void reduce(InputIterator first,
                    OutputIterator result,
                    command_queue &queue = system::default_queue())
 {
-    typedef typename std::iterator_traits<InputIterator>::value_type T;
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    typedef typename detail::kernel_value_type<value_type>::type T;
 
     if(first == last){
         return;
     }
 
-    detail::dispatch_reduce(first, last, result, plus<T>(), queue);
+    detail::dispatch_reduce_values(first, last, result, plus<T>(), queue);
+}
+
+/// Asynchronously reduces the elements in the range [\p first, \p last)
+/// with \p function. The reduction starts after the events in \p events
+/// have completed.
+///
+/// This function only enqueues the reduction and returns without blocking
+/// the host. The result is read back with a non-blocking read which
+/// completes the returned future. Unlike reduce(), it only accepts device
+/// iterators:
+/// \code
+/// future<int> sum = reduce_async(vec.begin(), vec.end(), plus<int>(), queue);
+///
+/// // ... enqueue more work ...
+///
+/// int value = sum.get();
+/// \endcode
+///
+/// \see reduce()
+template<class InputIterator, class BinaryFunction>
+inline typename boost::lazy_enable_if_c<
+    detail::is_device_iterator<InputIterator>::value &&
+    !boost::is_same<BinaryFunction, command_queue>::value,
+    detail::reduce_async_future<InputIterator, BinaryFunction>
+>::type
+reduce_async(InputIterator first,
+             InputIterator last,
+             BinaryFunction function,
+             command_queue &queue = system::default_queue(),
+             const wait_list &events = wait_list())
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type input_type;
+    typedef typename
+        boost::tr1_result_of<BinaryFunction(input_type, input_type)>::type
+        result_type;
+
+    detail::enqueue_wait_list_barrier(queue, events);
+
+    if(first == last){
+        return make_future(result_type(), queue.enqueue_marker());
+    }
+
+    detail::scalar<result_type> result(queue.get_context());
+    detail::dispatch_reduce_values(
+        first,
+        last,
+        make_buffer_iterator<result_type>(result.get_buffer()),
+        function,
+        queue
+    );
+
+    detail::deferred_read<result_type> read(result.get_buffer(), 0, queue);
+
+    return future<result_type>(read.get_event(), read);
+}
+
+/// \overload
+template<class InputIterator>
+inline typename boost::enable_if<
+    detail::is_device_iterator<InputIterator>,
+    future<
+        typename detail::kernel_value_type<
+            typename std::iterator_traits<InputIterator>::value_type
+        >::type
+    >
+>::type
+reduce_async(InputIterator first,
+             InputIterator last,
+             command_queue &queue = system::default_queue(),
+             const wait_list &events = wait_list())
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    typedef typename detail::kernel_value_type<value_type>::type T;
+
+    return ::boost::compute::reduce_async(
+        first, last, plus<T>(), queue, events
+    );
 }
 
 } // end compute namespace
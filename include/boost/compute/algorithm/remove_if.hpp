@@ -14,6 +14,7 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/algorithm/copy_if.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/detail/scalar.hpp>
 #include <boost/compute/functional/logical.hpp>
 
 namespace boost {
@@ -41,6 +42,32 @@ inline Iterator remove_if(Iterator first,
                                      queue);
 }
 
+/// Removes each element for which \p predicate returns \c true in the
+/// range [\p first, \p last) and stores the number of remaining elements
+/// in \p count on the device instead of returning the new end of the
+/// range.
+///
+/// \see remove_if(), copy_if()
+template<class Iterator, class Predicate>
+inline void remove_if(Iterator first,
+                      Iterator last,
+                      Predicate predicate,
+                      detail::scalar<uint_> &count,
+                      command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+    // temporary storage for the input data
+    ::boost::compute::vector<value_type> tmp(first, last, queue);
+
+    ::boost::compute::copy_if(tmp.begin(),
+                              tmp.end(),
+                              first,
+                              not1(predicate),
+                              count,
+                              queue);
+}
+
 } // end compute namespace
 } // end boost namespace
 
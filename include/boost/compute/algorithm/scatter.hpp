@@ -19,17 +19,18 @@
 #include <boost/compute/iterator/buffer_iterator.hpp>
 #include <boost/compute/type_traits/type_name.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
-#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/elementwise_kernel.hpp>
 
 namespace boost {
 namespace compute {
 namespace detail {
 
 template<class InputIterator, class MapIterator, class OutputIterator>
-class scatter_kernel : meta_kernel
+class scatter_kernel : elementwise_kernel
 {
 public:
-    scatter_kernel() : meta_kernel("scatter")
+    explicit scatter_kernel(const device &device)
+        : elementwise_kernel("scatter", device)
     {}
 
     void set_range(InputIterator first,
@@ -44,13 +45,14 @@ public:
         m_input_offset_arg = add_arg<uint_>("input_offset");
         m_output_offset_arg = add_arg<uint_>("output_offset");
 
+        begin_loop();
         *this <<
-            "const uint i = get_global_id(0);\n" <<
-            "uint i1 = " << map[expr<uint_>("i")] << 
+            "uint i1 = " << map[expr<uint_>("index")] <<
                 " + output_offset;\n" <<
-            "uint i2 = i + input_offset;\n" <<
-            result[expr<uint_>("i1")] << "=" << 
+            "uint i2 = index + input_offset;\n" <<
+            result[expr<uint_>("i1")] << "=" <<
                 first[expr<uint_>("i2")] << ";\n";
+        end_loop();
     }
 
     event exec(command_queue &queue)
@@ -62,15 +64,15 @@ public:
         set_arg(m_input_offset_arg, uint_(m_input_offset));
         set_arg(m_output_offset_arg, uint_(m_output_offset));
 
-        return exec_1d(queue, 0, m_count);
+        return elementwise_kernel::exec(queue, m_count);
     }
 
 private:
     size_t m_count;
-    size_t m_input_offset;    
-    size_t m_input_offset_arg;    
-    size_t m_output_offset;    
-    size_t m_output_offset_arg;    
+    size_t m_input_offset;
+    size_t m_input_offset_arg;
+    size_t m_output_offset;
+    size_t m_output_offset_arg;
 };
 
 } // end detail namespace
@@ -87,7 +89,8 @@ inline void scatter(InputIterator first,
                     OutputIterator result,
                     command_queue &queue = system::default_queue())
 {
-    detail::scatter_kernel<InputIterator, MapIterator, OutputIterator> kernel;
+    detail::scatter_kernel<InputIterator, MapIterator, OutputIterator>
+        kernel(queue.get_device());
     
     kernel.set_range(first, last, map, result);
     kernel.exec(queue);
@@ -0,0 +1,80 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_SEGMENTED_SORT_HPP
+#define BOOST_COMPUTE_ALGORITHM_SEGMENTED_SORT_HPP
+
+#include <iterator>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/segmented_sort.hpp>
+#include <boost/compute/functional/operator.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Sorts each segment of the range [\p first, \p last) independently
+/// using \p compare. The segments are given by the offsets in the range
+/// [\p offsets_first, \p offsets_last) which contains one more offset than
+/// the number of segments: segment \c i is the range
+/// [\p first \c + \c offsets[i], \p first \c + \c offsets[i+1]). Offsets
+/// must be non-decreasing. Empty segments are allowed and elements
+/// outside of all segments are left unchanged.
+///
+/// All segments are sorted together with a few kernel launches. Segments
+/// of up to 256 elements are sorted by a single work-group in local
+/// memory, longer segments are sorted tile by tile and then merged. This
+/// is much faster than calling sort() for each of many small arrays.
+///
+/// The sort is not stable. If no compare function is specified, \c less
+/// is used.
+///
+/// For example, to sort the events of each user by time:
+/// \code
+/// // event times grouped by user, user i owns the events in
+/// // [user_offsets[i], user_offsets[i+1])
+/// segmented_sort(times.begin(), times.end(),
+///                user_offsets.begin(), user_offsets.end(), queue);
+/// \endcode
+///
+/// \see sort(), segmented_sort_by_key()
+template<class Iterator, class OffsetIterator, class Compare>
+inline void segmented_sort(Iterator first,
+                           Iterator last,
+                           OffsetIterator offsets_first,
+                           OffsetIterator offsets_last,
+                           Compare compare,
+                           command_queue &queue = system::default_queue())
+{
+    detail::dispatch_segmented_sort<false>(
+        first, last, first, offsets_first, offsets_last, compare, queue
+    );
+}
+
+/// \overload
+template<class Iterator, class OffsetIterator>
+inline void segmented_sort(Iterator first,
+                           Iterator last,
+                           OffsetIterator offsets_first,
+                           OffsetIterator offsets_last,
+                           command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+    ::boost::compute::segmented_sort(
+        first, last, offsets_first, offsets_last, less<value_type>(), queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_SEGMENTED_SORT_HPP
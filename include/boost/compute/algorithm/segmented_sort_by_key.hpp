@@ -0,0 +1,71 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_SEGMENTED_SORT_BY_KEY_HPP
+#define BOOST_COMPUTE_ALGORITHM_SEGMENTED_SORT_BY_KEY_HPP
+
+#include <iterator>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/segmented_sort.hpp>
+#include <boost/compute/functional/operator.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Performs a key-value sort of each segment of the keys in the range
+/// [\p keys_first, \p keys_last) and the corresponding values beginning
+/// at \p values_first using \p compare. The segments are given by the
+/// offsets in [\p offsets_first, \p offsets_last) as in segmented_sort().
+///
+/// The sort is not stable. If no compare function is specified, \c less
+/// is used.
+///
+/// \see segmented_sort(), sort_by_key()
+template<class KeyIterator,
+         class ValueIterator,
+         class OffsetIterator,
+         class Compare>
+inline void segmented_sort_by_key(KeyIterator keys_first,
+                                  KeyIterator keys_last,
+                                  ValueIterator values_first,
+                                  OffsetIterator offsets_first,
+                                  OffsetIterator offsets_last,
+                                  Compare compare,
+                                  command_queue &queue = system::default_queue())
+{
+    detail::dispatch_segmented_sort<true>(
+        keys_first, keys_last, values_first,
+        offsets_first, offsets_last, compare, queue
+    );
+}
+
+/// \overload
+template<class KeyIterator, class ValueIterator, class OffsetIterator>
+inline void segmented_sort_by_key(KeyIterator keys_first,
+                                  KeyIterator keys_last,
+                                  ValueIterator values_first,
+                                  OffsetIterator offsets_first,
+                                  OffsetIterator offsets_last,
+                                  command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<KeyIterator>::value_type key_type;
+
+    ::boost::compute::segmented_sort_by_key(
+        keys_first, keys_last, values_first,
+        offsets_first, offsets_last, less<key_type>(), queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_SEGMENTED_SORT_BY_KEY_HPP
@@ -13,11 +13,13 @@
 
 #include <iterator>
 
+#include <boost/compute/algorithm/copy_if.hpp>
 #include <boost/compute/algorithm/detail/balanced_path.hpp>
 #include <boost/compute/algorithm/detail/compact.hpp>
 #include <boost/compute/algorithm/exclusive_scan.hpp>
 #include <boost/compute/algorithm/fill_n.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/detail/scalar.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
 #include <boost/compute/detail/read_write_single_value.hpp>
@@ -121,28 +123,19 @@ private:
 
 } //end detail namespace
 
+/// Finds the union of the sorted ranges like set_union() and stores the
+/// size of the union in \p count on the device instead of returning the end
+/// of the result range.
 ///
-/// \brief Set union algorithm
-///
-/// Finds the union of the sorted range [first1, last1) with the sorted
-/// range [first2, last2) and stores it in range starting at result
-/// \return Iterator pointing to end of union
-///
-/// \param first1 Iterator pointing to start of first set
-/// \param last1 Iterator pointing to end of first set
-/// \param first2 Iterator pointing to start of second set
-/// \param last2 Iterator pointing to end of second set
-/// \param result Iterator pointing to start of range in which the union
-/// will be stored
-/// \param queue Queue on which to execute
-///
+/// \see set_union()
 template<class InputIterator1, class InputIterator2, class OutputIterator>
-inline OutputIterator set_union(InputIterator1 first1,
-                                InputIterator1 last1,
-                                InputIterator2 first2,
-                                InputIterator2 last2,
-                                OutputIterator result,
-                                command_queue &queue = system::default_queue())
+inline void set_union(InputIterator1 first1,
+                      InputIterator1 last1,
+                      InputIterator2 first2,
+                      InputIterator2 last2,
+                      OutputIterator result,
+                      detail::scalar<uint_> &count,
+                      command_queue &queue = system::default_queue())
 {
     typedef typename std::iterator_traits<InputIterator1>::value_type value_type;
 
@@ -187,7 +180,37 @@ inline OutputIterator set_union(InputIterator1 first1,
 
     compact_kernel.exec(queue);
 
-    return result + detail::read_single_value<uint_>(counts.get_buffer(), counts.size()-1, queue);
+    // copy the total count after the scanned counts
+    copy_scanned_count(counts, count, queue);
+}
+
+///
+/// \brief Set union algorithm
+///
+/// Finds the union of the sorted range [first1, last1) with the sorted
+/// range [first2, last2) and stores it in range starting at result
+/// \return Iterator pointing to end of union
+///
+/// \param first1 Iterator pointing to start of first set
+/// \param last1 Iterator pointing to end of first set
+/// \param first2 Iterator pointing to start of second set
+/// \param last2 Iterator pointing to end of second set
+/// \param result Iterator pointing to start of range in which the union
+/// will be stored
+/// \param queue Queue on which to execute
+///
+template<class InputIterator1, class InputIterator2, class OutputIterator>
+inline OutputIterator set_union(InputIterator1 first1,
+                                InputIterator1 last1,
+                                InputIterator2 first2,
+                                InputIterator2 last2,
+                                OutputIterator result,
+                                command_queue &queue = system::default_queue())
+{
+    detail::scalar<uint_> count(queue.get_context());
+    ::boost::compute::set_union(first1, last1, first2, last2, result, count, queue);
+
+    return result + count.read(queue);
 }
 
 } //end compute namespace
@@ -12,30 +12,71 @@
 #define BOOST_COMPUTE_ALGORITHM_SORT_HPP
 
 #include <iterator>
+#include <algorithm>
 
 #include <boost/utility/enable_if.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
 
 #include <boost/compute/buffer.hpp>
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/host_dispatch.hpp>
+#include <boost/compute/wait_list.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/async/detail/wait_list_barrier.hpp>
 #include <boost/compute/algorithm/detail/fixed_sort.hpp>
 #include <boost/compute/algorithm/detail/radix_sort.hpp>
 #include <boost/compute/algorithm/detail/insertion_sort.hpp>
 #include <boost/compute/container/mapped_view.hpp>
+#include <boost/compute/detail/is_device_iterator.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
 namespace compute {
 namespace detail {
 
-// sort() for device iterators
-template <class Iterator>
-inline void dispatch_sort(Iterator first,
-                          Iterator last,
-                          command_queue &queue,
-                          typename boost::enable_if<
-                              is_device_iterator<Iterator>
-                          >::type* = 0)
+// sorts the values of a buffer with std::sort() on the host
+template<class Iterator>
+inline void sort_on_host(Iterator first,
+                         Iterator last,
+                         command_queue &queue,
+                         boost::true_type)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+
+    scoped_host_map<T> values(
+        first,
+        iterator_range_size(first, last),
+        CL_MAP_READ | CL_MAP_WRITE,
+        queue
+    );
+    std::sort(values.begin(), values.end());
+}
+
+template<class Iterator>
+inline void sort_on_host(Iterator, Iterator, command_queue&, boost::false_type)
+{
+}
+
+// sorts a range of host values with std::sort()
+template<class Iterator>
+inline bool sort_host_range(Iterator first, Iterator last, boost::true_type)
+{
+    std::sort(first, last);
+    return true;
+}
+
+template<class Iterator>
+inline bool sort_host_range(Iterator, Iterator, boost::false_type)
+{
+    return false;
+}
+
+// sorts the values of a device range with kernels only
+template<class Iterator>
+inline void sort_on_device(Iterator first,
+                           Iterator last,
+                           command_queue &queue)
 {
     typedef typename std::iterator_traits<Iterator>::value_type T;
 
@@ -57,6 +98,50 @@ inline void dispatch_sort(Iterator first,
     }
 }
 
+// half values are always radix sorted by their 16-bit patterns (the other
+// sorts would need to compare half values in kernels)
+inline void sort_on_device(buffer_iterator<half_> first,
+                           buffer_iterator<half_> last,
+                           command_queue &queue)
+{
+    if(detail::iterator_range_size(first, last) < 2){
+        return;
+    }
+
+    ::boost::compute::detail::radix_sort(first, last, queue);
+}
+
+// sort() for device iterators
+template <class Iterator>
+inline void dispatch_sort(Iterator first,
+                          Iterator last,
+                          command_queue &queue,
+                          typename boost::enable_if<
+                              is_device_iterator<Iterator>
+                          >::type* = 0)
+{
+    size_t count = detail::iterator_range_size(first, last);
+    if(count < 2){
+        return;
+    }
+    else if(dispatch_to_host(first, last, host_dispatch::sort_algorithm, queue)){
+        sort_on_host(
+            first, last, queue, typename is_host_dispatchable<Iterator>::type()
+        );
+    }
+    else {
+        sort_on_device(first, last, queue);
+    }
+}
+
+// sort() for half values, which are never sorted on the host
+inline void dispatch_sort(buffer_iterator<half_> first,
+                          buffer_iterator<half_> last,
+                          command_queue &queue)
+{
+    sort_on_device(first, last, queue);
+}
+
 // sort() for host iterators
 template <class Iterator>
 inline void dispatch_sort(Iterator first,
@@ -70,6 +155,13 @@ inline void dispatch_sort(Iterator first,
 
     size_t size = static_cast<size_t>(std::distance(first, last));
 
+    // sort small ranges in place rather than on the device
+    if(size <= host_dispatch::threshold(queue.get_device(),
+                                        host_dispatch::sort_algorithm) &&
+       sort_host_range(first, last, typename boost::is_arithmetic<T>::type())){
+        return;
+    }
+
     // create mapped buffer
     mapped_view<T> view(
         boost::addressof(*first), size, queue.get_context()
@@ -138,6 +230,50 @@ inline void sort(Iterator first,
     detail::dispatch_sort(first, last, queue);
 }
 
+/// Asynchronously sorts the values in the range [\p first, \p last)
+/// according to \p compare. The sort starts after the events in \p events
+/// have completed.
+///
+/// This function only enqueues the sort and returns without blocking the
+/// host. Unlike sort(), it never sorts small ranges on the host (see
+/// host_dispatch) and it only accepts device iterators. The returned future
+/// completes with the sort.
+///
+/// \see sort()
+template<class Iterator, class Compare>
+inline typename boost::enable_if<
+    detail::is_device_iterator<Iterator>, future<void>
+>::type
+sort_async(Iterator first,
+           Iterator last,
+           Compare compare,
+           command_queue &queue = system::default_queue(),
+           const wait_list &events = wait_list())
+{
+    detail::enqueue_wait_list_barrier(queue, events);
+
+    ::boost::compute::sort(first, last, compare, queue);
+
+    return future<void>(queue.enqueue_marker());
+}
+
+/// \overload
+template<class Iterator>
+inline typename boost::enable_if<
+    detail::is_device_iterator<Iterator>, future<void>
+>::type
+sort_async(Iterator first,
+           Iterator last,
+           command_queue &queue = system::default_queue(),
+           const wait_list &events = wait_list())
+{
+    detail::enqueue_wait_list_barrier(queue, events);
+
+    detail::sort_on_device(first, last, queue);
+
+    return future<void>(queue.enqueue_marker());
+}
+
 } // end compute namespace
 } // end boost namespace
 
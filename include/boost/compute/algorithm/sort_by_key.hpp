@@ -13,14 +13,45 @@
 
 #include <iterator>
 
+#include <boost/type_traits/is_arithmetic.hpp>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/detail/insertion_sort.hpp>
 #include <boost/compute/algorithm/detail/radix_sort.hpp>
+#include <boost/compute/algorithm/detail/sort_permutation.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/container/vector.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/iterator/zip_iterator.hpp>
 
 namespace boost {
 namespace compute {
+namespace detail {
+
+// sorts the keys along with a permutation which is then applied to all of
+// the value columns in one gather pass. SortTag is passed on to
+// sort_keys_with_indices().
+template<class KeyIterator, class IteratorTuple, class SortTag>
+inline void dispatch_sort_by_key(KeyIterator keys_first,
+                                 KeyIterator keys_last,
+                                 zip_iterator<IteratorTuple> values_first,
+                                 SortTag tag,
+                                 command_queue &queue)
+{
+    size_t count = iterator_range_size(keys_first, keys_last);
+    if(count < 2){
+        return;
+    }
+
+    vector<uint_> indices(count, queue.get_context());
+    ::boost::compute::iota(indices.begin(), indices.end(), uint_(0), queue);
+
+    sort_keys_with_indices(keys_first, keys_last, indices, tag, queue);
+    gather_zip_columns(indices, values_first, queue);
+}
+
+} // end detail namespace
 
 /// Performs a key-value sort using the keys in the range [\p keys_first,
 /// \p keys_last) on the values in the range [\p values_first,
@@ -68,6 +99,55 @@ inline void sort_by_key(KeyIterator keys_first,
     }
 }
 
+/// Performs a key-value sort using the keys in the range [\p keys_first,
+/// \p keys_last) on the value columns of the zip iterator \p values_first
+/// using \p compare.
+///
+/// Instead of moving every payload column during each pass of the sort,
+/// the keys are sorted along with a permutation of indices which is then
+/// applied to all of the value columns in a single gather pass. This is
+/// much faster for tables with many (or wide) payload columns.
+///
+/// For example, to sort the name and price columns of a table by id:
+/// \code
+/// sort_by_key(
+///     ids.begin(), ids.end(),
+///     make_zip_iterator(boost::make_tuple(names.begin(), prices.begin())),
+///     queue
+/// );
+/// \endcode
+///
+/// \see sorted_indices()
+template<class KeyIterator, class IteratorTuple, class Compare>
+inline void sort_by_key(KeyIterator keys_first,
+                        KeyIterator keys_last,
+                        zip_iterator<IteratorTuple> values_first,
+                        Compare compare,
+                        command_queue &queue = system::default_queue())
+{
+    detail::dispatch_sort_by_key(
+        keys_first, keys_last, values_first, compare, queue
+    );
+}
+
+/// \overload
+template<class KeyIterator, class IteratorTuple>
+inline void sort_by_key(KeyIterator keys_first,
+                        KeyIterator keys_last,
+                        zip_iterator<IteratorTuple> values_first,
+                        command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<KeyIterator>::value_type key_type;
+
+    detail::dispatch_sort_by_key(
+        keys_first,
+        keys_last,
+        values_first,
+        typename boost::is_arithmetic<key_type>::type(),
+        queue
+    );
+}
+
 } // end compute namespace
 } // end boost namespace
 
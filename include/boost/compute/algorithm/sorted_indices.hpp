@@ -0,0 +1,152 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_SORTED_INDICES_HPP
+#define BOOST_COMPUTE_ALGORITHM_SORTED_INDICES_HPP
+
+#include <iterator>
+
+#include <boost/tuple/tuple.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/detail/sort_permutation.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/iterator/zip_iterator.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// SortTag is either a compare function or, when sorting with less, the
+// result of is_arithmetic<> on the value type (see sort_keys_with_indices())
+template<class InputIterator, class OutputIterator, class SortTag>
+inline void dispatch_sorted_indices(InputIterator first,
+                                    InputIterator last,
+                                    OutputIterator result,
+                                    SortTag tag,
+                                    command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    const size_t count = iterator_range_size(first, last);
+    if(count == 0){
+        return;
+    }
+
+    const context &context = queue.get_context();
+    vector<value_type> keys(first, last, queue);
+    vector<uint_> indices(count, context);
+    ::boost::compute::iota(indices.begin(), indices.end(), uint_(0), queue);
+
+    sort_keys_with_indices(keys.begin(), keys.end(), indices, tag, queue);
+
+    ::boost::compute::copy(indices.begin(), indices.end(), result, queue);
+}
+
+} // end detail namespace
+
+/// Stores in the range beginning at \p result the permutation of indices
+/// which sorts the values in the range [\p first, \p last) according to
+/// \p compare. The input range is not modified. This is also known as an
+/// argsort.
+///
+/// The permutation can then be applied to any number of columns with
+/// gather() instead of moving wide values during the sort. The result
+/// type must be \c uint_.
+///
+/// If no compare function is specified, \c less is used and arithmetic
+/// values are sorted with a stable radix sort. With a user-defined
+/// compare function the order of equal values is unspecified.
+///
+/// For example, to sort the rows of a table by its \c price column:
+/// \code
+/// vector<uint_> order(prices.size(), context);
+/// sorted_indices(prices.begin(), prices.end(), order.begin(), queue);
+///
+/// gather(order.begin(), order.end(), names.begin(), sorted_names.begin(), queue);
+/// \endcode
+///
+/// \see sort(), sort_by_key(), gather()
+template<class InputIterator, class OutputIterator, class Compare>
+inline void sorted_indices(InputIterator first,
+                           InputIterator last,
+                           OutputIterator result,
+                           Compare compare,
+                           command_queue &queue = system::default_queue())
+{
+    detail::dispatch_sorted_indices(first, last, result, compare, queue);
+}
+
+/// \overload
+template<class InputIterator, class OutputIterator>
+inline void sorted_indices(InputIterator first,
+                           InputIterator last,
+                           OutputIterator result,
+                           command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    detail::dispatch_sorted_indices(
+        first,
+        last,
+        result,
+        typename boost::is_arithmetic<value_type>::type(),
+        queue
+    );
+}
+
+/// Stores in the range beginning at \p result the permutation of indices
+/// which sorts the key tuples in the range [\p first, \p last) in
+/// lexicographic order (the first column is the most significant). The
+/// order of equal key tuples is preserved.
+///
+/// The indices are sorted with one stable radix sort per key column,
+/// starting from the least significant column. Each key column must be
+/// of an arithmetic type.
+///
+/// For example, to order a table by \c year and then by \c month:
+/// \code
+/// sorted_indices(
+///     make_zip_iterator(boost::make_tuple(years.begin(), months.begin())),
+///     make_zip_iterator(boost::make_tuple(years.end(), months.end())),
+///     order.begin(),
+///     queue
+/// );
+/// \endcode
+template<class IteratorTuple, class OutputIterator>
+inline void sorted_indices(zip_iterator<IteratorTuple> first,
+                           zip_iterator<IteratorTuple> last,
+                           OutputIterator result,
+                           command_queue &queue = system::default_queue())
+{
+    const size_t count = detail::iterator_range_size(first, last);
+    if(count == 0){
+        return;
+    }
+
+    vector<uint_> indices(count, queue.get_context());
+    ::boost::compute::iota(indices.begin(), indices.end(), uint_(0), queue);
+
+    detail::lexicographic_sort_indices<
+        boost::tuples::length<IteratorTuple>::value
+    >::apply(first.get_iterator_tuple(), count, indices, queue);
+
+    ::boost::compute::copy(indices.begin(), indices.end(), result, queue);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_SORTED_INDICES_HPP
@@ -17,6 +17,9 @@
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/copy_if.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/detail/scalar.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
 
 namespace boost {
 namespace compute {
@@ -66,6 +69,62 @@ inline Iterator stable_partition(Iterator first,
     return last_true;
 }
 
+///
+/// Partitions the elements in the range [\p first, \p last) according to
+/// \p predicate and stores the number of true values in \p count on the
+/// device instead of returning the end of the true values. The order of
+/// the elements is preserved.
+///
+/// Both partitions are written by a single kernel from the scanned
+/// predicate results, so the number of true values is never read back
+/// by the host.
+///
+/// \see stable_partition(), copy_if()
+///
+template<class Iterator, class UnaryPredicate>
+inline void stable_partition(Iterator first,
+                             Iterator last,
+                             UnaryPredicate predicate,
+                             detail::scalar<uint_> &count,
+                             command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+    size_t size = detail::iterator_range_size(first, last);
+    if(size == 0){
+        count.write(0, queue);
+        return;
+    }
+
+    const context &context = queue.get_context();
+
+    // make temporary copy of the input
+    ::boost::compute::vector<value_type> tmp(first, last, queue);
+
+    // positions of the true values, the last one holds their count
+    ::boost::compute::vector<uint_> indices(size + 1, context);
+    detail::scan_predicate_indices(
+        tmp.begin(), size, predicate, indices, queue
+    );
+
+    // the i-th value goes to its position among the true values or after
+    // the true values at its position among the false values
+    detail::meta_kernel k("stable_partition_with_count");
+    k.add_set_arg<const uint_>("size", static_cast<uint_>(size));
+    k << "const uint i = get_global_id(0);\n"
+      << "const uint index = " << indices.begin()[k.var<uint_>("i")] << ";\n"
+      << "const uint true_count = " << indices.begin()[k.var<uint_>("size")] << ";\n"
+      << "if(" << indices.begin()[k.var<uint_>("i + 1")] << " != index)\n"
+      << "    " << first[k.var<uint_>("index")] << " = "
+      << tmp.begin()[k.var<uint_>("i")] << ";\n"
+      << "else\n"
+      << "    " << first[k.var<uint_>("true_count + i - index")] << " = "
+      << tmp.begin()[k.var<uint_>("i")] << ";\n";
+    k.exec_1d(queue, 0, size);
+
+    detail::copy_scanned_count(indices, count, queue);
+}
+
 } // end compute namespace
 } // end boost namespace
 
@@ -0,0 +1,81 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_SUMMATION_POLICY_HPP
+#define BOOST_COMPUTE_ALGORITHM_SUMMATION_POLICY_HPP
+
+#include <boost/type_traits/integral_constant.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \struct fast_summation
+/// \brief Sums floating-point values with a parallel tree reduction.
+///
+/// This is the fastest policy but the rounding error grows with the size
+/// of the range and the result may differ between devices.
+///
+/// \see accumulate()
+struct fast_summation
+{
+};
+
+/// \struct compensated_summation
+/// \brief Sums floating-point values with compensated (Kahan-Babuska-
+///        Neumaier) summation.
+///
+/// Every partial sum carries a correction term for the low-order bits lost
+/// when it was rounded, so the result is nearly as accurate as summing in
+/// twice the precision. The partial sums depend on the device's work
+/// sizes, so the result may differ in the last bits between devices.
+///
+/// \see accumulate()
+struct compensated_summation
+{
+};
+
+/// \struct reproducible_summation
+/// \brief Sums floating-point values in a fixed order independent of the
+///        device.
+///
+/// The range is divided into fixed-size blocks which are each summed with
+/// compensated summation in the same order on every device, and the block
+/// sums are combined in the same way until they are summed on the host.
+/// The result is bitwise identical between runs and between devices as
+/// long as they implement IEEE 754 round-to-nearest addition (devices
+/// which flush denormals to zero may differ for denormal inputs).
+///
+/// This is the default policy for accumulate() with \c plus of \c float
+/// or \c double.
+///
+/// \see accumulate()
+struct reproducible_summation
+{
+};
+
+namespace detail {
+
+template<class T>
+struct is_summation_policy : boost::false_type {};
+
+template<>
+struct is_summation_policy<fast_summation> : boost::true_type {};
+
+template<>
+struct is_summation_policy<compensated_summation> : boost::true_type {};
+
+template<>
+struct is_summation_policy<reproducible_summation> : boost::true_type {};
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_SUMMATION_POLICY_HPP
@@ -11,15 +11,88 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_TRANSFORM_HPP
 #define BOOST_COMPUTE_ALGORITHM_TRANSFORM_HPP
 
+#include <boost/utility/enable_if.hpp>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/wait_list.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/async/detail/wait_list_barrier.hpp>
 #include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/detail/transform_on_device.hpp>
+#include <boost/compute/container/detail/scalar.hpp>
+#include <boost/compute/detail/is_device_iterator.hpp>
 #include <boost/compute/iterator/transform_iterator.hpp>
 #include <boost/compute/iterator/zip_iterator.hpp>
 #include <boost/compute/functional/detail/unpack.hpp>
 
 namespace boost {
 namespace compute {
+namespace detail {
+
+template<class InputIterator, class OutputIterator, class UnaryOperator>
+inline OutputIterator dispatch_transform(InputIterator first,
+                                         InputIterator last,
+                                         OutputIterator result,
+                                         UnaryOperator op,
+                                         command_queue &queue)
+{
+    return ::boost::compute::copy(
+               ::boost::compute::make_transform_iterator(first, op),
+               ::boost::compute::make_transform_iterator(last, op),
+               result,
+               queue
+           );
+}
+
+// specialization for buffer iterators which loads and stores vectors
+template<class T, class U, class UnaryOperator>
+inline buffer_iterator<U> dispatch_transform(buffer_iterator<T> first,
+                                             buffer_iterator<T> last,
+                                             buffer_iterator<U> result,
+                                             UnaryOperator op,
+                                             command_queue &queue)
+{
+    return transform_on_device(first, last, result, op, queue);
+}
+
+template<class InputIterator1,
+         class InputIterator2,
+         class OutputIterator,
+         class BinaryOperator>
+inline OutputIterator dispatch_transform(InputIterator1 first1,
+                                         InputIterator1 last1,
+                                         InputIterator2 first2,
+                                         OutputIterator result,
+                                         BinaryOperator op,
+                                         command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator1>::difference_type difference_type;
+
+    difference_type n = std::distance(first1, last1);
+
+    return dispatch_transform(
+               make_zip_iterator(boost::make_tuple(first1, first2)),
+               make_zip_iterator(boost::make_tuple(last1, first2 + n)),
+               result,
+               detail::unpack(op),
+               queue
+           );
+}
+
+// specialization for buffer iterators which loads and stores vectors
+template<class T1, class T2, class U, class BinaryOperator>
+inline buffer_iterator<U> dispatch_transform(buffer_iterator<T1> first1,
+                                             buffer_iterator<T1> last1,
+                                             buffer_iterator<T2> first2,
+                                             buffer_iterator<U> result,
+                                             BinaryOperator op,
+                                             command_queue &queue)
+{
+    return transform_on_device(first1, last1, first2, result, op, queue);
+}
+
+} // end detail namespace
 
 /// Transforms the elements in the range [\p first, \p last) using
 /// \p transform and stores the results in the range beginning at
@@ -44,12 +117,7 @@ inline OutputIterator transform(InputIterator first,
                                 UnaryOperator op,
                                 command_queue &queue = system::default_queue())
 {
-    return copy(
-               ::boost::compute::make_transform_iterator(first, op),
-               ::boost::compute::make_transform_iterator(last, op),
-               result,
-               queue
-           );
+    return detail::dispatch_transform(first, last, result, op, queue);
 }
 
 /// \overload
@@ -64,17 +132,90 @@ inline OutputIterator transform(InputIterator1 first1,
                                 BinaryOperator op,
                                 command_queue &queue = system::default_queue())
 {
-    typedef typename std::iterator_traits<InputIterator1>::difference_type difference_type;
+    return detail::dispatch_transform(first1, last1, first2, result, op, queue);
+}
 
-    difference_type n = std::distance(first1, last1);
+/// Transforms the first \p count elements in the range [\p first,
+/// \p last) using operator \p op and stores the results in the range
+/// beginning at \p result, where \p count is stored on the device (e.g.
+/// the result size of copy_if()).
+///
+/// The count is not read back by the host. The kernel is launched for the
+/// whole range and the work-items past \p count exit early.
+///
+/// \see copy()
+template<class InputIterator, class OutputIterator, class UnaryOperator>
+inline void transform(InputIterator first,
+                      InputIterator last,
+                      const detail::scalar<uint_> &count,
+                      OutputIterator result,
+                      UnaryOperator op,
+                      command_queue &queue = system::default_queue())
+{
+    ::boost::compute::copy(
+        ::boost::compute::make_transform_iterator(first, op),
+        ::boost::compute::make_transform_iterator(last, op),
+        count,
+        result,
+        queue
+    );
+}
 
-    return transform(
-               make_zip_iterator(boost::make_tuple(first1, first2)),
-               make_zip_iterator(boost::make_tuple(last1, first2 + n)),
-               result,
-               detail::unpack(op),
-               queue
-           );
+/// Asynchronously transforms the elements in the range [\p first, \p last)
+/// using \p transform and stores the results in the range beginning at
+/// \p result. The transform starts after the events in \p events have
+/// completed.
+///
+/// This function only enqueues the transform and returns without blocking
+/// the host. Unlike transform(), it only accepts device iterators. The
+/// returned future completes with the transform.
+///
+/// \see transform()
+template<class InputIterator, class OutputIterator, class UnaryOperator>
+inline typename boost::enable_if_c<
+    detail::is_device_iterator<InputIterator>::value &&
+    detail::is_device_iterator<OutputIterator>::value,
+    future<OutputIterator>
+>::type
+transform_async(InputIterator first,
+                InputIterator last,
+                OutputIterator result,
+                UnaryOperator op,
+                command_queue &queue = system::default_queue(),
+                const wait_list &events = wait_list())
+{
+    detail::enqueue_wait_list_barrier(queue, events);
+
+    OutputIterator end = ::boost::compute::transform(first, last, result, op, queue);
+
+    return make_future(end, queue.enqueue_marker());
+}
+
+/// \overload
+template<class InputIterator1,
+         class InputIterator2,
+         class OutputIterator,
+         class BinaryOperator>
+inline typename boost::enable_if_c<
+    detail::is_device_iterator<InputIterator1>::value &&
+    detail::is_device_iterator<InputIterator2>::value &&
+    detail::is_device_iterator<OutputIterator>::value,
+    future<OutputIterator>
+>::type
+transform_async(InputIterator1 first1,
+                InputIterator1 last1,
+                InputIterator2 first2,
+                OutputIterator result,
+                BinaryOperator op,
+                command_queue &queue = system::default_queue(),
+                const wait_list &events = wait_list())
+{
+    detail::enqueue_wait_list_barrier(queue, events);
+
+    OutputIterator end =
+        ::boost::compute::transform(first1, last1, first2, result, op, queue);
+
+    return make_future(end, queue.enqueue_marker());
 }
 
 } // end compute namespace
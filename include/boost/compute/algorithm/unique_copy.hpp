@@ -18,6 +18,7 @@
 #include <boost/compute/algorithm/transform.hpp>
 #include <boost/compute/algorithm/gather.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/detail/scalar.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
 #include <boost/compute/functional/operator.hpp>
@@ -113,6 +114,51 @@ inline OutputIterator unique_copy(InputIterator first,
     return result + std::distance(indices.begin(), last_index);
 }
 
+// like unique_copy() but stores the number of unique values in
+// result_count on the device instead of reading it back
+template<class InputIterator, class OutputIterator, class BinaryPredicate>
+inline void unique_copy_with_count(InputIterator first,
+                                   InputIterator last,
+                                   OutputIterator result,
+                                   BinaryPredicate op,
+                                   scalar<uint_> &result_count,
+                                   command_queue &queue)
+{
+    size_t count = detail::iterator_range_size(first, last);
+    if(count == 0){
+        result_count.write(0, queue);
+        return;
+    }
+
+    const context &context = queue.get_context();
+
+    // flags marking unique elements with a trailing zero, the flags are
+    // scanned into the destination indices
+    vector<uint_> indices(count + 1, context);
+
+    // find each unique element and mark it with a one
+    transform(
+        first, last - 1, first + 1, indices.begin() + 1, not2(op), queue
+    );
+
+    // first element is always unique
+    fill_n(indices.begin(), 1, 1, queue);
+    fill_n(indices.end() - 1, 1, 0, queue);
+
+    exclusive_scan(indices.begin(), indices.end(), indices.begin(), queue);
+
+    // copy each value whose index differs from the next one
+    meta_kernel k("unique_copy_with_count");
+    k << "const uint i = get_global_id(0);\n"
+      << "const uint index = " << indices.begin()[k.var<uint_>("i")] << ";\n"
+      << "if(" << indices.begin()[k.var<uint_>("i + 1")] << " != index)\n"
+      << "    " << result[k.var<uint_>("index")] << " = "
+      << first[k.var<uint_>("i")] << ";\n";
+    k.exec_1d(queue, 0, count);
+
+    copy_scanned_count(indices, result_count, queue);
+}
+
 } // end detail namespace
 
 /// Makes a copy of the range [first, last) and removes all consecutive
@@ -158,6 +204,38 @@ inline OutputIterator unique_copy(InputIterator first,
     );
 }
 
+/// Makes a copy of the range [first, last) without consecutive duplicate
+/// elements (determined by \p op) like unique_copy() and stores the number
+/// of copied elements in \p count on the device instead of returning the
+/// end of the result range.
+///
+/// \see unique_copy(), copy_if()
+template<class InputIterator, class OutputIterator, class BinaryPredicate>
+inline void unique_copy(InputIterator first,
+                        InputIterator last,
+                        OutputIterator result,
+                        BinaryPredicate op,
+                        detail::scalar<uint_> &count,
+                        command_queue &queue = system::default_queue())
+{
+    detail::unique_copy_with_count(first, last, result, op, count, queue);
+}
+
+/// \overload
+template<class InputIterator, class OutputIterator>
+inline void unique_copy(InputIterator first,
+                        InputIterator last,
+                        OutputIterator result,
+                        detail::scalar<uint_> &count,
+                        command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    detail::unique_copy_with_count(
+        first, last, result, ::boost::compute::equal_to<value_type>(), count, queue
+    );
+}
+
 } // end compute namespace
 } // end boost namespace
 
@@ -15,6 +15,8 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/detail/binary_find.hpp>
+#include <boost/compute/algorithm/detail/batched_binary_search.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
 namespace compute {
@@ -37,6 +39,49 @@ upper_bound(InputIterator first,
     return position;
 }
 
+/// Stores in the range beginning at \p result, for each value in the range
+/// [\p values_first, \p values_last), the index of the first element in
+/// the sorted range [\p first, \p last) that is greater than the value.
+/// Returns an iterator to the end of the results.
+///
+/// The values are searched for in a single kernel as described for the
+/// lower_bound() overload taking a range of values, including the
+/// \p values_sorted hint.
+///
+/// \see lower_bound(), equal_range()
+template<class InputIterator, class ValueIterator, class OutputIterator>
+inline OutputIterator
+upper_bound(InputIterator first,
+            InputIterator last,
+            ValueIterator values_first,
+            ValueIterator values_last,
+            OutputIterator result,
+            bool values_sorted,
+            command_queue &queue = system::default_queue())
+{
+    detail::dispatch_batched_search(
+        first, last, values_first, values_last, result,
+        detail::batched_upper_bound, values_sorted, queue
+    );
+
+    return result + detail::iterator_range_size(values_first, values_last);
+}
+
+/// \overload
+template<class InputIterator, class ValueIterator, class OutputIterator>
+inline OutputIterator
+upper_bound(InputIterator first,
+            InputIterator last,
+            ValueIterator values_first,
+            ValueIterator values_last,
+            OutputIterator result,
+            command_queue &queue = system::default_queue())
+{
+    return ::boost::compute::upper_bound(
+        first, last, values_first, values_last, result, false, queue
+    );
+}
+
 } // end compute namespace
 } // end boost namespace
 
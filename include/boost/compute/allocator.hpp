@@ -16,6 +16,8 @@
 /// Meta-header to include all Boost.Compute allocator headers.
 
 #include <boost/compute/allocator/buffer_allocator.hpp>
+#include <boost/compute/allocator/numa_allocator.hpp>
 #include <boost/compute/allocator/pinned_allocator.hpp>
+#include <boost/compute/allocator/zero_copy_allocator.hpp>
 
 #endif // BOOST_COMPUTE_ALLOCATOR_HPP
@@ -0,0 +1,98 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALLOCATOR_NUMA_ALLOCATOR_HPP
+#define BOOST_COMPUTE_ALLOCATOR_NUMA_ALLOCATOR_HPP
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/allocator/buffer_allocator.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class numa_allocator
+/// \brief An allocator which places memory local to the context's device.
+///
+/// Most CPU OpenCL implementations back buffers with host memory which is
+/// bound to a NUMA node when its pages are first written. The numa_allocator
+/// writes every newly allocated buffer with a kernel executed on the
+/// context's device so that its pages are placed on the node(s) that the
+/// device runs on.
+///
+/// This is most useful together with sub-devices created with
+/// device::partition_by_numa_node(), each with its own context:
+/// \code
+/// std::vector<device> nodes = cpu.partition_by_numa_node();
+/// context node_context(nodes[0]);
+///
+/// // allocates and first-touches the buffer on the first numa node
+/// vector<float, numa_allocator<float> > data(count, node_context);
+/// \endcode
+///
+/// \see device::partition_by_numa_node(), pinned_allocator
+template<class T>
+class numa_allocator : public buffer_allocator<T>
+{
+public:
+    typedef typename buffer_allocator<T>::pointer pointer;
+    typedef typename buffer_allocator<T>::size_type size_type;
+
+    explicit numa_allocator(const context &context)
+        : buffer_allocator<T>(context)
+    {
+    }
+
+    numa_allocator(const numa_allocator<T> &other)
+        : buffer_allocator<T>(other)
+    {
+    }
+
+    numa_allocator<T>& operator=(const numa_allocator<T> &other)
+    {
+        if(this != &other){
+            buffer_allocator<T>::operator=(other);
+        }
+
+        return *this;
+    }
+
+    ~numa_allocator()
+    {
+    }
+
+    /// Allocates a buffer for \p n values and touches each of its pages
+    /// from the context's device. Blocks until the pages have been written.
+    pointer allocate(size_type n)
+    {
+        pointer p = buffer_allocator<T>::allocate(n);
+        if(n == 0){
+            return p;
+        }
+
+        const context context = buffer_allocator<T>::get_context();
+        command_queue queue(context, context.get_device());
+
+        // use a kernel (rather than clEnqueueFillBuffer()) so that the
+        // writes are performed by the device's own compute units
+        detail::fill_with_copy(
+            buffer_iterator<T>(p.get_buffer(), 0), n, T(), queue
+        );
+        queue.finish();
+
+        return p;
+    }
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALLOCATOR_NUMA_ALLOCATOR_HPP
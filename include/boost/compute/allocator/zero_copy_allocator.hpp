@@ -0,0 +1,78 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALLOCATOR_ZERO_COPY_ALLOCATOR_HPP
+#define BOOST_COMPUTE_ALLOCATOR_ZERO_COPY_ALLOCATOR_HPP
+
+#include <boost/compute/allocator/buffer_allocator.hpp>
+#include <boost/compute/algorithm/detail/copy_by_mapping.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class zero_copy_allocator
+/// \brief An allocator which places memory where both the host and the
+///        device can access it directly.
+///
+/// On devices which share the host's memory (CPUs and integrated GPUs) the
+/// zero_copy_allocator allocates buffers with \c CL_MEM_ALLOC_HOST_PTR.
+/// Mapping such a buffer returns a pointer to its storage rather than to a
+/// staging copy, so copy() to and from it maps the buffer and copies the
+/// values directly instead of enqueuing a read or write command. Other
+/// buffers, including those created with \c CL_MEM_ALLOC_HOST_PTR or
+/// \c CL_MEM_USE_HOST_PTR outside of this allocator, are always copied
+/// with read and write commands.
+///
+/// On other devices host memory is slower for kernels to access, so
+/// buffers are allocated in device memory as with buffer_allocator.
+///
+/// For example:
+/// \code
+/// // vector whose copies to and from the host do not pass through the driver
+/// vector<float, zero_copy_allocator<float> > data(count, context);
+/// copy(host_data.begin(), host_data.end(), data.begin(), queue);
+/// \endcode
+///
+/// \see pinned_allocator, mapped_view
+template<class T>
+class zero_copy_allocator : public buffer_allocator<T>
+{
+public:
+    explicit zero_copy_allocator(const context &context)
+        : buffer_allocator<T>(context)
+    {
+        if(detail::is_host_unified_device(context.get_device())){
+            buffer_allocator<T>::set_mem_flags(detail::zero_copy_mem_flags);
+        }
+    }
+
+    zero_copy_allocator(const zero_copy_allocator<T> &other)
+        : buffer_allocator<T>(other)
+    {
+    }
+
+    zero_copy_allocator<T>& operator=(const zero_copy_allocator<T> &other)
+    {
+        if(this != &other){
+            buffer_allocator<T>::operator=(other);
+        }
+
+        return *this;
+    }
+
+    ~zero_copy_allocator()
+    {
+    }
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALLOCATOR_ZERO_COPY_ALLOCATOR_HPP
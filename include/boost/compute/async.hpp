@@ -15,6 +15,12 @@
 ///
 /// Meta-header to include all Boost.Compute async headers.
 
+#include <boost/compute/async/coroutine.hpp>
+#include <boost/compute/async/executor.hpp>
 #include <boost/compute/async/future.hpp>
+#include <boost/compute/async/task_graph.hpp>
+#include <boost/compute/async/wait.hpp>
+#include <boost/compute/async/when_all.hpp>
+#include <boost/compute/async/when_any.hpp>
 
 #endif // BOOST_COMPUTE_ASYNC_HPP
@@ -0,0 +1,164 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ASYNC_COROUTINE_HPP
+#define BOOST_COMPUTE_ASYNC_COROUTINE_HPP
+
+#include <boost/compute/config.hpp>
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L && \
+    defined(CL_VERSION_1_1)
+#define BOOST_COMPUTE_HAVE_COROUTINES
+#endif
+
+#ifdef BOOST_COMPUTE_HAVE_COROUTINES
+
+#include <coroutine>
+
+#include <boost/throw_exception.hpp>
+
+#include <boost/compute/event.hpp>
+#include <boost/compute/exception/opencl_error.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/async/executor.hpp>
+#include <boost/compute/async/detail/continuation.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class event_awaiter
+/// \brief Suspends a C++20 coroutine until an event has completed.
+///
+/// The coroutine is resumed from the event's completion callback by
+/// \p Executor, so no host thread is blocked while waiting. Usually
+/// created implicitly by \c co_await on an event or future:
+/// \code
+/// compute::event e = queue.enqueue_write_buffer_async(...);
+/// co_await e;
+///
+/// float sum = co_await compute::reduce_async(vec.begin(), vec.end(), queue);
+/// \endcode
+///
+/// The awaited future's result is available without blocking when the
+/// coroutine resumes. With the default inline_executor the coroutine
+/// resumes on the OpenCL runtime's callback thread, so the code following
+/// the \c co_await must not call blocking OpenCL functions (e.g. a
+/// synchronous algorithm or another future's wait()) before awaiting
+/// again. Use resume_on() to resume on another executor instead:
+/// \code
+/// float sum = co_await compute::resume_on(
+///     compute::reduce_async(vec.begin(), vec.end(), queue), thread_pool_executor
+/// );
+/// compute::fill(out.begin(), out.end(), sum, queue);
+/// \endcode
+///
+/// This header requires a compiler with C++20 coroutine support.
+///
+/// \see future::then()
+template<class Executor = inline_executor>
+class event_awaiter
+{
+public:
+    explicit event_awaiter(const event &event_, const Executor &executor = Executor())
+        : m_event(event_),
+          m_executor(executor),
+          m_status(CL_COMPLETE)
+    {
+    }
+
+    bool await_ready() const
+    {
+        return m_event.status() == CL_COMPLETE;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        detail::set_status_callback(m_event, [this, handle](cl_int status){
+            m_status = status;
+            m_executor(boost::function<void()>([handle](){ handle.resume(); }));
+        });
+    }
+
+    void await_resume() const
+    {
+        if(m_status < 0){
+            BOOST_THROW_EXCEPTION(opencl_error(m_status));
+        }
+    }
+
+private:
+    event m_event;
+    Executor m_executor;
+    cl_int m_status;
+};
+
+/// \class future_awaiter
+/// \brief Suspends a C++20 coroutine until a future is ready and returns
+///        its result.
+///
+/// \see event_awaiter
+template<class T, class Executor = inline_executor>
+class future_awaiter : public event_awaiter<Executor>
+{
+public:
+    explicit future_awaiter(const future<T> &future_, const Executor &executor = Executor())
+        : event_awaiter<Executor>(future_.get_event(), executor),
+          m_future(future_)
+    {
+    }
+
+    T await_resume()
+    {
+        event_awaiter<Executor>::await_resume();
+
+        return m_future.get();
+    }
+
+private:
+    future<T> m_future;
+};
+
+/// Returns an awaiter which suspends the coroutine until \p event has
+/// completed.
+inline event_awaiter<> operator co_await(const event &event_)
+{
+    return event_awaiter<>(event_);
+}
+
+/// Returns an awaiter which suspends the coroutine until \p future is
+/// ready and then returns its result.
+template<class T>
+inline future_awaiter<T> operator co_await(const future<T> &future_)
+{
+    return future_awaiter<T>(future_);
+}
+
+/// Returns an awaiter for \p event which resumes the coroutine with
+/// \p executor.
+template<class Executor>
+inline event_awaiter<Executor> resume_on(const event &event_, const Executor &executor)
+{
+    return event_awaiter<Executor>(event_, executor);
+}
+
+/// Returns an awaiter for \p future which resumes the coroutine with
+/// \p executor.
+template<class T, class Executor>
+inline future_awaiter<T, Executor> resume_on(const future<T> &future_, const Executor &executor)
+{
+    return future_awaiter<T, Executor>(future_, executor);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_HAVE_COROUTINES
+
+#endif // BOOST_COMPUTE_ASYNC_COROUTINE_HPP
@@ -0,0 +1,38 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ASYNC_DETAIL_ATOMIC_COUNT_HPP
+#define BOOST_COMPUTE_ASYNC_DETAIL_ATOMIC_COUNT_HPP
+
+#include <boost/config.hpp>
+
+#ifndef BOOST_NO_CXX11_HDR_ATOMIC
+#  include <atomic>
+#else
+#  include <boost/atomic.hpp>
+#endif
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// counter shared by event callbacks which may run concurrently on the
+// OpenCL runtime's threads
+#ifndef BOOST_NO_CXX11_HDR_ATOMIC
+typedef std::atomic<long> atomic_count;
+#else
+typedef boost::atomic<long> atomic_count;
+#endif
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ASYNC_DETAIL_ATOMIC_COUNT_HPP
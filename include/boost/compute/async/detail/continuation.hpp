@@ -0,0 +1,218 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ASYNC_DETAIL_CONTINUATION_HPP
+#define BOOST_COMPUTE_ASYNC_DETAIL_CONTINUATION_HPP
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/utility/result_of.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/user_event.hpp>
+#include <boost/compute/async/future.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+#if defined(CL_VERSION_1_1)
+// invokes the boost::function<void(cl_int)> in user_data with the status
+// the event completed with (negative if it terminated abnormally)
+inline void BOOST_COMPUTE_CL_CALLBACK
+event_status_callback_invoker(cl_event, cl_int status, void *user_data)
+{
+    boost::function<void(cl_int)> *callback =
+        static_cast<boost::function<void(cl_int)> *>(user_data);
+
+    (*callback)(status);
+
+    delete callback;
+}
+
+// registers callback to be called with the event's status once it has
+// completed. the callback runs on a thread owned by the OpenCL runtime.
+inline void set_status_callback(event event_,
+                                const boost::function<void(cl_int)> &callback)
+{
+    boost::function<void(cl_int)> *callback_ =
+        new boost::function<void(cl_int)>(callback);
+
+    try {
+        event_.set_callback(event_status_callback_invoker, CL_COMPLETE, callback_);
+    }
+    catch(...){
+        delete callback_;
+        throw;
+    }
+}
+
+// returns the context the event was created in
+inline context get_event_context(const event &event_)
+{
+    return context(event_.get_info<cl_context>(CL_EVENT_CONTEXT));
+}
+
+// stores the value returned by (or the exception thrown from) a
+// continuation until it is retrieved by future::get()
+template<class R>
+struct continuation_result
+{
+    template<class Function, class Future>
+    void run(Function &function, Future &future_)
+    {
+        value = function(future_);
+    }
+
+    R get() const
+    {
+        if(exception){
+            boost::rethrow_exception(exception);
+        }
+
+        return value;
+    }
+
+    R value;
+    boost::exception_ptr exception;
+};
+
+template<>
+struct continuation_result<void>
+{
+    template<class Function, class Future>
+    void run(Function &function, Future &future_)
+    {
+        function(future_);
+    }
+
+    void get() const
+    {
+        if(exception){
+            boost::rethrow_exception(exception);
+        }
+    }
+
+    boost::exception_ptr exception;
+};
+
+template<class R>
+struct continuation_result_reader
+{
+    continuation_result_reader(const boost::shared_ptr<continuation_result<R> > &result)
+        : m_result(result)
+    {
+    }
+
+    R operator()() const
+    {
+        return m_result->get();
+    }
+
+    boost::shared_ptr<continuation_result<R> > m_result;
+};
+
+// runs the continuation and then completes its user event
+template<class T, class Function, class R>
+struct continuation_task
+{
+    continuation_task(const future<T> &future_,
+                      const Function &function,
+                      const boost::shared_ptr<continuation_result<R> > &result,
+                      const user_event &completion)
+        : m_future(future_),
+          m_function(function),
+          m_result(result),
+          m_completion(completion)
+    {
+    }
+
+    void operator()()
+    {
+        try {
+            m_result->run(m_function, m_future);
+        }
+        catch(...){
+            m_result->exception = boost::current_exception();
+        }
+
+        m_completion.set_status(CL_COMPLETE);
+    }
+
+    future<T> m_future;
+    Function m_function;
+    boost::shared_ptr<continuation_result<R> > m_result;
+    user_event m_completion;
+};
+
+// called when the antecedent event completes, hands the task to the
+// executor or propagates an error status to the continuation's event
+template<class Task, class Executor>
+struct continuation_callback
+{
+    continuation_callback(const Task &task, const Executor &executor)
+        : m_task(task),
+          m_executor(executor)
+    {
+    }
+
+    void operator()(cl_int status)
+    {
+        if(status < 0){
+            m_task.m_completion.set_status(status);
+        }
+        else {
+            m_executor(boost::function<void()>(m_task));
+        }
+    }
+
+    Task m_task;
+    Executor m_executor;
+};
+
+template<class T, class Function, class Executor>
+struct continuation
+{
+    typedef typename boost::result_of<Function(future<T> &)>::type result_type;
+    typedef continuation_task<T, Function, result_type> task_type;
+
+    static future<result_type> make(const future<T> &future_,
+                                    const Function &function,
+                                    const Executor &executor)
+    {
+        BOOST_ASSERT(future_.valid());
+
+        user_event completion(get_event_context(future_.get_event()));
+
+        boost::shared_ptr<continuation_result<result_type> >
+            result(new continuation_result<result_type>());
+
+        set_status_callback(
+            future_.get_event(),
+            continuation_callback<task_type, Executor>(
+                task_type(future_, function, result, completion), executor
+            )
+        );
+
+        return future<result_type>(
+            completion, continuation_result_reader<result_type>(result)
+        );
+    }
+};
+#endif // CL_VERSION_1_1
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ASYNC_DETAIL_CONTINUATION_HPP
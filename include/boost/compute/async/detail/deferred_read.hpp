@@ -0,0 +1,119 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ASYNC_DETAIL_DEFERRED_READ_HPP
+#define BOOST_COMPUTE_ASYNC_DETAIL_DEFERRED_READ_HPP
+
+#include <iterator>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <boost/compute/event.hpp>
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/command_queue.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// function object which returns a single value of type Stored read from a
+// device buffer as a T. used by the async algorithms to keep their results
+// off the host until future<T>::get() is called.
+//
+// the value is read with a non-blocking read into host memory owned by the
+// function object. once the read's event (get_event()) has completed,
+// calling the function object does not call into OpenCL, so futures holding
+// it can be resolved from event callbacks (see future::then()).
+template<class T, class Stored = T>
+struct deferred_read
+{
+    typedef T result_type;
+
+    deferred_read(const buffer &buffer, size_t index, command_queue &queue)
+        : m_storage(new storage())
+    {
+        m_storage->read = queue.enqueue_read_buffer_async(
+            buffer, index * sizeof(Stored), sizeof(Stored), &m_storage->value
+        );
+    }
+
+    // returns the event of the read
+    const event& get_event() const
+    {
+        return m_storage->read;
+    }
+
+    T operator()() const
+    {
+        return static_cast<T>(m_storage->value);
+    }
+
+    // host memory the value is read into. it is only released after the
+    // read has finished writing to it.
+    struct storage : boost::noncopyable
+    {
+        ~storage()
+        {
+            if(read.get() && read.status() > CL_COMPLETE){
+                try {
+                    read.wait();
+                }
+                catch(...){
+                }
+            }
+        }
+
+        Stored value;
+        event read;
+    };
+
+    boost::shared_ptr<storage> m_storage;
+};
+
+// function object which returns iterator advanced by a count stored in
+// a device buffer
+template<class Iterator, class Stored>
+struct deferred_advance
+{
+    typedef Iterator result_type;
+
+    deferred_advance(const Iterator &iterator,
+                     const buffer &buffer,
+                     size_t index,
+                     command_queue &queue)
+        : m_iterator(iterator),
+          m_count(buffer, index, queue)
+    {
+    }
+
+    // returns the event of the read of the count
+    const event& get_event() const
+    {
+        return m_count.get_event();
+    }
+
+    Iterator operator()() const
+    {
+        typedef typename
+            std::iterator_traits<Iterator>::difference_type difference_type;
+
+        return m_iterator + static_cast<difference_type>(m_count());
+    }
+
+    Iterator m_iterator;
+    deferred_read<Stored> m_count;
+};
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ASYNC_DETAIL_DEFERRED_READ_HPP
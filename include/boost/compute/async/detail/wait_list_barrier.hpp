@@ -0,0 +1,45 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ASYNC_DETAIL_WAIT_LIST_BARRIER_HPP
+#define BOOST_COMPUTE_ASYNC_DETAIL_WAIT_LIST_BARRIER_HPP
+
+#include <boost/compute/wait_list.hpp>
+#include <boost/compute/command_queue.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// makes all commands subsequently enqueued to the (in-order) queue wait for
+// events to complete. on devices older than opencl 1.2 there is no barrier
+// with a wait-list so the host blocks until the events have completed.
+inline void enqueue_wait_list_barrier(command_queue &queue,
+                                      const wait_list &events)
+{
+    if(events.empty()){
+        return;
+    }
+
+    #ifdef CL_VERSION_1_2
+    if(queue.check_device_version(1, 2)){
+        queue.enqueue_barrier(events);
+        return;
+    }
+    #endif // CL_VERSION_1_2
+
+    wait_list(events).wait();
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ASYNC_DETAIL_WAIT_LIST_BARRIER_HPP
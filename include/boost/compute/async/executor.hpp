@@ -0,0 +1,47 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ASYNC_EXECUTOR_HPP
+#define BOOST_COMPUTE_ASYNC_EXECUTOR_HPP
+
+#include <boost/function.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class inline_executor
+/// \brief Runs continuations directly on the thread which completes them.
+///
+/// An executor is any function object which can be called with a
+/// \c boost::function<void()> and arranges for it to be run (e.g. by
+/// posting it to a thread pool or an event loop). Executors are passed to
+/// future::then() and the coroutine awaiters to control where
+/// continuations run.
+///
+/// The inline_executor runs the continuation immediately. When used with
+/// future::then() this is the OpenCL runtime's callback thread, so the
+/// continuation must not call blocking OpenCL functions (e.g. wait on
+/// other events or read buffers). Calling get() on the completed future
+/// passed to the continuation is safe.
+///
+/// \see future::then()
+class inline_executor
+{
+public:
+    void operator()(const boost::function<void()> &function) const
+    {
+        function();
+    }
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ASYNC_EXECUTOR_HPP
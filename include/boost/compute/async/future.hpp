@@ -11,13 +11,34 @@
 #ifndef BOOST_COMPUTE_ASYNC_FUTURE_HPP
 #define BOOST_COMPUTE_ASYNC_FUTURE_HPP
 
+#include <boost/function.hpp>
+#include <boost/utility/result_of.hpp>
+
 #include <boost/compute/event.hpp>
+#include <boost/compute/async/executor.hpp>
 
 namespace boost {
 namespace compute {
+namespace detail {
+
+template<class T, class Function, class Executor>
+struct continuation;
+
+} // end detail namespace
 
 /// \class future
 /// \brief Holds the result of an asynchronous computation.
+///
+/// The result may either be known when the computation is enqueued (e.g.
+/// the end iterator returned by copy_async()) or be computed on the device
+/// (e.g. the value returned by reduce_async()). In the latter case the
+/// result stays in device memory and is only read back by get().
+///
+/// Instead of blocking a host thread in wait() or get(), a continuation
+/// can be attached with then() which is run once the computation has
+/// completed.
+///
+/// \see when_all(), when_any()
 template<class T>
 class future
 {
@@ -33,9 +54,23 @@ public:
     {
     }
 
+    /// \internal_
+    ///
+    /// Creates a future whose result is produced by calling \p deferred
+    /// once \p event has completed (typically to return a value read from
+    /// a device buffer by \p event). \p deferred must not call blocking
+    /// OpenCL functions as it may be called from an event callback.
+    future(const event &event, const boost::function<T()> &deferred)
+        : m_result(),
+          m_event(event),
+          m_deferred(deferred)
+    {
+    }
+
     future(const future<T> &other)
         : m_result(other.m_result),
-          m_event(other.m_event)
+          m_event(other.m_event),
+          m_deferred(other.m_deferred)
     {
     }
 
@@ -44,6 +79,7 @@ public:
         if(this != &other){
             m_result = other.m_result;
             m_event = other.m_event;
+            m_deferred = other.m_deferred;
         }
 
         return *this;
@@ -59,6 +95,11 @@ public:
     {
         wait();
 
+        if(m_deferred){
+            m_result = m_deferred();
+            m_deferred.clear();
+        }
+
         return m_result;
     }
 
@@ -71,7 +112,11 @@ public:
     /// Blocks until the computation is complete.
     void wait() const
     {
-        const_cast<event &>(m_event).wait();
+        // completed events are not waited on so that continuations can
+        // call get() from the event's callback
+        if(m_event.status() != CL_COMPLETE){
+            const_cast<event &>(m_event).wait();
+        }
     }
 
     /// Returns the underlying event object.
@@ -80,9 +125,51 @@ public:
         return m_event;
     }
 
+    /// \internal_
+    const boost::function<T()>& get_deferred() const
+    {
+        return m_deferred;
+    }
+
+    #if defined(CL_VERSION_1_1) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
+    /// Attaches a continuation to the future. Once the computation has
+    /// completed, \p function is called with the future (whose get() method
+    /// then returns without waiting or calling into OpenCL) and its return
+    /// value becomes the result of the returned future. Exceptions thrown
+    /// by \p function are rethrown by the returned future's get() method.
+    ///
+    /// The continuation is run by \p executor on the thread which completes
+    /// the event (see inline_executor). This method does not block.
+    ///
+    /// For example, to post-process the result of a reduction on the host:
+    /// \code
+    /// future<float> sum = reduce_async(vec.begin(), vec.end(), queue);
+    /// future<float> mean = sum.then(divide_by_size, thread_pool_executor);
+    /// \endcode
+    ///
+    /// \opencl_version_warning{1,1}
+    template<class Function, class Executor>
+    future<typename boost::result_of<Function(future<T> &)>::type>
+    then(Function function, Executor executor) const
+    {
+        return detail::continuation<T, Function, Executor>::make(
+            *this, function, executor
+        );
+    }
+
+    /// \overload
+    template<class Function>
+    future<typename boost::result_of<Function(future<T> &)>::type>
+    then(Function function) const
+    {
+        return then(function, inline_executor());
+    }
+    #endif // CL_VERSION_1_1
+
 private:
     T m_result;
     event m_event;
+    boost::function<T()> m_deferred;
 };
 
 /// \internal_
@@ -99,6 +186,11 @@ public:
     future(const future<T> &other)
         : m_event(other.get_event())
     {
+        // keep the deferred part of the result (e.g. a pending read) so
+        // that it still runs when get() is called
+        if(other.get_deferred()){
+            m_deferred = other.get_deferred();
+        }
     }
 
     explicit future(const event &event)
@@ -106,10 +198,20 @@ public:
     {
     }
 
+    future(const event &event, const boost::function<void()> &deferred)
+        : m_event(event),
+          m_deferred(deferred)
+    {
+    }
+
     template<class T>
     future<void> &operator=(const future<T> &other)
     {
         m_event = other.get_event();
+        m_deferred.clear();
+        if(other.get_deferred()){
+            m_deferred = other.get_deferred();
+        }
 
         return *this;
     }
@@ -118,6 +220,7 @@ public:
     {
         if(this != &other){
             m_event = other.m_event;
+            m_deferred = other.m_deferred;
         }
 
         return *this;
@@ -130,6 +233,11 @@ public:
     void get()
     {
         wait();
+
+        if(m_deferred){
+            m_deferred();
+            m_deferred.clear();
+        }
     }
 
     bool valid() const
@@ -139,7 +247,9 @@ public:
 
     void wait() const
     {
-        const_cast<event &>(m_event).wait();
+        if(m_event.status() != CL_COMPLETE){
+            const_cast<event &>(m_event).wait();
+        }
     }
 
     event get_event() const
@@ -147,8 +257,27 @@ public:
         return m_event;
     }
 
+    #if defined(CL_VERSION_1_1)
+    template<class Function, class Executor>
+    future<typename boost::result_of<Function(future<void> &)>::type>
+    then(Function function, Executor executor) const
+    {
+        return detail::continuation<void, Function, Executor>::make(
+            *this, function, executor
+        );
+    }
+
+    template<class Function>
+    future<typename boost::result_of<Function(future<void> &)>::type>
+    then(Function function) const
+    {
+        return then(function, inline_executor());
+    }
+    #endif // CL_VERSION_1_1
+
 private:
     event m_event;
+    boost::function<void()> m_deferred;
 };
 
 /// \internal_
@@ -161,4 +290,6 @@ inline future<Result> make_future(const Result &result, const event &event)
 } // end compute namespace
 } // end boost namespace
 
+#include <boost/compute/async/detail/continuation.hpp>
+
 #endif // BOOST_COMPUTE_ASYNC_FUTURE_HPP
@@ -0,0 +1,380 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ASYNC_TASK_GRAPH_HPP
+#define BOOST_COMPUTE_ASYNC_TASK_GRAPH_HPP
+
+#include <map>
+#include <vector>
+#include <algorithm>
+
+#include <boost/assert.hpp>
+#include <boost/function.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/wait_list.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/async/detail/wait_list_barrier.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class task_graph
+/// \brief Schedules dependent tasks over multiple command queues.
+///
+/// The task_graph class stores a list of tasks along with the buffers
+/// each task reads and writes. Dependencies between tasks are derived
+/// from these sets in the order the tasks were added (read-after-write,
+/// write-after-read and write-after-write) and tasks with no dependency
+/// between them are distributed over the graph's command queues so that
+/// they can execute concurrently. The graph keeps a reference to each
+/// buffer passed to it until it is destroyed.
+///
+/// Each task is a function which enqueues its work (typically one or
+/// more calls to Boost.Compute algorithms) on the command queue it is
+/// passed. For example, to sort two independent columns (which may run
+/// concurrently) and then merge them:
+/// \code
+/// task_graph graph(context, 2);
+///
+/// std::vector<buffer> a(1, column_a.get_buffer());
+/// std::vector<buffer> b(1, column_b.get_buffer());
+/// std::vector<buffer> ab(a);
+/// ab.push_back(column_b.get_buffer());
+/// std::vector<buffer> c(1, result.get_buffer());
+///
+/// graph.add_task(sort_a, a, a);
+/// graph.add_task(sort_b, b, b);
+/// graph.add_task(merge_ab, ab, c);
+///
+/// graph.run().wait();
+/// \endcode
+///
+/// Because the algorithms enqueue several commands which must execute in
+/// order, tasks are run on in-order command queues and dependencies between
+/// tasks on different queues are enforced with event barriers. Creating
+/// the queues for the same device gives the device multiple independent
+/// streams of work, similar to a single out-of-order queue.
+///
+/// Dependencies between tasks on different queues require OpenCL 1.2. On
+/// earlier versions the host waits for them before enqueuing the task.
+///
+/// \see command_queue, wait_list
+class task_graph
+{
+public:
+    typedef size_t task_id;
+    typedef boost::function<void(command_queue &)> function_type;
+
+    /// Creates a task graph which executes all tasks on \p queue.
+    explicit task_graph(const command_queue &queue)
+        : m_queues(1, queue),
+          m_next(0)
+    {
+        m_tails.resize(1);
+        m_loads.resize(1, 0);
+    }
+
+    /// Creates a task graph which distributes tasks over \p queues.
+    explicit task_graph(const std::vector<command_queue> &queues)
+        : m_queues(queues),
+          m_next(0)
+    {
+        BOOST_ASSERT(!m_queues.empty());
+
+        m_tails.resize(m_queues.size());
+        m_loads.resize(m_queues.size(), 0);
+    }
+
+    /// Creates a task graph with \p count in-order command queues for the
+    /// device in \p context.
+    task_graph(const context &context, size_t count)
+        : m_next(0)
+    {
+        BOOST_ASSERT(count > 0);
+
+        for(size_t i = 0; i < count; i++){
+            m_queues.push_back(command_queue(context, context.get_device()));
+        }
+
+        m_tails.resize(count);
+        m_loads.resize(count, 0);
+    }
+
+    /// Destroys the task graph. Tasks which have been run are not waited on.
+    ~task_graph()
+    {
+    }
+
+    /// Adds a task which calls \p function to enqueue its work. The task
+    /// depends on any previously added task which writes a buffer in
+    /// \p reads or which reads or writes a buffer in \p writes.
+    ///
+    /// Returns the id of the new task.
+    task_id add_task(const function_type &function,
+                     const std::vector<buffer> &reads = std::vector<buffer>(),
+                     const std::vector<buffer> &writes = std::vector<buffer>())
+    {
+        const task_id id = m_tasks.size();
+
+        m_tasks.push_back(task());
+        m_tasks.back().function = function;
+
+        std::vector<task_id> &dependencies = m_tasks.back().dependencies;
+
+        // read-after-write
+        for(size_t i = 0; i < reads.size(); i++){
+            buffer_state &state = get_buffer_state(reads[i]);
+            if(state.has_writer){
+                dependencies.push_back(state.writer);
+            }
+        }
+
+        // write-after-read and write-after-write
+        for(size_t i = 0; i < writes.size(); i++){
+            buffer_state &state = get_buffer_state(writes[i]);
+            if(state.has_writer){
+                dependencies.push_back(state.writer);
+            }
+            dependencies.insert(
+                dependencies.end(), state.readers.begin(), state.readers.end()
+            );
+        }
+
+        // update buffer states. writes are recorded after reads so that
+        // a buffer both read and written is tracked as last written by
+        // this task with no outstanding readers
+        for(size_t i = 0; i < reads.size(); i++){
+            get_buffer_state(reads[i]).readers.push_back(id);
+        }
+        for(size_t i = 0; i < writes.size(); i++){
+            buffer_state &state = get_buffer_state(writes[i]);
+            state.has_writer = true;
+            state.writer = id;
+            state.readers.clear();
+        }
+
+        // remove duplicates and self-dependencies
+        std::sort(dependencies.begin(), dependencies.end());
+        dependencies.erase(
+            std::unique(dependencies.begin(), dependencies.end()),
+            dependencies.end()
+        );
+        dependencies.erase(
+            std::remove(dependencies.begin(), dependencies.end(), id),
+            dependencies.end()
+        );
+
+        return id;
+    }
+
+    /// Adds an explicit dependency of task \p after on task \p before. Both
+    /// tasks must already be in the graph, \p before must have been added
+    /// before \p after and \p after must not have been run yet.
+    void add_dependency(task_id before, task_id after)
+    {
+        BOOST_ASSERT(before < after);
+        BOOST_ASSERT(after < m_tasks.size());
+        BOOST_ASSERT(after >= m_next);
+
+        std::vector<task_id> &dependencies = m_tasks[after].dependencies;
+        if(std::find(dependencies.begin(), dependencies.end(), before) ==
+               dependencies.end()){
+            dependencies.push_back(before);
+        }
+    }
+
+    /// Returns the number of tasks in the graph.
+    size_t size() const
+    {
+        return m_tasks.size();
+    }
+
+    /// Returns the tasks which \p id depends on.
+    const std::vector<task_id>& dependencies(task_id id) const
+    {
+        return m_tasks[id].dependencies;
+    }
+
+    /// Returns the index of the command queue task \p id was run on. Only
+    /// valid after the task has been run.
+    size_t queue_index(task_id id) const
+    {
+        BOOST_ASSERT(id < m_next);
+
+        return m_tasks[id].queue;
+    }
+
+    /// Returns the event marking the completion of task \p id. Only valid
+    /// after the task has been run.
+    event get_event(task_id id) const
+    {
+        BOOST_ASSERT(id < m_next);
+
+        return m_tasks[id].marker;
+    }
+
+    /// Enqueues all tasks added since the last call to run() and returns
+    /// an event which completes when every task in the graph has completed.
+    ///
+    /// This method does not block (except for cross-queue dependencies on
+    /// devices older than OpenCL 1.2).
+    event run()
+    {
+        for(; m_next < m_tasks.size(); m_next++){
+            enqueue_task(m_next);
+        }
+
+        for(size_t i = 0; i < m_queues.size(); i++){
+            m_queues[i].flush();
+        }
+
+        // single queue, the last task's marker completes after all tasks
+        if(m_queues.size() == 1){
+            return m_tasks.empty() ? event() : m_tasks.back().marker;
+        }
+
+        wait_list tails;
+        for(size_t i = 0; i < m_tails.size(); i++){
+            if(m_tails[i].has_task){
+                tails.insert(m_tasks[m_tails[i].id].marker);
+            }
+        }
+
+        #ifdef CL_VERSION_1_2
+        if(m_queues[0].check_device_version(1, 2)){
+            event event_ = m_queues[0].enqueue_marker(tails);
+            m_queues[0].flush();
+            return event_;
+        }
+        #endif // CL_VERSION_1_2
+
+        tails.wait();
+        return m_queues[0].enqueue_marker();
+    }
+
+    /// Runs the graph and blocks until all tasks have completed.
+    void wait()
+    {
+        event event_ = run();
+        if(event_.get() != 0){
+            event_.wait();
+        }
+    }
+
+private:
+    struct task
+    {
+        function_type function;
+        std::vector<task_id> dependencies;
+        size_t queue;
+        event marker;
+    };
+
+    struct buffer_state
+    {
+        buffer_state()
+            : has_writer(false),
+              writer(0)
+        {
+        }
+
+        // retained so that the handle is not reused by another buffer
+        // while the graph tracks it
+        buffer memory;
+        bool has_writer;
+        task_id writer;
+        std::vector<task_id> readers;
+    };
+
+    struct queue_tail
+    {
+        queue_tail()
+            : has_task(false),
+              id(0)
+        {
+        }
+
+        bool has_task;
+        task_id id;
+    };
+
+    // returns the state of buffer, which is tracked from its first use
+    buffer_state& get_buffer_state(const buffer &buffer_)
+    {
+        buffer_state &state = m_buffers[buffer_.get()];
+        if(state.memory.get() == 0){
+            state.memory = buffer_;
+        }
+
+        return state;
+    }
+
+    // returns the index of the queue to run task id on
+    size_t select_queue(task_id id) const
+    {
+        const std::vector<task_id> &dependencies = m_tasks[id].dependencies;
+
+        // prefer a queue whose last task is one of our dependencies, the
+        // in-order queue then orders the two tasks without an event wait
+        for(size_t i = dependencies.size(); i > 0; i--){
+            const task &dependency = m_tasks[dependencies[i - 1]];
+            const queue_tail &tail = m_tails[dependency.queue];
+            if(tail.has_task && tail.id == dependencies[i - 1]){
+                return dependency.queue;
+            }
+        }
+
+        // otherwise use the queue with the fewest tasks
+        return static_cast<size_t>(
+            std::min_element(m_loads.begin(), m_loads.end()) - m_loads.begin()
+        );
+    }
+
+    void enqueue_task(task_id id)
+    {
+        task &task_ = m_tasks[id];
+        task_.queue = select_queue(id);
+        command_queue &queue = m_queues[task_.queue];
+
+        // dependencies on other queues must be waited on explicitly
+        wait_list events;
+        for(size_t i = 0; i < task_.dependencies.size(); i++){
+            const task &dependency = m_tasks[task_.dependencies[i]];
+            if(dependency.queue != task_.queue){
+                events.insert(dependency.marker);
+            }
+        }
+
+        detail::enqueue_wait_list_barrier(queue, events);
+
+        task_.function(queue);
+        task_.marker = queue.enqueue_marker();
+
+        m_tails[task_.queue].has_task = true;
+        m_tails[task_.queue].id = id;
+        m_loads[task_.queue]++;
+    }
+
+private:
+    std::vector<command_queue> m_queues;
+    std::vector<task> m_tasks;
+    std::map<cl_mem, buffer_state> m_buffers;
+    std::vector<queue_tail> m_tails;
+    std::vector<size_t> m_loads;
+    task_id m_next;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ASYNC_TASK_GRAPH_HPP
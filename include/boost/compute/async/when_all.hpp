@@ -0,0 +1,126 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ASYNC_WHEN_ALL_HPP
+#define BOOST_COMPUTE_ASYNC_WHEN_ALL_HPP
+
+#include <boost/assert.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <boost/compute/config.hpp>
+#include <boost/compute/user_event.hpp>
+#include <boost/compute/wait_list.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/async/wait.hpp>
+#include <boost/compute/async/detail/atomic_count.hpp>
+#include <boost/compute/async/detail/continuation.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+#if defined(CL_VERSION_1_1)
+struct when_all_state
+{
+    when_all_state(long count, const user_event &completion_)
+        : pending(count),
+          done(0),
+          completion(completion_)
+    {
+    }
+
+    atomic_count pending;
+    atomic_count done;
+    user_event completion;
+};
+
+struct when_all_callback
+{
+    when_all_callback(const boost::shared_ptr<when_all_state> &state)
+        : m_state(state)
+    {
+    }
+
+    void operator()(cl_int status)
+    {
+        // the first error is propagated immediately, otherwise the last
+        // event to complete completes the user event
+        if(status < 0){
+            if(++m_state->done == 1){
+                m_state->completion.set_status(status);
+            }
+        }
+        else if(--m_state->pending == 0 && ++m_state->done == 1){
+            m_state->completion.set_status(CL_COMPLETE);
+        }
+    }
+
+    boost::shared_ptr<when_all_state> m_state;
+};
+#endif // CL_VERSION_1_1
+
+} // end detail namespace
+
+#if defined(CL_VERSION_1_1) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
+/// Returns a future which completes once all of the events in \p events
+/// have completed. If any of the events terminates abnormally, the
+/// returned future completes with its error status.
+///
+/// Unlike wait_list::wait() this does not block. Completion is tracked
+/// with event callbacks so no host thread is needed while waiting. The
+/// returned future can be waited on, chained with future::then() or
+/// passed in the wait-list of further commands.
+///
+/// \p events must not be empty.
+///
+/// \opencl_version_warning{1,1}
+///
+/// \see when_any()
+inline future<void> when_all(const wait_list &events)
+{
+    BOOST_ASSERT(!events.empty());
+
+    user_event completion(detail::get_event_context(events[0]));
+
+    boost::shared_ptr<detail::when_all_state> state(
+        new detail::when_all_state(static_cast<long>(events.size()), completion)
+    );
+
+    for(size_t i = 0; i < events.size(); i++){
+        detail::set_status_callback(events[i], detail::when_all_callback(state));
+    }
+
+    return future<void>(completion);
+}
+
+#ifndef BOOST_COMPUTE_DETAIL_NO_VARIADIC_TEMPLATES
+/// Returns a future which completes once all of \p events have completed.
+/// Events can either be event objects or future objects.
+///
+/// \opencl_version_warning{1,1}
+template<class Event1, class Event2, class... Events>
+inline future<void> when_all(Event1&& event1, Event2&& event2, Events&&... events)
+{
+    wait_list l;
+    detail::insert_events_variadic(
+        l,
+        std::forward<Event1>(event1),
+        std::forward<Event2>(event2),
+        std::forward<Events>(events)...
+    );
+    return when_all(l);
+}
+#endif // BOOST_COMPUTE_DETAIL_NO_VARIADIC_TEMPLATES
+#endif // CL_VERSION_1_1
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ASYNC_WHEN_ALL_HPP
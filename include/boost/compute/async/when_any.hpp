@@ -0,0 +1,136 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ASYNC_WHEN_ANY_HPP
+#define BOOST_COMPUTE_ASYNC_WHEN_ANY_HPP
+
+#include <boost/assert.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <boost/compute/config.hpp>
+#include <boost/compute/user_event.hpp>
+#include <boost/compute/wait_list.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/async/wait.hpp>
+#include <boost/compute/async/detail/atomic_count.hpp>
+#include <boost/compute/async/detail/continuation.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+#if defined(CL_VERSION_1_1)
+struct when_any_state
+{
+    explicit when_any_state(const user_event &completion_)
+        : done(0),
+          index(0),
+          completion(completion_)
+    {
+    }
+
+    atomic_count done;
+    size_t index;
+    user_event completion;
+};
+
+struct when_any_callback
+{
+    when_any_callback(const boost::shared_ptr<when_any_state> &state,
+                      size_t index)
+        : m_state(state),
+          m_index(index)
+    {
+    }
+
+    void operator()(cl_int status)
+    {
+        if(++m_state->done == 1){
+            m_state->index = m_index;
+            m_state->completion.set_status(status < 0 ? status : CL_COMPLETE);
+        }
+    }
+
+    boost::shared_ptr<when_any_state> m_state;
+    size_t m_index;
+};
+
+struct when_any_index_reader
+{
+    explicit when_any_index_reader(const boost::shared_ptr<when_any_state> &state)
+        : m_state(state)
+    {
+    }
+
+    size_t operator()() const
+    {
+        return m_state->index;
+    }
+
+    boost::shared_ptr<when_any_state> m_state;
+};
+#endif // CL_VERSION_1_1
+
+} // end detail namespace
+
+#if defined(CL_VERSION_1_1) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
+/// Returns a future which completes as soon as any of the events in
+/// \p events has completed. The result of the future is the index in
+/// \p events of the first event to complete.
+///
+/// Like when_all() this does not block and uses event callbacks to track
+/// completion.
+///
+/// \p events must not be empty.
+///
+/// \opencl_version_warning{1,1}
+///
+/// \see when_all()
+inline future<size_t> when_any(const wait_list &events)
+{
+    BOOST_ASSERT(!events.empty());
+
+    user_event completion(detail::get_event_context(events[0]));
+
+    boost::shared_ptr<detail::when_any_state> state(
+        new detail::when_any_state(completion)
+    );
+
+    for(size_t i = 0; i < events.size(); i++){
+        detail::set_status_callback(events[i], detail::when_any_callback(state, i));
+    }
+
+    return future<size_t>(completion, detail::when_any_index_reader(state));
+}
+
+#ifndef BOOST_COMPUTE_DETAIL_NO_VARIADIC_TEMPLATES
+/// Returns a future which completes as soon as any of \p events has
+/// completed. Events can either be event objects or future objects.
+///
+/// \opencl_version_warning{1,1}
+template<class Event1, class Event2, class... Events>
+inline future<size_t> when_any(Event1&& event1, Event2&& event2, Events&&... events)
+{
+    wait_list l;
+    detail::insert_events_variadic(
+        l,
+        std::forward<Event1>(event1),
+        std::forward<Event2>(event2),
+        std::forward<Events>(events)...
+    );
+    return when_any(l);
+}
+#endif // BOOST_COMPUTE_DETAIL_NO_VARIADIC_TEMPLATES
+#endif // CL_VERSION_1_1
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ASYNC_WHEN_ANY_HPP
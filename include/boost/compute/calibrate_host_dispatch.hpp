@@ -0,0 +1,151 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CALIBRATE_HOST_DISPATCH_HPP
+#define BOOST_COMPUTE_CALIBRATE_HOST_DISPATCH_HPP
+
+#include <vector>
+#include <cstdlib>
+#include <algorithm>
+
+#include <boost/config.hpp>
+
+#if !defined(BOOST_NO_CXX11_HDR_CHRONO) && !defined(BOOST_NO_0X_HDR_CHRONO)
+#include <chrono>
+#else
+// requires linking with boost.chrono
+#include <boost/chrono/chrono.hpp>
+#endif
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/host_dispatch.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/count.hpp>
+#include <boost/compute/algorithm/find.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/container/vector.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// returns the current time in seconds
+inline double host_dispatch_clock()
+{
+#if !defined(BOOST_NO_CXX11_HDR_CHRONO) && !defined(BOOST_NO_0X_HDR_CHRONO)
+    typedef std::chrono::steady_clock clock;
+    return std::chrono::duration<double>(clock::now().time_since_epoch()).count();
+#else
+    typedef boost::chrono::steady_clock clock;
+    return boost::chrono::duration<double>(clock::now().time_since_epoch()).count();
+#endif
+}
+
+// returns the best of several runs of algorithm on size values
+inline double time_host_dispatch(host_dispatch::algorithm algorithm,
+                                 const std::vector<int_> &host_data,
+                                 vector<int_> &device_data,
+                                 size_t size,
+                                 command_queue &queue)
+{
+    const size_t runs = 3;
+
+    double best = 0;
+    for(size_t run = 0; run < runs; run++){
+        // restore the unsorted values
+        copy(host_data.begin(), host_data.begin() + size, device_data.begin(), queue);
+        queue.finish();
+
+        const double start = host_dispatch_clock();
+        switch(algorithm){
+        case host_dispatch::sort_algorithm:
+            sort(device_data.begin(), device_data.begin() + size, queue);
+            queue.finish();
+            break;
+        case host_dispatch::count_algorithm:
+            // the values are non-negative so the whole range is read
+            (void) count(device_data.begin(), device_data.begin() + size, -1, queue);
+            break;
+        case host_dispatch::find_algorithm:
+            (void) find(device_data.begin(), device_data.begin() + size, -1, queue);
+            break;
+        default:
+            break;
+        }
+        const double elapsed = host_dispatch_clock() - start;
+
+        if(run == 0 || elapsed < best){
+            best = elapsed;
+        }
+    }
+
+    return best;
+}
+
+} // end detail namespace
+
+/// Measures the input size at which running each algorithm supported by
+/// host_dispatch on the device of \p queue becomes faster than running it
+/// on the host, and sets the thresholds of the device to the results.
+///
+/// Every algorithm is timed on both the host and the device for sizes
+/// doubling from 4 to \p max_size and its threshold is set to the largest
+/// size before the device is first faster. The measurement takes a few
+/// seconds and its results depend on the load of the system, so it should
+/// be run once (e.g. at startup) rather than before each use. While it
+/// runs the thresholds of the device change for all threads.
+///
+/// \see host_dispatch
+inline void calibrate_host_dispatch(command_queue &queue,
+                                    size_t max_size = size_t(1) << 18)
+{
+    const device &device = queue.get_device();
+
+    std::vector<int_> host_data(max_size);
+    for(size_t i = 0; i < max_size; i++){
+        host_data[i] = static_cast<int_>(std::rand());
+    }
+    vector<int_> device_data(max_size, queue.get_context());
+
+    for(size_t i = 0; i < host_dispatch::algorithm_count; i++){
+        const host_dispatch::algorithm algorithm =
+            static_cast<host_dispatch::algorithm>(i);
+
+        // build the kernels for the device before timing them
+        host_dispatch::set_threshold(device, algorithm, 0);
+        detail::time_host_dispatch(algorithm, host_data, device_data, max_size, queue);
+
+        size_t threshold = 0;
+        for(size_t size = 4; size <= max_size; size *= 2){
+            host_dispatch::set_threshold(device, algorithm, size);
+            const double host_time = detail::time_host_dispatch(
+                algorithm, host_data, device_data, size, queue
+            );
+
+            host_dispatch::set_threshold(device, algorithm, 0);
+            const double device_time = detail::time_host_dispatch(
+                algorithm, host_data, device_data, size, queue
+            );
+
+            if(device_time < host_time){
+                break;
+            }
+
+            threshold = size;
+        }
+
+        host_dispatch::set_threshold(device, algorithm, threshold);
+    }
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_CALIBRATE_HOST_DISPATCH_HPP
@@ -21,7 +21,11 @@
 #include <boost/compute/container/flat_map.hpp>
 #include <boost/compute/container/flat_set.hpp>
 #include <boost/compute/container/mapped_view.hpp>
+#include <boost/compute/container/packed_vector.hpp>
+#include <boost/compute/container/rank_select_index.hpp>
 #include <boost/compute/container/string.hpp>
+#include <boost/compute/container/unordered_map.hpp>
+#include <boost/compute/container/unordered_set.hpp>
 #include <boost/compute/container/vector.hpp>
 
 #endif // BOOST_COMPUTE_CONTAINER_HPP
@@ -0,0 +1,256 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CONTAINER_DETAIL_FLAT_BULK_OPS_HPP
+#define BOOST_COMPUTE_CONTAINER_DETAIL_FLAT_BULK_OPS_HPP
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/algorithm/fill_n.hpp>
+#include <boost/compute/algorithm/gather.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/sort_by_key.hpp>
+#include <boost/compute/algorithm/detail/batched_binary_search.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+#include <boost/compute/iterator/transform_iterator.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// key function for containers whose values are their keys (flat_set)
+struct flat_identity_key
+{
+};
+
+template<class Iterator>
+inline Iterator make_flat_key_iterator(Iterator iter, flat_identity_key)
+{
+    return iter;
+}
+
+template<class Iterator, class KeyFunction>
+inline transform_iterator<Iterator, KeyFunction>
+make_flat_key_iterator(Iterator iter, KeyFunction get_key)
+{
+    return ::boost::compute::make_transform_iterator(iter, get_key);
+}
+
+// copies the values in [first, first + count) whose flag is set to result.
+// flags must have count + 1 elements with the last one set to zero. the
+// flags are overwritten with their exclusive scan. returns the number of
+// values copied.
+template<class InputIterator, class OutputIterator>
+inline size_t flat_compact(InputIterator first,
+                           vector<uint_> &flags,
+                           OutputIterator result,
+                           command_queue &queue)
+{
+    const size_t count = flags.size() - 1;
+
+    ::boost::compute::exclusive_scan(
+        flags.begin(), flags.end(), flags.begin(), queue
+    );
+
+    meta_kernel k("flat_compact");
+    k << "const uint i = get_global_id(0);\n"
+      << "const uint dst = " << flags.begin()[k.var<uint_>("i")] << ";\n"
+      << "if(dst != " << flags.begin()[k.expr<uint_>("i+1")] << "){\n"
+      << "    " << result[k.var<uint_>("dst")] << " = "
+      <<          first[k.var<uint_>("i")] << ";\n"
+      << "}\n";
+    k.exec_1d(queue, 0, count);
+
+    return read_single_value<uint_>(flags.get_buffer(), count, queue);
+}
+
+// moves each value in [first, first + count) to its position in a merged
+// range given its rank (the number of values from the other range which
+// precede it): result[i + ranks[i]] = first[i]
+template<class InputIterator, class OutputIterator>
+inline void flat_scatter_by_rank(InputIterator first,
+                                 vector<uint_>::iterator ranks,
+                                 size_t count,
+                                 OutputIterator result,
+                                 command_queue &queue)
+{
+    if(count == 0){
+        return;
+    }
+
+    meta_kernel k("flat_scatter_by_rank");
+    k << "const uint i = get_global_id(0);\n"
+      << "const uint dst = i + " << ranks[k.var<uint_>("i")] << ";\n"
+      << result[k.var<uint_>("dst")] << " = " << first[k.var<uint_>("i")] << ";\n";
+    k.exec_1d(queue, 0, count);
+}
+
+// inserts the values in batch into storage which is sorted by key and
+// holds unique keys. values whose key is already in storage are not
+// inserted. if a key occurs more than once in batch it is unspecified
+// which of the values is inserted.
+//
+// the batch is sorted by key and reduced to its new unique keys. the two
+// sorted ranges are then merged by ranking each value against the other
+// range with a batched binary search, which is fully parallel and needs no
+// comparison operator for the values themselves.
+template<class Key, class T, class KeyFunction>
+inline void flat_insert_unique(vector<T> &storage,
+                               const vector<T> &batch,
+                               KeyFunction get_key,
+                               command_queue &queue)
+{
+    const context &context = queue.get_context();
+    const size_t count = batch.size();
+    if(count == 0){
+        return;
+    }
+
+    // sort the batch by key
+    vector<Key> keys(count, context);
+    ::boost::compute::copy(
+        make_flat_key_iterator(batch.begin(), get_key),
+        make_flat_key_iterator(batch.end(), get_key),
+        keys.begin(),
+        queue
+    );
+
+    vector<uint_> permutation(count, context);
+    ::boost::compute::iota(permutation.begin(), permutation.end(), uint_(0), queue);
+    ::boost::compute::sort_by_key(keys.begin(), keys.end(), permutation.begin(), queue);
+
+    vector<T> sorted(count, context);
+    ::boost::compute::gather(
+        permutation.begin(), permutation.end(), batch.begin(), sorted.begin(), queue
+    );
+
+    // keep the first value of each run of equal keys not already in storage
+    vector<uint_> flags(count + 1, context);
+    batched_binary_search(
+        make_flat_key_iterator(storage.begin(), get_key),
+        make_flat_key_iterator(storage.end(), get_key),
+        keys.begin(),
+        keys.end(),
+        flags.begin(),
+        batched_contains,
+        queue
+    );
+
+    meta_kernel k("flat_insert_flags");
+    k << "const uint i = get_global_id(0);\n"
+      << flags.begin()[k.var<uint_>("i")] << " = !"
+      << flags.begin()[k.var<uint_>("i")] << " && (i == 0 || "
+      << keys.begin()[k.var<uint_>("i")] << " != "
+      << keys.begin()[k.expr<uint_>("i-1")] << ");\n";
+    k.exec_1d(queue, 0, count);
+    ::boost::compute::fill_n(flags.end() - 1, 1, uint_(0), queue);
+
+    vector<T> inserted(count, context);
+    const size_t inserted_count =
+        flat_compact(sorted.begin(), flags, inserted.begin(), queue);
+    if(inserted_count == 0){
+        return;
+    }
+
+    ::boost::compute::copy(
+        make_flat_key_iterator(inserted.begin(), get_key),
+        make_flat_key_iterator(inserted.begin() + inserted_count, get_key),
+        keys.begin(),
+        queue
+    );
+
+    // merge. keys are unique across both ranges so the ranks are exact
+    const size_t size = storage.size();
+    vector<T> merged(size + inserted_count, context);
+    vector<uint_> ranks((std::max)(size, inserted_count), context);
+
+    batched_binary_search(
+        keys.begin(),
+        keys.begin() + inserted_count,
+        make_flat_key_iterator(storage.begin(), get_key),
+        make_flat_key_iterator(storage.end(), get_key),
+        ranks.begin(),
+        batched_lower_bound,
+        queue
+    );
+    flat_scatter_by_rank(storage.begin(), ranks.begin(), size, merged.begin(), queue);
+
+    batched_binary_search(
+        make_flat_key_iterator(storage.begin(), get_key),
+        make_flat_key_iterator(storage.end(), get_key),
+        keys.begin(),
+        keys.begin() + inserted_count,
+        ranks.begin(),
+        batched_lower_bound,
+        queue
+    );
+    flat_scatter_by_rank(inserted.begin(), ranks.begin(), inserted_count, merged.begin(), queue);
+
+    storage.swap(merged);
+}
+
+// removes the values whose key is in [first, last) from storage which is
+// sorted by key. returns the number of values removed.
+template<class Key, class T, class KeyFunction, class KeyIterator>
+inline size_t flat_erase_keys(vector<T> &storage,
+                              KeyIterator first,
+                              KeyIterator last,
+                              KeyFunction get_key,
+                              command_queue &queue)
+{
+    const context &context = queue.get_context();
+    const size_t size = storage.size();
+    if(size == 0 || first == last){
+        return 0;
+    }
+
+    vector<Key> keys(first, last, queue);
+    ::boost::compute::sort(keys.begin(), keys.end(), queue);
+
+    // flag the values to keep
+    vector<uint_> flags(size + 1, context);
+    batched_binary_search(
+        keys.begin(),
+        keys.end(),
+        make_flat_key_iterator(storage.begin(), get_key),
+        make_flat_key_iterator(storage.end(), get_key),
+        flags.begin(),
+        batched_contains,
+        queue
+    );
+
+    meta_kernel k("flat_erase_flags");
+    k << "const uint i = get_global_id(0);\n"
+      << flags.begin()[k.var<uint_>("i")] << " = !"
+      << flags.begin()[k.var<uint_>("i")] << ";\n";
+    k.exec_1d(queue, 0, size);
+    ::boost::compute::fill_n(flags.end() - 1, 1, uint_(0), queue);
+
+    vector<T> kept(size, context);
+    const size_t kept_count = flat_compact(storage.begin(), flags, kept.begin(), queue);
+    if(kept_count == size){
+        return 0;
+    }
+
+    kept.resize(kept_count, queue);
+    storage.swap(kept);
+
+    return size - kept_count;
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_CONTAINER_DETAIL_FLAT_BULK_OPS_HPP
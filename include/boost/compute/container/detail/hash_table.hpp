@@ -0,0 +1,488 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CONTAINER_DETAIL_HASH_TABLE_HPP
+#define BOOST_COMPUTE_CONTAINER_DETAIL_HASH_TABLE_HPP
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/context.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/detail/scalar.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/functional/atomic.hpp>
+#include <boost/compute/functional/hash.hpp>
+#include <boost/compute/iterator/discard_iterator.hpp>
+#include <boost/compute/types/builtin.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// default reserved keys marking empty and erased slots. these keys can not
+// be stored in the table.
+template<class Key>
+struct hash_table_key_traits
+{
+    static Key empty_key()
+    {
+        return (std::numeric_limits<Key>::max)();
+    }
+
+    static Key deleted_key()
+    {
+        return (std::numeric_limits<Key>::max)() - 1;
+    }
+};
+
+// what the lookup kernel writes for each query
+enum hash_table_lookup_mode {
+    hash_table_contains,
+    hash_table_find_value,
+    hash_table_erase
+};
+
+// open-addressing hash table with linear probing stored in device memory.
+// keys are claimed with atomic compare-and-swap so each bulk operation is a
+// single kernel with one work-item per key. erased slots are marked with a
+// tombstone which is only reclaimed when the table is rehashed.
+//
+// the table stores keys in one buffer and (if HasValues is true) the
+// mapped values in a second buffer at the same slot index.
+template<class Key, class T, bool HasValues>
+class hash_table
+{
+public:
+    typedef Key key_type;
+    typedef size_t size_type;
+
+    // atomic compare-and-swap is only available for 32-bit integers
+    BOOST_STATIC_ASSERT_MSG(
+        sizeof(Key) == 4 && std::numeric_limits<Key>::is_integer,
+        "hash table keys must be 32-bit integers"
+    );
+
+    hash_table(size_type bucket_count,
+               const Key &empty_key,
+               const Key &deleted_key,
+               const context &context)
+        : m_keys(context),
+          m_values(context),
+          m_size(0),
+          m_used(0),
+          m_max_load_factor(0.5f),
+          m_empty_key(empty_key),
+          m_deleted_key(deleted_key)
+    {
+        BOOST_ASSERT(empty_key != deleted_key);
+
+        command_queue queue = m_keys.default_queue();
+        allocate(round_bucket_count(bucket_count), m_keys, m_values, queue);
+        queue.finish();
+    }
+
+    hash_table(const hash_table &other)
+        : m_keys(other.m_keys),
+          m_values(other.m_values),
+          m_size(other.m_size),
+          m_used(other.m_used),
+          m_max_load_factor(other.m_max_load_factor),
+          m_empty_key(other.m_empty_key),
+          m_deleted_key(other.m_deleted_key)
+    {
+    }
+
+    hash_table& operator=(const hash_table &other)
+    {
+        if(this != &other){
+            m_keys = other.m_keys;
+            m_values = other.m_values;
+            m_size = other.m_size;
+            m_used = other.m_used;
+            m_max_load_factor = other.m_max_load_factor;
+            m_empty_key = other.m_empty_key;
+            m_deleted_key = other.m_deleted_key;
+        }
+
+        return *this;
+    }
+
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    size_type bucket_count() const
+    {
+        return m_keys.size();
+    }
+
+    float load_factor() const
+    {
+        return static_cast<float>(m_size) / static_cast<float>(bucket_count());
+    }
+
+    float max_load_factor() const
+    {
+        return m_max_load_factor;
+    }
+
+    void max_load_factor(float factor)
+    {
+        BOOST_ASSERT(factor > 0.f && factor < 1.f);
+
+        m_max_load_factor = factor;
+    }
+
+    key_type empty_key() const
+    {
+        return m_empty_key;
+    }
+
+    key_type deleted_key() const
+    {
+        return m_deleted_key;
+    }
+
+    void clear(command_queue &queue)
+    {
+        ::boost::compute::fill(m_keys.begin(), m_keys.end(), m_empty_key, queue);
+        m_size = 0;
+        m_used = 0;
+    }
+
+    // rebuilds the table with at least count buckets (and enough buckets
+    // to hold the current elements), dropping all tombstones
+    void rehash(size_type count, command_queue &queue)
+    {
+        const size_type needed =
+            static_cast<size_type>(std::ceil(m_size / m_max_load_factor)) + 1;
+        const size_type buckets = round_bucket_count((std::max)(count, needed));
+
+        vector<Key> keys(m_keys.get_buffer().get_context());
+        vector<T> values(m_keys.get_buffer().get_context());
+        allocate(buckets, keys, values, queue);
+
+        m_size = insert_into(
+            keys, values, m_keys.begin(), m_values.begin(), m_keys.size(), queue
+        );
+        m_used = m_size;
+
+        m_keys.swap(keys);
+        m_values.swap(values);
+    }
+
+    // makes room for count elements without exceeding the max load factor
+    void reserve(size_type count, command_queue &queue)
+    {
+        const size_type buckets =
+            static_cast<size_type>(std::ceil(count / m_max_load_factor)) + 1;
+
+        if(buckets > bucket_count()){
+            rehash(buckets, queue);
+        }
+    }
+
+    // inserts count keys (and values) and returns the number inserted
+    template<class KeyIterator, class ValueIterator>
+    size_type insert(KeyIterator keys,
+                     ValueIterator values,
+                     size_type count,
+                     command_queue &queue)
+    {
+        if(count == 0){
+            return 0;
+        }
+
+        // tombstones count against the load factor as they lengthen probes
+        const size_type limit =
+            static_cast<size_type>(m_max_load_factor * bucket_count());
+        if(m_used + count > limit){
+            rehash(
+                static_cast<size_type>(std::ceil((m_size + count) / m_max_load_factor)) + 1,
+                queue
+            );
+        }
+
+        const size_type inserted =
+            insert_into(m_keys, m_values, keys, values, count, queue);
+        m_size += inserted;
+        m_used += inserted;
+
+        return inserted;
+    }
+
+    // inserts count keys into a table without values and returns the
+    // number inserted
+    template<class KeyIterator>
+    size_type insert(KeyIterator keys, size_type count, command_queue &queue)
+    {
+        BOOST_STATIC_ASSERT_MSG(
+            !HasValues, "tables with values must insert keys with values"
+        );
+
+        return insert(keys, discard_iterator(), count, queue);
+    }
+
+    // erases count keys and returns the number erased
+    template<class KeyIterator>
+    size_type erase(KeyIterator keys, size_type count, command_queue &queue)
+    {
+        const size_type erased = lookup(
+            keys, count, discard_iterator(), T(), hash_table_erase, queue
+        );
+        m_size -= erased;
+
+        return erased;
+    }
+
+    // runs a lookup kernel for each of count keys and returns the number of
+    // keys found (and erased in erase mode)
+    template<class KeyIterator, class OutputIterator>
+    size_type lookup(KeyIterator keys,
+                     size_type count,
+                     OutputIterator result,
+                     const T &missing,
+                     hash_table_lookup_mode mode,
+                     command_queue &queue) const
+    {
+        if(count == 0){
+            return 0;
+        }
+
+        meta_kernel k("hash_table_lookup");
+        const size_t mask_arg = k.add_arg<const uint_>("mask");
+        const size_t empty_arg = k.add_arg<const Key>("empty_key");
+        const size_t deleted_arg = k.add_arg<const Key>("deleted_key");
+        const size_t table_arg =
+            k.add_arg<Key *>(memory_object::global_memory, "table");
+        const size_t counter_arg =
+            k.add_arg<uint_ *>(memory_object::global_memory, "counter");
+
+        k << "const uint i = get_global_id(0);\n"
+          << k.decl<Key>("key") << " = " << keys[k.var<uint_>("i")] << ";\n"
+          << "uint slot = (uint) "
+          <<     ::boost::compute::hash<Key>()(k.var<Key>("key")) << " & mask;\n"
+          << "int found = 0;\n"
+          << "if(key != empty_key && key != deleted_key){\n"
+          << "    for(uint probe = 0; probe <= mask; probe++){\n"
+          << "        " << k.decl<Key>("current") << " = table[slot];\n"
+          << "        if(current == key){\n"
+          << "            found = 1;\n"
+          << "            break;\n"
+          << "        }\n"
+          << "        if(current == empty_key){\n"
+          << "            break;\n"
+          << "        }\n"
+          << "        slot = (slot + 1) & mask;\n"
+          << "    }\n"
+          << "}\n";
+
+        if(mode == hash_table_erase){
+            k << "if(found && "
+              <<     atomic_cmpxchg<Key>()(
+                         k.expr<Key *>("table + slot"),
+                         k.var<Key>("key"),
+                         k.var<Key>("deleted_key")
+                     ) << " == key){\n"
+              << "    " << atomic_inc<uint_>()(k.var<uint_ *>("counter")) << ";\n"
+              << "}\n";
+        }
+        else {
+            k << "if(found){\n"
+              << "    " << atomic_inc<uint_>()(k.var<uint_ *>("counter")) << ";\n"
+              << "}\n";
+        }
+
+        size_t missing_arg = 0;
+        if(mode == hash_table_contains){
+            k << result[k.var<uint_>("i")] << " = found;\n";
+        }
+        else if(mode == hash_table_find_value){
+            missing_arg = k.add_arg<const T>("missing");
+            k << result[k.var<uint_>("i")] << " = found ? "
+              << m_values.begin()[k.var<uint_>("slot")] << " : missing;\n";
+        }
+
+        scalar<uint_> counter(m_keys.get_buffer().get_context());
+        counter.write(0, queue);
+
+        k.set_arg(mask_arg, static_cast<uint_>(bucket_count() - 1));
+        k.set_arg(empty_arg, m_empty_key);
+        k.set_arg(deleted_arg, m_deleted_key);
+        k.set_arg(table_arg, m_keys.get_buffer());
+        k.set_arg(counter_arg, counter.get_buffer());
+        if(mode == hash_table_find_value){
+            k.set_arg(missing_arg, missing);
+        }
+
+        k.exec_1d(queue, 0, count);
+
+        return counter.read(queue);
+    }
+
+    // adds the table to the arguments of k and emits code which sets the
+    // variable slot to the slot holding the value of the variable key or
+    // to bucket_count() if the key is not in the table
+    void emit_find_slot(meta_kernel &k) const
+    {
+        const size_t table_arg =
+            k.add_arg<Key *>(memory_object::global_memory, "table_keys");
+        k.set_arg(table_arg, m_keys.get_buffer());
+        k.add_set_arg<const uint_>("table_mask", static_cast<uint_>(bucket_count() - 1));
+        k.add_set_arg<const Key>("table_empty_key", m_empty_key);
+        k.add_set_arg<const Key>("table_deleted_key", m_deleted_key);
+
+        k << "uint slot = table_mask + 1;\n"
+          << "if(key != table_empty_key && key != table_deleted_key){\n"
+          << "    uint probe_slot = (uint) "
+          <<         ::boost::compute::hash<Key>()(k.var<Key>("key")) << " & table_mask;\n"
+          << "    for(uint probe = 0; probe <= table_mask; probe++){\n"
+          << "        " << k.decl<Key>("current") << " = table_keys[probe_slot];\n"
+          << "        if(current == key){\n"
+          << "            slot = probe_slot;\n"
+          << "            break;\n"
+          << "        }\n"
+          << "        if(current == table_empty_key){\n"
+          << "            break;\n"
+          << "        }\n"
+          << "        probe_slot = (probe_slot + 1) & table_mask;\n"
+          << "    }\n"
+          << "}\n";
+    }
+
+    const vector<Key>& keys() const
+    {
+        return m_keys;
+    }
+
+    const vector<T>& values() const
+    {
+        return m_values;
+    }
+
+private:
+    static size_type round_bucket_count(size_type count)
+    {
+        size_type buckets = 64;
+        while(buckets < count){
+            buckets *= 2;
+        }
+
+        return buckets;
+    }
+
+    void allocate(size_type buckets,
+                  vector<Key> &keys,
+                  vector<T> &values,
+                  command_queue &queue)
+    {
+        keys.resize(buckets, queue);
+        ::boost::compute::fill(keys.begin(), keys.end(), m_empty_key, queue);
+
+        if(HasValues){
+            values.resize(buckets, queue);
+        }
+    }
+
+    // inserts count keys (and values) into the table stored in table_keys
+    // and table_values. source keys equal to the empty or deleted key are
+    // skipped which allows rehashing directly from another table.
+    template<class KeyIterator, class ValueIterator>
+    size_type insert_into(vector<Key> &table_keys,
+                          vector<T> &table_values,
+                          KeyIterator keys,
+                          ValueIterator values,
+                          size_type count,
+                          command_queue &queue)
+    {
+        if(count == 0){
+            return 0;
+        }
+
+        meta_kernel k("hash_table_insert");
+        const size_t mask_arg = k.add_arg<const uint_>("mask");
+        const size_t empty_arg = k.add_arg<const Key>("empty_key");
+        const size_t deleted_arg = k.add_arg<const Key>("deleted_key");
+        const size_t table_arg =
+            k.add_arg<Key *>(memory_object::global_memory, "table");
+        const size_t counter_arg =
+            k.add_arg<uint_ *>(memory_object::global_memory, "counter");
+
+        k << "const uint i = get_global_id(0);\n"
+          << k.decl<Key>("key") << " = " << keys[k.var<uint_>("i")] << ";\n"
+          << "if(key == empty_key || key == deleted_key){\n"
+          << "    return;\n"
+          << "}\n"
+          << "uint slot = (uint) "
+          <<     ::boost::compute::hash<Key>()(k.var<Key>("key")) << " & mask;\n"
+          << "for(uint probe = 0; probe <= mask; probe++){\n"
+          << "    " << k.decl<Key>("previous") << " = "
+          <<         atomic_cmpxchg<Key>()(
+                         k.expr<Key *>("table + slot"),
+                         k.var<Key>("empty_key"),
+                         k.var<Key>("key")
+                     ) << ";\n"
+          << "    if(previous == empty_key){\n";
+        if(HasValues){
+            k << "        " << table_values.begin()[k.var<uint_>("slot")]
+              << " = " << values[k.var<uint_>("i")] << ";\n";
+        }
+        k << "        " << atomic_inc<uint_>()(k.var<uint_ *>("counter")) << ";\n"
+          << "        return;\n"
+          << "    }\n"
+          << "    if(previous == key){\n"
+          << "        return;\n"
+          << "    }\n"
+          << "    slot = (slot + 1) & mask;\n"
+          << "}\n";
+
+        scalar<uint_> counter(table_keys.get_buffer().get_context());
+        counter.write(0, queue);
+
+        k.set_arg(mask_arg, static_cast<uint_>(table_keys.size() - 1));
+        k.set_arg(empty_arg, m_empty_key);
+        k.set_arg(deleted_arg, m_deleted_key);
+        k.set_arg(table_arg, table_keys.get_buffer());
+        k.set_arg(counter_arg, counter.get_buffer());
+
+        k.exec_1d(queue, 0, count);
+
+        return counter.read(queue);
+    }
+
+private:
+    vector<Key> m_keys;
+    vector<T> m_values;
+    size_type m_size;
+    size_type m_used;
+    float m_max_load_factor;
+    Key m_empty_key;
+    Key m_deleted_key;
+};
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_CONTAINER_DETAIL_HASH_TABLE_HPP
@@ -11,20 +11,35 @@
 #ifndef BOOST_COMPUTE_CONTAINER_DYNAMIC_BITSET_HPP
 #define BOOST_COMPUTE_CONTAINER_DYNAMIC_BITSET_HPP
 
+#include <string>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+
 #include <boost/compute/lambda.hpp>
 #include <boost/compute/algorithm/any_of.hpp>
+#include <boost/compute/algorithm/copy_n.hpp>
 #include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/find_if.hpp>
 #include <boost/compute/algorithm/transform_reduce.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/functional/atomic.hpp>
 #include <boost/compute/functional/integer.hpp>
 #include <boost/compute/types/builtin.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
 
 namespace boost {
 namespace compute {
 
 /// The dynamic_bitset class contains a resizable bit array.
 ///
-/// \see vector<T>
+/// Besides single bit accessors, which each transfer a block to or from
+/// the host, the bitset supports bulk operations which run entirely on the
+/// device: setting, resetting, flipping or testing a vector of positions,
+/// bitwise operations with another bitset, and finding set bits.
+///
+/// \see vector<T>, rank_select_index
 template<class Block = ulong_, class Alloc = buffer_allocator<Block> >
 class dynamic_bitset
 {
@@ -40,7 +55,7 @@ public:
     /// Creates a new dynamic bitset with storage for \p size bits. Initializes
     /// all bits to zero.
     dynamic_bitset(size_type size, command_queue &queue)
-        : m_bits(size / sizeof(block_type), queue.get_context()),
+        : m_bits(block_count(size), queue.get_context()),
           m_size(size)
     {
         // initialize all bits to zero
@@ -115,7 +130,7 @@ public:
     {
         // resize bits
         const size_type current_block_count = m_bits.size();
-        m_bits.resize(num_bits * bits_per_block, queue);
+        m_bits.resize(block_count(num_bits), queue);
 
         // fill new block with zeros (if new blocks were added)
         const size_type new_block_count = m_bits.size();
@@ -150,10 +165,10 @@ public:
 
         // update block value
         if(value){
-            block_value |= (1 << bit);
+            block_value |= (block_type(1) << bit);
         }
         else {
-            block_value &= ~(1 << bit);
+            block_value &= ~(block_type(1) << bit);
         }
 
         // store new block
@@ -169,7 +184,7 @@ public:
         block_type block_value;
         copy_n(m_bits.begin() + block, 1, &block_value, queue);
 
-        return block_value & (1 << bit);
+        return (block_value & (block_type(1) << bit)) != 0;
     }
 
     /// Flips the value of the bit at position \p n.
@@ -210,12 +225,246 @@ public:
         m_bits.clear();
     }
 
+    /// Sets the bits at each of the \p positions to \c true in a single
+    /// kernel.
+    ///
+    /// Requires a block type of at least 32 bits.
+    void set(const vector<uint_> &positions, command_queue &queue)
+    {
+        update_bits(positions, "or", "", queue);
+    }
+
+    /// Sets the bits at each of the \p positions to zero in a single kernel.
+    ///
+    /// Requires a block type of at least 32 bits.
+    void reset(const vector<uint_> &positions, command_queue &queue)
+    {
+        update_bits(positions, "and", "~", queue);
+    }
+
+    /// Flips the bits at each of the \p positions in a single kernel. A
+    /// position which occurs twice is flipped twice.
+    ///
+    /// Requires a block type of at least 32 bits.
+    void flip(const vector<uint_> &positions, command_queue &queue)
+    {
+        update_bits(positions, "xor", "", queue);
+    }
+
+    /// Stores \c 1 in \p results for each of the \p positions whose bit is
+    /// set and \c 0 otherwise.
+    void test(const vector<uint_> &positions,
+              vector<uchar_> &results,
+              command_queue &queue) const
+    {
+        results.resize(positions.size(), queue);
+        if(positions.empty()){
+            return;
+        }
+
+        detail::meta_kernel k("dynamic_bitset_test");
+        size_t positions_arg =
+            k.add_arg<const uint_ *>(memory_object::global_memory, "positions");
+        size_t blocks_arg =
+            k.add_arg<const block_type *>(memory_object::global_memory, "blocks");
+        size_t results_arg =
+            k.add_arg<uchar_ *>(memory_object::global_memory, "results");
+
+        k << "const uint i = get_global_id(0);\n"
+          << "const uint n = positions[i];\n"
+          << "results[i] = (blocks[n / " << uint_(bits_per_block) << "] >> "
+          << "(n % " << uint_(bits_per_block) << ")) & 1;\n";
+
+        kernel kernel = k.compile(queue.get_context());
+        kernel.set_arg(positions_arg, positions.get_buffer());
+        kernel.set_arg(blocks_arg, m_bits.get_buffer());
+        kernel.set_arg(results_arg, results.get_buffer());
+        queue.enqueue_1d_range_kernel(kernel, 0, positions.size(), 0);
+    }
+
+    /// Sets each bit to the logical and of itself and the same bit in
+    /// \p other. Both bitsets must have the same size.
+    void bitwise_and(const dynamic_bitset &other, command_queue &queue)
+    {
+        combine_blocks(other, "&", "", queue);
+    }
+
+    /// Sets each bit to the logical or of itself and the same bit in
+    /// \p other. Both bitsets must have the same size.
+    void bitwise_or(const dynamic_bitset &other, command_queue &queue)
+    {
+        combine_blocks(other, "|", "", queue);
+    }
+
+    /// Sets each bit to the exclusive or of itself and the same bit in
+    /// \p other. Both bitsets must have the same size.
+    void bitwise_xor(const dynamic_bitset &other, command_queue &queue)
+    {
+        combine_blocks(other, "^", "", queue);
+    }
+
+    /// Clears each bit which is set in \p other (i.e. \c *this &= ~other).
+    /// Both bitsets must have the same size.
+    void bitwise_andnot(const dynamic_bitset &other, command_queue &queue)
+    {
+        combine_blocks(other, "&", "~", queue);
+    }
+
+    /// Returns the position of the first set bit or \c npos if no bit is
+    /// set.
+    size_type find_first(command_queue &queue) const
+    {
+        return find_from_block(0, queue);
+    }
+
+    /// Returns the position of the first set bit after position \p n or
+    /// \c npos if there is none.
+    size_type find_next(size_type n, command_queue &queue) const
+    {
+        const size_type start = n + 1;
+        if(start >= m_size){
+            return npos;
+        }
+
+        // mask the bits up to n in their block on the host
+        const size_type block = start / bits_per_block;
+        block_type block_value;
+        copy_n(m_bits.begin() + block, 1, &block_value, queue);
+        block_value &= ~block_type(0) << (start % bits_per_block);
+        if(block_value != 0){
+            return bit_position(block, block_value);
+        }
+
+        return find_from_block(block + 1, queue);
+    }
+
+    /// Returns the blocks storing the bits.
+    const container_type& blocks() const
+    {
+        return m_bits;
+    }
+
     /// Returns the allocator used to allocate storage for the bitset.
     allocator_type get_allocator() const
     {
         return m_bits.get_allocator();
     }
 
+private:
+    static size_type block_count(size_type num_bits)
+    {
+        return (num_bits + bits_per_block - 1) / bits_per_block;
+    }
+
+    // returns the position of the lowest set bit of value in block, or
+    // npos if it is past the end of the bitset
+    size_type bit_position(size_type block, block_type value) const
+    {
+        size_type bit = 0;
+        while((value & block_type(1)) == 0){
+            value >>= 1;
+            bit++;
+        }
+
+        const size_type position = block * bits_per_block + bit;
+        return position < m_size ? position : npos;
+    }
+
+    size_type find_from_block(size_type block, command_queue &queue) const
+    {
+        if(block >= m_bits.size()){
+            return npos;
+        }
+
+        typename container_type::const_iterator iter = find_if(
+            m_bits.begin() + block,
+            m_bits.end(),
+            lambda::_1 != block_type(0),
+            queue
+        );
+        if(iter == m_bits.end()){
+            return npos;
+        }
+
+        block_type block_value;
+        copy_n(iter, 1, &block_value, queue);
+        return bit_position(iter - m_bits.begin(), block_value);
+    }
+
+    // applies the atomic operation to the 32-bit word holding each bit in
+    // positions. the bits of a block are viewed as words in the device's
+    // byte order
+    void update_bits(const vector<uint_> &positions,
+                     const char *atomic_op,
+                     const char *mask_operator,
+                     command_queue &queue)
+    {
+        BOOST_STATIC_ASSERT_MSG(
+            sizeof(block_type) % sizeof(uint_) == 0,
+            "bulk bit updates require a block type of at least 32 bits"
+        );
+
+        if(positions.empty()){
+            return;
+        }
+
+        const uint_ words_per_block = sizeof(block_type) / sizeof(uint_);
+        const bool little_endian =
+            queue.get_device().get_info<cl_bool>(CL_DEVICE_ENDIAN_LITTLE) != 0;
+
+        detail::meta_kernel k("dynamic_bitset_update");
+        size_t positions_arg =
+            k.add_arg<const uint_ *>(memory_object::global_memory, "positions");
+        size_t words_arg =
+            k.add_arg<uint_ *>(memory_object::global_memory, "words");
+
+        k << "const uint n = positions[get_global_id(0)];\n"
+          << "const uint bit = n % " << uint_(bits_per_block) << ";\n"
+          << "const uint word = (n / " << uint_(bits_per_block) << ") * "
+          << words_per_block << " + ";
+        if(little_endian){
+            k << "bit / 32;\n";
+        }
+        else {
+            k << uint_(words_per_block - 1) << " - bit / 32;\n";
+        }
+        k << BOOST_COMPUTE_DETAIL_ATOMIC_PREFIX << atomic_op
+          << "(&words[word], " << mask_operator << "(1u << (bit % 32)));\n";
+
+        kernel kernel = k.compile(queue.get_context());
+        kernel.set_arg(positions_arg, positions.get_buffer());
+        kernel.set_arg(words_arg, m_bits.get_buffer());
+        queue.enqueue_1d_range_kernel(kernel, 0, positions.size(), 0);
+    }
+
+    // sets each block to block op (mask_operator other_block)
+    void combine_blocks(const dynamic_bitset &other,
+                        const char *op,
+                        const char *mask_operator,
+                        command_queue &queue)
+    {
+        BOOST_ASSERT(other.size() == size());
+
+        if(m_bits.empty()){
+            return;
+        }
+
+        detail::meta_kernel k("dynamic_bitset_combine");
+        size_t blocks_arg =
+            k.add_arg<block_type *>(memory_object::global_memory, "blocks");
+        size_t other_arg =
+            k.add_arg<const block_type *>(memory_object::global_memory, "other");
+
+        k << "const uint i = get_global_id(0);\n"
+          << "blocks[i] = blocks[i] " << op << " "
+          << mask_operator << "other[i];\n";
+
+        kernel kernel = k.compile(queue.get_context());
+        kernel.set_arg(blocks_arg, m_bits.get_buffer());
+        kernel.set_arg(other_arg, other.m_bits.get_buffer());
+        queue.enqueue_1d_range_kernel(kernel, 0, m_bits.size(), 0);
+    }
+
 private:
     container_type m_bits;
     size_type m_size;
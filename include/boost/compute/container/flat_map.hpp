@@ -19,11 +19,12 @@
 #include <boost/throw_exception.hpp>
 
 #include <boost/compute/exception.hpp>
-#include <boost/compute/algorithm/find.hpp>
-#include <boost/compute/algorithm/lower_bound.hpp>
-#include <boost/compute/algorithm/upper_bound.hpp>
+#include <boost/compute/algorithm/detail/batched_binary_search.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/detail/flat_bulk_ops.hpp>
+#include <boost/compute/container/detail/scalar.hpp>
 #include <boost/compute/functional/get.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
 #include <boost/compute/iterator/transform_iterator.hpp>
 #include <boost/compute/types/pair.hpp>
 #include <boost/compute/detail/buffer_value.hpp>
@@ -200,6 +201,33 @@ public:
         return result;
     }
 
+    /// Inserts the key-value pairs in the range [\p first, \p last).
+    /// Pairs whose key is already in the map are not inserted. If a key
+    /// occurs more than once in the range it is unspecified which of its
+    /// pairs is inserted.
+    ///
+    /// Unlike inserting pairs one at a time, the whole batch is sorted by
+    /// key, reduced to its new unique keys and merged with the existing
+    /// pairs in parallel.
+    template<class InputIterator>
+    void insert(InputIterator first, InputIterator last, command_queue &queue)
+    {
+        vector_type batch(first, last, queue);
+
+        detail::flat_insert_unique<key_type>(
+            m_vector, batch, ::boost::compute::get<0>(), queue
+        );
+    }
+
+    /// \overload
+    template<class InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    {
+        command_queue queue = m_vector.default_queue();
+        insert(first, last, queue);
+        queue.finish();
+    }
+
     iterator erase(const const_iterator &position, command_queue &queue)
     {
         return erase(position, position + 1, queue);
@@ -241,16 +269,29 @@ public:
         }
     }
 
-    iterator find(const key_type &value, command_queue &queue)
+    /// Erases the pairs with each of the keys in the range [\p first,
+    /// \p last) from the map and returns the number of pairs erased.
+    template<class KeyIterator>
+    size_type erase_keys(KeyIterator first, KeyIterator last, command_queue &queue)
     {
-        ::boost::compute::get<0> get_key;
+        return detail::flat_erase_keys<key_type>(
+            m_vector, first, last, ::boost::compute::get<0>(), queue
+        );
+    }
+
+    /// \overload
+    template<class KeyIterator>
+    size_type erase_keys(KeyIterator first, KeyIterator last)
+    {
+        command_queue queue = m_vector.default_queue();
+        size_type result = erase_keys(first, last, queue);
+        queue.finish();
+        return result;
+    }
 
-        return ::boost::compute::find(
-                   ::boost::compute::make_transform_iterator(begin(), get_key),
-                   ::boost::compute::make_transform_iterator(end(), get_key),
-                   value,
-                   queue
-               ).base();
+    iterator find(const key_type &value, command_queue &queue)
+    {
+        return begin() + search_index(value, detail::batched_find, queue);
     }
 
     iterator find(const key_type &value)
@@ -263,14 +304,7 @@ public:
 
     const_iterator find(const key_type &value, command_queue &queue) const
     {
-        ::boost::compute::get<0> get_key;
-
-        return ::boost::compute::find(
-                   ::boost::compute::make_transform_iterator(begin(), get_key),
-                   ::boost::compute::make_transform_iterator(end(), get_key),
-                   value,
-                   queue
-               ).base();
+        return begin() + search_index(value, detail::batched_find, queue);
     }
 
     const_iterator find(const key_type &value) const
@@ -296,14 +330,7 @@ public:
 
     iterator lower_bound(const key_type &value, command_queue &queue)
     {
-        ::boost::compute::get<0> get_key;
-
-        return ::boost::compute::lower_bound(
-                   ::boost::compute::make_transform_iterator(begin(), get_key),
-                   ::boost::compute::make_transform_iterator(end(), get_key),
-                   value,
-                   queue
-               ).base();
+        return begin() + search_index(value, detail::batched_lower_bound, queue);
     }
 
     iterator lower_bound(const key_type &value)
@@ -316,14 +343,7 @@ public:
 
     const_iterator lower_bound(const key_type &value, command_queue &queue) const
     {
-        ::boost::compute::get<0> get_key;
-
-        return ::boost::compute::lower_bound(
-                   ::boost::compute::make_transform_iterator(begin(), get_key),
-                   ::boost::compute::make_transform_iterator(end(), get_key),
-                   value,
-                   queue
-               ).base();
+        return begin() + search_index(value, detail::batched_lower_bound, queue);
     }
 
     const_iterator lower_bound(const key_type &value) const
@@ -336,14 +356,7 @@ public:
 
     iterator upper_bound(const key_type &value, command_queue &queue)
     {
-        ::boost::compute::get<0> get_key;
-
-        return ::boost::compute::upper_bound(
-                   ::boost::compute::make_transform_iterator(begin(), get_key),
-                   ::boost::compute::make_transform_iterator(end(), get_key),
-                   value,
-                   queue
-               ).base();
+        return begin() + search_index(value, detail::batched_upper_bound, queue);
     }
 
     iterator upper_bound(const key_type &value)
@@ -356,14 +369,7 @@ public:
 
     const_iterator upper_bound(const key_type &value, command_queue &queue) const
     {
-        ::boost::compute::get<0> get_key;
-
-        return ::boost::compute::upper_bound(
-                   ::boost::compute::make_transform_iterator(begin(), get_key),
-                   ::boost::compute::make_transform_iterator(end(), get_key),
-                   value,
-                   queue
-               ).base();
+        return begin() + search_index(value, detail::batched_upper_bound, queue);
     }
 
     const_iterator upper_bound(const key_type &value) const
@@ -396,6 +402,156 @@ public:
         return detail::buffer_value<mapped_type>(m_vector.get_buffer(), index);
     }
 
+    /// Looks up each of the keys in the range [\p first, \p last) and
+    /// writes the index of the matching pair (or size() if the key is not
+    /// in the map) to \p result.
+    ///
+    /// All of the lookups are performed by a single kernel.
+    template<class InputIterator, class OutputIterator>
+    void find(InputIterator first,
+              InputIterator last,
+              OutputIterator result,
+              command_queue &queue) const
+    {
+        ::boost::compute::get<0> get_key;
+
+        detail::batched_binary_search(
+            ::boost::compute::make_transform_iterator(begin(), get_key),
+            ::boost::compute::make_transform_iterator(end(), get_key),
+            first,
+            last,
+            result,
+            detail::batched_find,
+            queue
+        );
+    }
+
+    /// \overload
+    template<class InputIterator, class OutputIterator>
+    void find(InputIterator first, InputIterator last, OutputIterator result) const
+    {
+        command_queue queue = m_vector.default_queue();
+        find(first, last, result, queue);
+        queue.finish();
+    }
+
+    /// Writes the number of pairs (zero or one) with each of the keys in
+    /// the range [\p first, \p last) to \p result.
+    template<class InputIterator, class OutputIterator>
+    void count(InputIterator first,
+               InputIterator last,
+               OutputIterator result,
+               command_queue &queue) const
+    {
+        ::boost::compute::get<0> get_key;
+
+        detail::batched_binary_search(
+            ::boost::compute::make_transform_iterator(begin(), get_key),
+            ::boost::compute::make_transform_iterator(end(), get_key),
+            first,
+            last,
+            result,
+            detail::batched_contains,
+            queue
+        );
+    }
+
+    /// \overload
+    template<class InputIterator, class OutputIterator>
+    void count(InputIterator first, InputIterator last, OutputIterator result) const
+    {
+        command_queue queue = m_vector.default_queue();
+        count(first, last, result, queue);
+        queue.finish();
+    }
+
+    /// Writes the lower bound index for each of the keys in the range
+    /// [\p first, \p last) to \p result.
+    template<class InputIterator, class OutputIterator>
+    void lower_bound(InputIterator first,
+                     InputIterator last,
+                     OutputIterator result,
+                     command_queue &queue) const
+    {
+        ::boost::compute::get<0> get_key;
+
+        detail::batched_binary_search(
+            ::boost::compute::make_transform_iterator(begin(), get_key),
+            ::boost::compute::make_transform_iterator(end(), get_key),
+            first,
+            last,
+            result,
+            detail::batched_lower_bound,
+            queue
+        );
+    }
+
+    /// \overload
+    template<class InputIterator, class OutputIterator>
+    void lower_bound(InputIterator first, InputIterator last, OutputIterator result) const
+    {
+        command_queue queue = m_vector.default_queue();
+        lower_bound(first, last, result, queue);
+        queue.finish();
+    }
+
+    /// Writes the upper bound index for each of the keys in the range
+    /// [\p first, \p last) to \p result.
+    template<class InputIterator, class OutputIterator>
+    void upper_bound(InputIterator first,
+                     InputIterator last,
+                     OutputIterator result,
+                     command_queue &queue) const
+    {
+        ::boost::compute::get<0> get_key;
+
+        detail::batched_binary_search(
+            ::boost::compute::make_transform_iterator(begin(), get_key),
+            ::boost::compute::make_transform_iterator(end(), get_key),
+            first,
+            last,
+            result,
+            detail::batched_upper_bound,
+            queue
+        );
+    }
+
+    /// \overload
+    template<class InputIterator, class OutputIterator>
+    void upper_bound(InputIterator first, InputIterator last, OutputIterator result) const
+    {
+        command_queue queue = m_vector.default_queue();
+        upper_bound(first, last, result, queue);
+        queue.finish();
+    }
+
+private:
+    // returns the index found by a binary search for key
+    size_type search_index(const key_type &key,
+                           detail::batched_search_mode mode,
+                           command_queue &queue) const
+    {
+        const context &context = queue.get_context();
+
+        detail::scalar<key_type> query(context);
+        query.write(key, queue);
+        detail::scalar<uint_> index(context);
+
+        ::boost::compute::get<0> get_key;
+
+        detail::batched_binary_search(
+            ::boost::compute::make_transform_iterator(begin(), get_key),
+            ::boost::compute::make_transform_iterator(end(), get_key),
+            make_buffer_iterator<key_type>(query.get_buffer(), 0),
+            make_buffer_iterator<key_type>(query.get_buffer(), 1),
+            make_buffer_iterator<uint_>(index.get_buffer(), 0),
+            mode,
+            queue
+        );
+
+        return index.read(queue);
+    }
+
 private:
     ::boost::compute::vector<std::pair<Key, T> > m_vector;
 };
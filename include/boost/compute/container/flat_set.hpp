@@ -14,10 +14,11 @@
 #include <cstddef>
 #include <utility>
 
-#include <boost/compute/algorithm/find.hpp>
-#include <boost/compute/algorithm/lower_bound.hpp>
-#include <boost/compute/algorithm/upper_bound.hpp>
+#include <boost/compute/algorithm/detail/batched_binary_search.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/detail/flat_bulk_ops.hpp>
+#include <boost/compute/container/detail/scalar.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
 
 namespace boost {
 namespace compute {
@@ -189,6 +190,31 @@ public:
         return result;
     }
 
+    /// Inserts the values in the range [\p first, \p last). Values which
+    /// are already in the set are not inserted.
+    ///
+    /// Unlike inserting values one at a time, the whole batch is sorted,
+    /// reduced to its new unique values and merged with the existing
+    /// values in parallel.
+    template<class InputIterator>
+    void insert(InputIterator first, InputIterator last, command_queue &queue)
+    {
+        vector<T> batch(first, last, queue);
+
+        detail::flat_insert_unique<key_type>(
+            m_vector, batch, detail::flat_identity_key(), queue
+        );
+    }
+
+    /// \overload
+    template<class InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    {
+        command_queue queue = m_vector.default_queue();
+        insert(first, last, queue);
+        queue.finish();
+    }
+
     iterator erase(const const_iterator &position, command_queue &queue)
     {
         return erase(position, position + 1, queue);
@@ -238,9 +264,29 @@ public:
         return result;
     }
 
+    /// Erases each of the values in the range [\p first, \p last) from
+    /// the set and returns the number of values erased.
+    template<class KeyIterator>
+    size_type erase_keys(KeyIterator first, KeyIterator last, command_queue &queue)
+    {
+        return detail::flat_erase_keys<key_type>(
+            m_vector, first, last, detail::flat_identity_key(), queue
+        );
+    }
+
+    /// \overload
+    template<class KeyIterator>
+    size_type erase_keys(KeyIterator first, KeyIterator last)
+    {
+        command_queue queue = m_vector.default_queue();
+        size_type result = erase_keys(first, last, queue);
+        queue.finish();
+        return result;
+    }
+
     iterator find(const key_type &value, command_queue &queue)
     {
-        return ::boost::compute::find(begin(), end(), value, queue);
+        return begin() + search_index(value, detail::batched_find, queue);
     }
 
     iterator find(const key_type &value)
@@ -253,7 +299,7 @@ public:
 
     const_iterator find(const key_type &value, command_queue &queue) const
     {
-        return ::boost::compute::find(begin(), end(), value, queue);
+        return begin() + search_index(value, detail::batched_find, queue);
     }
 
     const_iterator find(const key_type &value) const
@@ -279,7 +325,7 @@ public:
 
     iterator lower_bound(const key_type &value, command_queue &queue)
     {
-        return ::boost::compute::lower_bound(begin(), end(), value, queue);
+        return begin() + search_index(value, detail::batched_lower_bound, queue);
     }
 
     iterator lower_bound(const key_type &value)
@@ -292,7 +338,7 @@ public:
 
     const_iterator lower_bound(const key_type &value, command_queue &queue) const
     {
-        return ::boost::compute::lower_bound(begin(), end(), value, queue);
+        return begin() + search_index(value, detail::batched_lower_bound, queue);
     }
 
     const_iterator lower_bound(const key_type &value) const
@@ -305,7 +351,7 @@ public:
 
     iterator upper_bound(const key_type &value, command_queue &queue)
     {
-        return ::boost::compute::upper_bound(begin(), end(), value, queue);
+        return begin() + search_index(value, detail::batched_upper_bound, queue);
     }
 
     iterator upper_bound(const key_type &value)
@@ -318,7 +364,7 @@ public:
 
     const_iterator upper_bound(const key_type &value, command_queue &queue) const
     {
-        return ::boost::compute::upper_bound(begin(), end(), value, queue);
+        return begin() + search_index(value, detail::batched_upper_bound, queue);
     }
 
     const_iterator upper_bound(const key_type &value) const
@@ -329,6 +375,122 @@ public:
         return iter;
     }
 
+    /// Looks up each of the values in the range [\p first, \p last) and
+    /// writes the index of the matching element (or size() if the value
+    /// is not in the set) to \p result.
+    ///
+    /// All of the lookups are performed by a single kernel.
+    template<class InputIterator, class OutputIterator>
+    void find(InputIterator first,
+              InputIterator last,
+              OutputIterator result,
+              command_queue &queue) const
+    {
+        detail::batched_binary_search(
+            begin(), end(), first, last, result, detail::batched_find, queue
+        );
+    }
+
+    /// \overload
+    template<class InputIterator, class OutputIterator>
+    void find(InputIterator first, InputIterator last, OutputIterator result) const
+    {
+        command_queue queue = m_vector.default_queue();
+        find(first, last, result, queue);
+        queue.finish();
+    }
+
+    /// Writes the number of elements (zero or one) equal to each of the
+    /// values in the range [\p first, \p last) to \p result.
+    template<class InputIterator, class OutputIterator>
+    void count(InputIterator first,
+               InputIterator last,
+               OutputIterator result,
+               command_queue &queue) const
+    {
+        detail::batched_binary_search(
+            begin(), end(), first, last, result, detail::batched_contains, queue
+        );
+    }
+
+    /// \overload
+    template<class InputIterator, class OutputIterator>
+    void count(InputIterator first, InputIterator last, OutputIterator result) const
+    {
+        command_queue queue = m_vector.default_queue();
+        count(first, last, result, queue);
+        queue.finish();
+    }
+
+    /// Writes the lower bound index for each of the values in the range
+    /// [\p first, \p last) to \p result.
+    template<class InputIterator, class OutputIterator>
+    void lower_bound(InputIterator first,
+                     InputIterator last,
+                     OutputIterator result,
+                     command_queue &queue) const
+    {
+        detail::batched_binary_search(
+            begin(), end(), first, last, result, detail::batched_lower_bound, queue
+        );
+    }
+
+    /// \overload
+    template<class InputIterator, class OutputIterator>
+    void lower_bound(InputIterator first, InputIterator last, OutputIterator result) const
+    {
+        command_queue queue = m_vector.default_queue();
+        lower_bound(first, last, result, queue);
+        queue.finish();
+    }
+
+    /// Writes the upper bound index for each of the values in the range
+    /// [\p first, \p last) to \p result.
+    template<class InputIterator, class OutputIterator>
+    void upper_bound(InputIterator first,
+                     InputIterator last,
+                     OutputIterator result,
+                     command_queue &queue) const
+    {
+        detail::batched_binary_search(
+            begin(), end(), first, last, result, detail::batched_upper_bound, queue
+        );
+    }
+
+    /// \overload
+    template<class InputIterator, class OutputIterator>
+    void upper_bound(InputIterator first, InputIterator last, OutputIterator result) const
+    {
+        command_queue queue = m_vector.default_queue();
+        upper_bound(first, last, result, queue);
+        queue.finish();
+    }
+
+private:
+    // returns the index found by a binary search for value
+    size_type search_index(const key_type &value,
+                           detail::batched_search_mode mode,
+                           command_queue &queue) const
+    {
+        const context &context = queue.get_context();
+
+        detail::scalar<key_type> query(context);
+        query.write(value, queue);
+        detail::scalar<uint_> index(context);
+
+        detail::batched_binary_search(
+            begin(),
+            end(),
+            make_buffer_iterator<key_type>(query.get_buffer(), 0),
+            make_buffer_iterator<key_type>(query.get_buffer(), 1),
+            make_buffer_iterator<uint_>(index.get_buffer(), 0),
+            mode,
+            queue
+        );
+
+        return index.read(queue);
+    }
+
 private:
     vector<T> m_vector;
 };
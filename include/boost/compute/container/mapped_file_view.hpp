@@ -0,0 +1,359 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CONTAINER_MAPPED_FILE_VIEW_HPP
+#define BOOST_COMPUTE_CONTAINER_MAPPED_FILE_VIEW_HPP
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+
+#include <boost/assert.hpp>
+#include <boost/version.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/interprocess/errors.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/detail/copy_by_mapping.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class mapped_file_view
+/// \brief A memory-mapped view of the values stored in a binary file.
+///
+/// The mapped_file_view class maps a file of \c T values into the host's
+/// address space so that it can be transferred to a compute device without
+/// first being read into a separate host container.
+///
+/// On devices which share the host's memory (see zero_copy_allocator) the
+/// mapping backs a buffer created with \c CL_MEM_USE_HOST_PTR and the
+/// values can be used directly by the Boost.Compute algorithms through
+/// begin() and end(). On other devices copy_to() streams the values to a
+/// device buffer in page-aligned chunks.
+///
+/// The mapped pages of a \c read_only view (the default) cannot be
+/// written, so only the const accessors may be used with it and their
+/// ranges must only be read. Views which are modified must be created in
+/// \c copy_on_write mode, which leaves the file itself unchanged.
+///
+/// For example, to load a column of values into a vector:
+/// \code
+/// boost::compute::mapped_file_view<float> column("column.bin", context);
+///
+/// boost::compute::vector<float> values(column.size(), context);
+/// column.copy_to(values.begin(), queue);
+/// \endcode
+///
+/// Files are opened with Boost.Interprocess, which throws an
+/// \c interprocess_exception if the file cannot be opened or mapped.
+/// Trailing bytes which do not form a complete value are ignored.
+///
+/// This header is not included by <boost/compute/container.hpp> as it
+/// depends on Boost.Interprocess.
+///
+/// \see mapped_view, write_to_file()
+template<class T>
+class mapped_file_view
+{
+public:
+    typedef T value_type;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef buffer_iterator<T> iterator;
+    typedef buffer_iterator<T> const_iterator;
+
+    /// Access modes for the mapped file.
+    enum mode {
+        /// The values can only be read.
+        read_only,
+        /// The values can be modified without changing the file.
+        copy_on_write
+    };
+
+    /// Maps the file at \p path for use with \p context in mode \p m.
+    explicit mapped_file_view(const std::string &path,
+                              const context &context = system::default_context(),
+                              mode m = read_only)
+        : m_mode(m)
+    {
+        _map(path, context);
+    }
+
+    /// Destroys the mapped_file_view object.
+    ~mapped_file_view()
+    {
+    }
+
+    /// Returns the number of values in the file.
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    /// Returns \c true if the file contains no values.
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /// Returns the access mode of the view.
+    mode get_mode() const
+    {
+        return m_mode;
+    }
+
+    /// Returns a pointer to the mapped values.
+    const T* data() const
+    {
+        return m_data;
+    }
+
+    /// Returns a pointer to the mapped values. Modifying the values requires
+    /// the view to have been created in \c copy_on_write mode.
+    T* data()
+    {
+        BOOST_ASSERT(m_mode == copy_on_write);
+
+        return m_data;
+    }
+
+    /// Returns \c true if the device can access the mapped values directly
+    /// through get_buffer(), begin() and end().
+    bool is_device_accessible() const
+    {
+        return m_buffer.get() != 0;
+    }
+
+    /// Returns the buffer backed by the mapped values. The buffer is null
+    /// unless is_device_accessible() is \c true.
+    const buffer& get_buffer() const
+    {
+        return m_buffer;
+    }
+
+    /// Returns an iterator to the first value in the buffer backed by the
+    /// mapping. Requires is_device_accessible() to be \c true and the view
+    /// to have been created in \c copy_on_write mode.
+    iterator begin()
+    {
+        BOOST_ASSERT(m_mode == copy_on_write);
+
+        return const_cast<const mapped_file_view *>(this)->begin();
+    }
+
+    /// Returns an iterator to the first value in the buffer backed by the
+    /// mapping. Requires is_device_accessible() to be \c true.
+    ///
+    /// The pages of a \c read_only view cannot be written, so the range
+    /// must only be passed to algorithms which read from it.
+    const_iterator begin() const
+    {
+        BOOST_ASSERT(is_device_accessible());
+
+        return ::boost::compute::make_buffer_iterator<T>(m_buffer, 0);
+    }
+
+    /// Returns an iterator to one past the last value in the buffer backed
+    /// by the mapping. Requires is_device_accessible() to be \c true and
+    /// the view to have been created in \c copy_on_write mode.
+    iterator end()
+    {
+        BOOST_ASSERT(m_mode == copy_on_write);
+
+        return const_cast<const mapped_file_view *>(this)->end();
+    }
+
+    /// Returns an iterator to one past the last value in the buffer backed
+    /// by the mapping. Requires is_device_accessible() to be \c true.
+    ///
+    /// \see begin() const
+    const_iterator end() const
+    {
+        BOOST_ASSERT(is_device_accessible());
+
+        return ::boost::compute::make_buffer_iterator<T>(m_buffer, m_size);
+    }
+
+    /// Copies the values in the file to the range beginning at \p result
+    /// and returns an iterator to the end of the copied range.
+    ///
+    /// The values are written in chunks of \p chunk_size bytes (rounded to
+    /// a multiple of the page size) which are all enqueued before waiting
+    /// for them, so the device can transfer a chunk while the pages of the
+    /// next are read from the file.
+    buffer_iterator<T> copy_to(buffer_iterator<T> result,
+                               command_queue &queue,
+                               size_t chunk_size = size_t(64) << 20) const
+    {
+        if(m_size == 0){
+            return result;
+        }
+
+        // transfers from buffers backed by the mapping are copies in
+        // memory, the driver is left to schedule them
+        if(is_device_accessible()){
+            return ::boost::compute::copy(begin(), end(), result, queue);
+        }
+
+        const size_t page_size =
+            ::boost::interprocess::mapped_region::get_page_size();
+        const size_t chunk_values =
+            (std::max)(chunk_size / page_size, size_t(1)) * page_size / sizeof(T);
+
+        std::vector<event> events;
+        for(size_t i = 0; i < m_size; i += chunk_values){
+            const size_t count = (std::min)(chunk_values, m_size - i);
+
+            events.push_back(
+                queue.enqueue_write_buffer_async(
+                    result.get_buffer(),
+                    (result.get_index() + i) * sizeof(T),
+                    count * sizeof(T),
+                    m_data + i
+                )
+            );
+        }
+
+        for(size_t i = 0; i < events.size(); i++){
+            events[i].wait();
+        }
+
+        return result + static_cast<difference_type>(m_size);
+    }
+
+private:
+    /// \internal_
+    void _map(const std::string &path, const context &context)
+    {
+        namespace ipc = ::boost::interprocess;
+
+        m_data = 0;
+        m_size = 0;
+
+        ipc::file_mapping file(path.c_str(), ipc::read_only);
+
+        // the whole file is mapped, which fails for empty files with a size
+        // error or (depending on the version of Boost) with the invalid
+        // argument error of mapping zero bytes
+        try {
+            m_region.reset(
+                new ipc::mapped_region(
+                    file,
+                    m_mode == read_only ? ipc::read_only : ipc::copy_on_write
+                )
+            );
+        }
+        catch(ipc::interprocess_exception &e){
+            if(e.get_error_code() != ipc::size_error &&
+               e.get_error_code() != ipc::invalid_argument){
+                throw;
+            }
+            return;
+        }
+
+        // files without a complete value are treated as empty
+        m_size = m_region->get_size() / sizeof(T);
+        if(m_size == 0){
+            m_region.reset();
+            return;
+        }
+
+        #if BOOST_VERSION >= 105700
+        // the values are usually read in order
+        m_region->advise(ipc::mapped_region::advice_sequential);
+        #endif
+
+        m_data = static_cast<T *>(m_region->get_address());
+
+        if(detail::is_host_unified_device(context.get_device())){
+            const cl_mem_flags flags =
+                m_mode == read_only ? buffer::read_only : buffer::read_write;
+
+            m_buffer = buffer(
+                context, m_size * sizeof(T), flags | buffer::use_host_ptr, m_data
+            );
+        }
+    }
+
+private:
+    mode m_mode;
+    boost::shared_ptr< ::boost::interprocess::mapped_region> m_region;
+    T *m_data;
+    size_type m_size;
+    buffer m_buffer;
+};
+
+/// Writes the values in the range [\p first, \p last) to a binary file at
+/// \p path, replacing its contents. The file can be read back with
+/// mapped_file_view.
+///
+/// The file is resized and mapped into the host's address space and the
+/// values are copied directly into the mapping, so they are not staged in
+/// a separate host container.
+///
+/// \see mapped_file_view
+template<class InputIterator>
+inline void write_to_file(InputIterator first,
+                          InputIterator last,
+                          const std::string &path,
+                          command_queue &queue = system::default_queue())
+{
+    namespace ipc = ::boost::interprocess;
+
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    const size_t count = detail::iterator_range_size(first, last);
+
+    // create (or truncate) the file and extend it to its final size
+    {
+        std::filebuf file;
+        file.open(
+            path.c_str(),
+            std::ios::in | std::ios::out | std::ios::trunc | std::ios::binary
+        );
+        if(count > 0){
+            file.pubseekoff(
+                static_cast<std::streamoff>(count * sizeof(T) - 1), std::ios::beg
+            );
+            file.sputc(0);
+        }
+    }
+
+    if(count == 0){
+        return;
+    }
+
+    ipc::file_mapping file(path.c_str(), ipc::read_write);
+    ipc::mapped_region region(file, ipc::read_write);
+
+    ::boost::compute::copy(
+        first, last, static_cast<T *>(region.get_address()), queue
+    );
+
+    region.flush();
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_CONTAINER_MAPPED_FILE_VIEW_HPP
@@ -0,0 +1,365 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CONTAINER_PACKED_VECTOR_HPP
+#define BOOST_COMPUTE_CONTAINER_PACKED_VECTOR_HPP
+
+#include <cstddef>
+
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/iterator/packed_iterator.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/is_device_iterator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// sets the base of each block overlapping the values [begin, end) of
+// result to the smallest of the values which are stored in the block
+template<class InputIterator, class T, size_t Bits, bool FrameOfReference>
+inline void pack_block_bases(InputIterator first,
+                             size_t begin,
+                             size_t end,
+                             packed_iterator<T, Bits, FrameOfReference> result,
+                             command_queue &queue)
+{
+    const size_t block_size = result.block_size;
+    const size_t first_block = begin / block_size;
+    const size_t last_block = (end + block_size - 1) / block_size;
+
+    meta_kernel k("pack_block_bases");
+    k.add_set_arg<const uint_>("begin", uint_(begin));
+    k.add_set_arg<const uint_>("end", uint_(end));
+
+    k <<
+        "const uint block = get_global_id(0);\n" <<
+        "const uint first = max(block * " << uint_(block_size) << ", begin);\n" <<
+        "const uint last = min((block + 1) * " << uint_(block_size) << ", end);\n" <<
+        k.decl<T>("base") << " = " << first[k.var<uint_>("first - begin")] << ";\n" <<
+        "for(uint i = first + 1; i < last; i++){\n" <<
+        "    base = min(base, " << first[k.var<uint_>("i - begin")] << ");\n" <<
+        "}\n" <<
+        k.get_buffer_identifier<T>(result.get_bases_buffer()) << "[block] = base;\n";
+
+    k.exec_1d(queue, first_block, last_block - first_block);
+}
+
+// packs the count values starting at first into the values starting at
+// result. each work-item assembles one word from the values overlapping
+// it, keeping the bits of values outside of the range, so no atomics are
+// needed.
+template<class InputIterator, class T, size_t Bits, bool FrameOfReference>
+inline void pack_values(InputIterator first,
+                        size_t count,
+                        packed_iterator<T, Bits, FrameOfReference> result,
+                        command_queue &queue,
+                        boost::true_type /* is_device_iterator */)
+{
+    if(count == 0){
+        return;
+    }
+
+    const size_t begin = result.get_index();
+    const size_t end = begin + count;
+
+    if(FrameOfReference){
+        pack_block_bases(first, begin, end, result, queue);
+    }
+
+    const size_t first_word = begin * Bits / 32;
+    const size_t last_word = (end * Bits - 1) / 32;
+    const uint_ mask = 0xffffffffu >> (32 - Bits);
+
+    meta_kernel k("pack_values");
+    k.add_set_arg<const uint_>("begin", uint_(begin));
+    k.add_set_arg<const uint_>("end", uint_(end));
+
+    const std::string words =
+        k.get_buffer_identifier<uint_>(result.get_words_buffer());
+
+    k <<
+        "const uint w = get_global_id(0);\n" <<
+        "const ulong first_bit = (ulong) w * 32;\n" <<
+        "const uint first = max((uint)(first_bit / " << uint_(Bits) << "), begin);\n" <<
+        "const uint last = min((uint)((first_bit + 31) / " << uint_(Bits) << ") + 1, end);\n" <<
+        "uint word = 0;\n" <<
+        "uint covered = 0;\n" <<
+        "for(uint i = first; i < last; i++){\n" <<
+        "    const long shift = (long)((ulong) i * " << uint_(Bits) << ") - (long) first_bit;\n" <<
+        "    const uint value = (uint)(" << first[k.var<uint_>("i - begin")];
+    if(FrameOfReference){
+        k << " - " << k.get_buffer_identifier<T>(result.get_bases_buffer()) <<
+             "[i / " << uint_(result.block_size) << "]";
+    }
+    k <<
+        ") & " << mask << "u;\n" <<
+        "    word |= shift >= 0 ? value << (uint) shift : value >> (uint) -shift;\n" <<
+        "    covered |= shift >= 0 ? " << mask << "u << (uint) shift : " <<
+                                         mask << "u >> (uint) -shift;\n" <<
+        "}\n" <<
+        words << "[w] = (" << words << "[w] & ~covered) | word;\n";
+
+    k.exec_1d(queue, first_word, last_word - first_word + 1);
+}
+
+// host values are copied to the device before being packed
+template<class InputIterator, class T, size_t Bits, bool FrameOfReference>
+inline void pack_values(InputIterator first,
+                        size_t count,
+                        packed_iterator<T, Bits, FrameOfReference> result,
+                        command_queue &queue,
+                        boost::false_type /* is_device_iterator */)
+{
+    vector<T> values(first, first + count, queue);
+
+    pack_values(values.begin(), count, result, queue, boost::true_type());
+}
+
+template<class InputIterator, class T, size_t Bits, bool FrameOfReference>
+inline void pack_values(InputIterator first,
+                        size_t count,
+                        packed_iterator<T, Bits, FrameOfReference> result,
+                        command_queue &queue)
+{
+    pack_values(first, count, result, queue, is_device_iterator<InputIterator>());
+}
+
+// device -> device
+template<class T, size_t Bits, bool FrameOfReference, class OutputIterator>
+inline OutputIterator copy_packed(packed_iterator<T, Bits, FrameOfReference> first,
+                                  packed_iterator<T, Bits, FrameOfReference> last,
+                                  OutputIterator result,
+                                  command_queue &queue,
+                                  boost::true_type /* is_device_iterator */)
+{
+    return copy_on_device(first, last, result, queue);
+}
+
+// device -> host, the values are unpacked on the device and then read
+template<class T, size_t Bits, bool FrameOfReference, class OutputIterator>
+inline OutputIterator copy_packed(packed_iterator<T, Bits, FrameOfReference> first,
+                                  packed_iterator<T, Bits, FrameOfReference> last,
+                                  OutputIterator result,
+                                  command_queue &queue,
+                                  boost::false_type /* is_device_iterator */)
+{
+    vector<T> values(iterator_range_size(first, last), queue.get_context());
+    copy_on_device(first, last, values.begin(), queue);
+
+    return ::boost::compute::copy(values.begin(), values.end(), result, queue);
+}
+
+} // end detail namespace
+
+/// \class packed_vector
+/// \brief A vector of integers packed into \p Bits bits each.
+///
+/// The packed_vector class stores integer values using only \p Bits bits
+/// per value. Columns of small integers (e.g. ids which fit in 10 to 20
+/// bits) take a fraction of the memory and bandwidth of a vector<T>.
+///
+/// The values are packed on the device when the vector is assigned and
+/// are unpacked inline by the kernels which read them. The packed_iterator
+/// ranges returned by begin() and end() can be used as input to
+/// algorithms such as transform(), reduce(), count_if() and copy():
+/// \code
+/// // pack twelve bit ids
+/// boost::compute::packed_vector<uint_, 12> ids(host_ids.begin(), host_ids.end(), queue);
+///
+/// // count the ids below 100 without unpacking them to memory
+/// size_t n = boost::compute::count_if(ids.begin(), ids.end(), _1 < 100, queue);
+/// \endcode
+///
+/// Values must fit in \p Bits bits. Negative values of signed types are
+/// stored in two's complement and sign-extended when read.
+///
+/// If \p FrameOfReference is \c true, each block of \c block_size values
+/// is stored as the differences to the smallest value in the block. Then
+/// only the spread of the values within a block needs to fit in \p Bits
+/// bits, which makes sorted or clustered columns (e.g. timestamps) pack
+/// tightly even though their values are large.
+///
+/// \see vector<T>, packed_iterator
+template<class T, size_t Bits, bool FrameOfReference = false>
+class packed_vector
+{
+public:
+    typedef T value_type;
+    typedef size_t size_type;
+    typedef packed_iterator<T, Bits, FrameOfReference> iterator;
+    typedef packed_iterator<T, Bits, FrameOfReference> const_iterator;
+
+    BOOST_STATIC_CONSTANT(size_type, bits = Bits);
+    BOOST_STATIC_CONSTANT(size_type, block_size = iterator::block_size);
+
+    /// Creates an empty packed vector in \p context.
+    explicit packed_vector(const context &context = system::default_context())
+        : m_words(1, context),
+          m_bases(context),
+          m_size(0)
+    {
+    }
+
+    /// Creates a packed vector with the values in the range [\p first,
+    /// \p last) which are packed with \p queue.
+    template<class InputIterator>
+    packed_vector(InputIterator first,
+                  InputIterator last,
+                  command_queue &queue = system::default_queue())
+        : m_words(1, queue.get_context()),
+          m_bases(queue.get_context()),
+          m_size(0)
+    {
+        assign(first, last, queue);
+    }
+
+    /// Creates a new packed vector as a copy of \p other.
+    packed_vector(const packed_vector &other)
+        : m_words(other.m_words),
+          m_bases(other.m_bases),
+          m_size(other.m_size)
+    {
+    }
+
+    /// Copies the values from \p other to \c *this.
+    packed_vector& operator=(const packed_vector &other)
+    {
+        if(this != &other){
+            m_words = other.m_words;
+            m_bases = other.m_bases;
+            m_size = other.m_size;
+        }
+
+        return *this;
+    }
+
+    /// Destroys the packed vector.
+    ~packed_vector()
+    {
+    }
+
+    /// Returns the number of values in the packed vector.
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    /// Returns \c true if the packed vector is empty.
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /// Returns the number of 32-bit words storing the packed values.
+    size_type num_words() const
+    {
+        return m_words.size();
+    }
+
+    iterator begin() const
+    {
+        return iterator(m_words.get_buffer(), m_bases.get_buffer(), 0);
+    }
+
+    iterator end() const
+    {
+        return iterator(m_words.get_buffer(), m_bases.get_buffer(), m_size);
+    }
+
+    /// Replaces the values in the packed vector with the values in the
+    /// range [\p first, \p last).
+    template<class InputIterator>
+    void assign(InputIterator first,
+                InputIterator last,
+                command_queue &queue = system::default_queue())
+    {
+        const size_type count = detail::iterator_range_size(first, last);
+        const context &context = queue.get_context();
+
+        // each value is read from the two words it starts in so the words
+        // are followed by a padding word
+        vector<uint_> words((count * Bits + 31) / 32 + 1, context);
+        m_words.swap(words);
+
+        if(FrameOfReference){
+            vector<T> bases((count + block_size - 1) / block_size, context);
+            m_bases.swap(bases);
+        }
+
+        m_size = count;
+
+        detail::pack_values(first, count, begin(), queue);
+    }
+
+    /// Returns the buffer holding the packed values.
+    const buffer& get_buffer() const
+    {
+        return m_words.get_buffer();
+    }
+
+private:
+    vector<uint_> m_words;
+    vector<T> m_bases;
+    size_type m_size;
+};
+
+/// Copies the unpacked values in the range [\p first, \p last) to the
+/// range beginning at \p result.
+///
+/// \see packed_vector
+template<class T, size_t Bits, bool FrameOfReference, class OutputIterator>
+inline OutputIterator copy(packed_iterator<T, Bits, FrameOfReference> first,
+                           packed_iterator<T, Bits, FrameOfReference> last,
+                           OutputIterator result,
+                           command_queue &queue = system::default_queue())
+{
+    return detail::copy_packed(
+        first, last, result, queue, detail::is_device_iterator<OutputIterator>()
+    );
+}
+
+/// Sorts the packed values in the range [\p first, \p last).
+///
+/// The values are unpacked to a temporary vector, sorted with radix sort
+/// and packed again. With \p FrameOfReference, \p first and \p last must
+/// be at the start of a block or at the end of the packed vector.
+///
+/// \see packed_vector
+template<class T, size_t Bits, bool FrameOfReference>
+inline void sort(packed_iterator<T, Bits, FrameOfReference> first,
+                 packed_iterator<T, Bits, FrameOfReference> last,
+                 command_queue &queue = system::default_queue())
+{
+    const size_t count = detail::iterator_range_size(first, last);
+    if(count < 2){
+        return;
+    }
+
+    vector<T> values(count, queue.get_context());
+    detail::copy_on_device(first, last, values.begin(), queue);
+
+    ::boost::compute::sort(values.begin(), values.end(), queue);
+
+    detail::pack_values(values.begin(), count, first, queue);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_CONTAINER_PACKED_VECTOR_HPP
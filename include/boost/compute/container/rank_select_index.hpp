@@ -0,0 +1,250 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CONTAINER_RANK_SELECT_INDEX_HPP
+#define BOOST_COMPUTE_CONTAINER_RANK_SELECT_INDEX_HPP
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/algorithm/fill_n.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/dynamic_bitset.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+#include <boost/compute/functional/popcount.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class rank_select_index
+/// \brief Answers rank and select queries on a dynamic_bitset.
+///
+/// The index stores the number of set bits before each block of the
+/// bitset, computed with a popcount of every block followed by an
+/// exclusive scan. With it the rank of a position (the number of set bits
+/// before it) takes one lookup and one popcount, and the select of a rank
+/// (the position of the set bit with that rank) takes a binary search over
+/// the blocks followed by a search within one block.
+///
+/// For example, to find the positions of the rows matched by a filter:
+/// \code
+/// boost::compute::rank_select_index<> index(filter, queue);
+///
+/// boost::compute::vector<uint_> ranks(index.count(), context);
+/// boost::compute::iota(ranks.begin(), ranks.end(), 0, queue);
+///
+/// boost::compute::vector<uint_> rows(context);
+/// index.select(ranks, rows, queue);
+/// \endcode
+///
+/// The index refers to the bitset's storage and is not updated when the
+/// bitset changes, it must be rebuilt with build() after the bitset is
+/// modified or resized.
+///
+/// \see dynamic_bitset
+template<class Block = ulong_, class Alloc = buffer_allocator<Block> >
+class rank_select_index
+{
+public:
+    typedef dynamic_bitset<Block, Alloc> bitset_type;
+    typedef Block block_type;
+    typedef typename bitset_type::size_type size_type;
+
+    BOOST_STATIC_CONSTANT(uint_, npos = static_cast<uint_>(-1));
+
+    /// Creates a rank/select index for \p bits.
+    rank_select_index(const bitset_type &bits, command_queue &queue)
+        : m_counts(queue.get_context()),
+          m_block_count(0),
+          m_count(0)
+    {
+        build(bits, queue);
+    }
+
+    /// Destroys the index.
+    ~rank_select_index()
+    {
+    }
+
+    /// Rebuilds the index for \p bits.
+    void build(const bitset_type &bits, command_queue &queue)
+    {
+        const size_type blocks = bits.num_blocks();
+
+        // the index refers to the bitset's blocks rather than a copy
+        m_blocks = bits.blocks().get_buffer();
+        m_block_count = blocks;
+
+        // m_counts[i] is the number of set bits in the blocks before i
+        m_counts.resize(blocks + 1, queue);
+        transform(
+            bits.blocks().begin(), bits.blocks().end(), m_counts.begin(),
+            popcount<block_type>(), queue
+        );
+        fill_n(m_counts.begin() + blocks, 1, uint_(0), queue);
+        exclusive_scan(m_counts.begin(), m_counts.end(), m_counts.begin(), queue);
+
+        m_count = detail::read_single_value<uint_>(
+            m_counts.get_buffer(), blocks, queue
+        );
+    }
+
+    /// Returns the number of set bits in the bitset.
+    size_type count() const
+    {
+        return m_count;
+    }
+
+    /// Stores the rank of each of the \p positions (the number of set bits
+    /// before the position) in \p ranks. Positions must not be greater than
+    /// the size of the bitset.
+    void rank(const vector<uint_> &positions,
+              vector<uint_> &ranks,
+              command_queue &queue) const
+    {
+        ranks.resize(positions.size(), queue);
+        if(positions.empty()){
+            return;
+        }
+
+        const uint_ bits_per_block = bitset_type::bits_per_block;
+        popcount<block_type> popc;
+
+        detail::meta_kernel k("rank_select_index_rank");
+        size_t positions_arg =
+            k.add_arg<const uint_ *>(memory_object::global_memory, "positions");
+        size_t blocks_arg =
+            k.add_arg<const block_type *>(memory_object::global_memory, "blocks");
+        size_t counts_arg =
+            k.add_arg<const uint_ *>(memory_object::global_memory, "counts");
+        size_t ranks_arg =
+            k.add_arg<uint_ *>(memory_object::global_memory, "ranks");
+
+        k << "const uint i = get_global_id(0);\n"
+          << "const uint n = positions[i];\n"
+          << "const uint block = n / " << bits_per_block << ";\n"
+          << "const uint bit = n % " << bits_per_block << ";\n"
+          << "uint rank = counts[block];\n"
+          << "if(bit != 0){\n"
+          << "    const " << type_name<block_type>() << " mask = "
+          <<          "(((" << type_name<block_type>() << ") 1) << bit) - 1;\n"
+          << "    rank += " << popc(k.var<block_type>("(blocks[block] & mask)")) << ";\n"
+          << "}\n"
+          << "ranks[i] = rank;\n";
+
+        kernel kernel = k.compile(queue.get_context());
+        kernel.set_arg(positions_arg, positions.get_buffer());
+        kernel.set_arg(blocks_arg, m_blocks);
+        kernel.set_arg(counts_arg, m_counts.get_buffer());
+        kernel.set_arg(ranks_arg, ranks.get_buffer());
+        queue.enqueue_1d_range_kernel(kernel, 0, positions.size(), 0);
+    }
+
+    /// Returns the number of set bits before position \p n.
+    size_type rank(size_type n, command_queue &queue) const
+    {
+        vector<uint_> positions(1, uint_(n), queue);
+        vector<uint_> ranks(1, queue.get_context());
+        rank(positions, ranks, queue);
+
+        return detail::read_single_value<uint_>(ranks.get_buffer(), 0, queue);
+    }
+
+    /// Stores the position of the set bit with each of the \p ranks (i.e.
+    /// the position of the first set bit for rank \c 0) in \p positions.
+    /// Ranks not less than count() give \c npos.
+    void select(const vector<uint_> &ranks,
+                vector<uint_> &positions,
+                command_queue &queue) const
+    {
+        positions.resize(ranks.size(), queue);
+        if(ranks.empty()){
+            return;
+        }
+
+        const uint_ bits_per_block = bitset_type::bits_per_block;
+        popcount<block_type> popc;
+
+        detail::meta_kernel k("rank_select_index_select");
+        size_t ranks_arg =
+            k.add_arg<const uint_ *>(memory_object::global_memory, "ranks");
+        size_t blocks_arg =
+            k.add_arg<const block_type *>(memory_object::global_memory, "blocks");
+        size_t counts_arg =
+            k.add_arg<const uint_ *>(memory_object::global_memory, "counts");
+        size_t block_count_arg = k.add_arg<const uint_>("block_count");
+        size_t positions_arg =
+            k.add_arg<uint_ *>(memory_object::global_memory, "positions");
+
+        k << "const uint i = get_global_id(0);\n"
+          << "const uint r = ranks[i];\n"
+          << "if(r >= counts[block_count]){\n"
+          << "    positions[i] = " << uint_(npos) << ";\n"
+          << "    return;\n"
+          << "}\n"
+          // find the last block with fewer than r + 1 set bits before it
+          << "uint lo = 0;\n"
+          << "uint hi = block_count - 1;\n"
+          << "while(lo < hi){\n"
+          << "    const uint mid = (lo + hi + 1) / 2;\n"
+          << "    if(counts[mid] <= r){\n"
+          << "        lo = mid;\n"
+          << "    }\n"
+          << "    else {\n"
+          << "        hi = mid - 1;\n"
+          << "    }\n"
+          << "}\n"
+          // clear the lower set bits of the block until the bit with rank
+          // r is the lowest
+          << type_name<block_type>() << " value = blocks[lo];\n"
+          << "for(uint j = counts[lo]; j < r; j++){\n"
+          << "    value &= value - 1;\n"
+          << "}\n"
+          << "positions[i] = lo * " << bits_per_block << " + "
+          << popc(k.var<block_type>("((value & (~value + 1)) - 1)")) << ";\n";
+
+        kernel kernel = k.compile(queue.get_context());
+        kernel.set_arg(ranks_arg, ranks.get_buffer());
+        kernel.set_arg(blocks_arg, m_blocks);
+        kernel.set_arg(counts_arg, m_counts.get_buffer());
+        kernel.set_arg(block_count_arg, uint_(m_block_count));
+        kernel.set_arg(positions_arg, positions.get_buffer());
+        queue.enqueue_1d_range_kernel(kernel, 0, ranks.size(), 0);
+    }
+
+    /// Returns the position of the set bit with rank \p r or \c npos if
+    /// there are not more than \p r set bits.
+    size_type select(size_type r, command_queue &queue) const
+    {
+        if(r >= m_count){
+            return npos;
+        }
+
+        vector<uint_> ranks(1, uint_(r), queue);
+        vector<uint_> positions(1, queue.get_context());
+        select(ranks, positions, queue);
+
+        return detail::read_single_value<uint_>(positions.get_buffer(), 0, queue);
+    }
+
+private:
+    buffer m_blocks;
+    vector<uint_> m_counts;
+    size_type m_block_count;
+    size_type m_count;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_CONTAINER_RANK_SELECT_INDEX_HPP
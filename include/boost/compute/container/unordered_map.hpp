@@ -0,0 +1,332 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CONTAINER_UNORDERED_MAP_HPP
+#define BOOST_COMPUTE_CONTAINER_UNORDERED_MAP_HPP
+
+#include <cstddef>
+
+#include <boost/compute/context.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/container/detail/hash_table.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class unordered_map
+/// \brief A hash map stored on a compute device.
+///
+/// The unordered_map class stores unique keys and their mapped values in
+/// an open-addressing hash table in device memory. All operations work on
+/// whole ranges of keys (stored on the device) and are performed by a
+/// single kernel with one work-item per key, making the container suitable
+/// for large batches of lookups against a slowly changing dictionary.
+///
+/// Keys must be 32-bit integers (\c int_ or \c uint_). The mapped type
+/// can be any type usable on the device, including structs adapted with
+/// BOOST_COMPUTE_ADAPT_STRUCT(). Two key values are reserved to mark empty
+/// and erased slots and can not be inserted. By default these are the two
+/// largest values of the key type.
+///
+/// The table grows automatically when an insert would exceed the maximum
+/// load factor (0.5 by default).
+///
+/// \see unordered_set, flat_map
+template<class Key, class T>
+class unordered_map
+{
+public:
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef size_t size_type;
+
+    /// Creates an empty map in \p context.
+    explicit unordered_map(const context &context = system::default_context())
+        : m_table(
+              0,
+              detail::hash_table_key_traits<Key>::empty_key(),
+              detail::hash_table_key_traits<Key>::deleted_key(),
+              context
+          )
+    {
+    }
+
+    /// Creates an empty map with at least \p bucket_count buckets using
+    /// \p empty_key and \p deleted_key as the reserved keys.
+    unordered_map(size_type bucket_count,
+                  const key_type &empty_key,
+                  const key_type &deleted_key,
+                  const context &context = system::default_context())
+        : m_table(bucket_count, empty_key, deleted_key, context)
+    {
+    }
+
+    /// Creates a new map from \p other.
+    unordered_map(const unordered_map<Key, T> &other)
+        : m_table(other.m_table)
+    {
+    }
+
+    /// Copies the map from \p other.
+    unordered_map<Key, T>& operator=(const unordered_map<Key, T> &other)
+    {
+        if(this != &other){
+            m_table = other.m_table;
+        }
+
+        return *this;
+    }
+
+    ~unordered_map()
+    {
+    }
+
+    /// Returns the number of keys in the map.
+    size_type size() const
+    {
+        return m_table.size();
+    }
+
+    /// Returns \c true if the map is empty.
+    bool empty() const
+    {
+        return m_table.empty();
+    }
+
+    /// Returns the number of buckets in the hash table.
+    size_type bucket_count() const
+    {
+        return m_table.bucket_count();
+    }
+
+    /// Returns the average number of keys per bucket.
+    float load_factor() const
+    {
+        return m_table.load_factor();
+    }
+
+    /// Returns the maximum load factor.
+    float max_load_factor() const
+    {
+        return m_table.max_load_factor();
+    }
+
+    /// Sets the maximum load factor to \p factor (in the range (0, 1)).
+    void max_load_factor(float factor)
+    {
+        m_table.max_load_factor(factor);
+    }
+
+    /// Removes all keys from the map.
+    void clear(command_queue &queue)
+    {
+        m_table.clear(queue);
+    }
+
+    /// \overload
+    void clear()
+    {
+        command_queue queue = default_queue();
+        clear(queue);
+        queue.finish();
+    }
+
+    /// Rebuilds the hash table with at least \p count buckets.
+    void rehash(size_type count, command_queue &queue)
+    {
+        m_table.rehash(count, queue);
+    }
+
+    /// \overload
+    void rehash(size_type count)
+    {
+        command_queue queue = default_queue();
+        rehash(count, queue);
+        queue.finish();
+    }
+
+    /// Reserves space for \p count keys without exceeding the maximum
+    /// load factor.
+    void reserve(size_type count, command_queue &queue)
+    {
+        m_table.reserve(count, queue);
+    }
+
+    /// \overload
+    void reserve(size_type count)
+    {
+        command_queue queue = default_queue();
+        reserve(count, queue);
+        queue.finish();
+    }
+
+    /// Inserts the keys in the range [\p keys_first, \p keys_last) with
+    /// the mapped values in the range beginning at \p values_first and
+    /// returns the number of keys inserted. Keys already in the map keep
+    /// their existing value. If a key occurs more than once in the range it
+    /// is unspecified which of its values is inserted.
+    template<class KeyIterator, class ValueIterator>
+    size_type insert(KeyIterator keys_first,
+                     KeyIterator keys_last,
+                     ValueIterator values_first,
+                     command_queue &queue)
+    {
+        return m_table.insert(
+            keys_first,
+            values_first,
+            detail::iterator_range_size(keys_first, keys_last),
+            queue
+        );
+    }
+
+    /// \overload
+    template<class KeyIterator, class ValueIterator>
+    size_type insert(KeyIterator keys_first,
+                     KeyIterator keys_last,
+                     ValueIterator values_first)
+    {
+        command_queue queue = default_queue();
+        size_type result = insert(keys_first, keys_last, values_first, queue);
+        queue.finish();
+        return result;
+    }
+
+    /// Erases the keys in the range [\p first, \p last) and returns the
+    /// number of keys erased.
+    template<class InputIterator>
+    size_type erase(InputIterator first, InputIterator last, command_queue &queue)
+    {
+        return m_table.erase(
+            first, detail::iterator_range_size(first, last), queue
+        );
+    }
+
+    /// \overload
+    template<class InputIterator>
+    size_type erase(InputIterator first, InputIterator last)
+    {
+        command_queue queue = default_queue();
+        size_type result = erase(first, last, queue);
+        queue.finish();
+        return result;
+    }
+
+    /// Writes the value mapped to each key in the range [\p first,
+    /// \p last) to \p result, or \p missing for keys which are not in
+    /// the map. Returns the number of keys found.
+    template<class InputIterator, class OutputIterator>
+    size_type find(InputIterator first,
+                   InputIterator last,
+                   OutputIterator result,
+                   const mapped_type &missing,
+                   command_queue &queue) const
+    {
+        return m_table.lookup(
+            first,
+            detail::iterator_range_size(first, last),
+            result,
+            missing,
+            detail::hash_table_find_value,
+            queue
+        );
+    }
+
+    /// \overload
+    template<class InputIterator, class OutputIterator>
+    size_type find(InputIterator first,
+                   InputIterator last,
+                   OutputIterator result,
+                   command_queue &queue) const
+    {
+        return find(first, last, result, mapped_type(), queue);
+    }
+
+    /// \overload
+    template<class InputIterator, class OutputIterator>
+    size_type find(InputIterator first,
+                   InputIterator last,
+                   OutputIterator result,
+                   const mapped_type &missing = mapped_type()) const
+    {
+        command_queue queue = default_queue();
+        size_type found = find(first, last, result, missing, queue);
+        queue.finish();
+        return found;
+    }
+
+    /// Writes \c 1 to \p result for each key in the range [\p first,
+    /// \p last) which is in the map and \c 0 otherwise. Returns the number
+    /// of keys found.
+    template<class InputIterator, class OutputIterator>
+    size_type contains(InputIterator first,
+                       InputIterator last,
+                       OutputIterator result,
+                       command_queue &queue) const
+    {
+        return m_table.lookup(
+            first,
+            detail::iterator_range_size(first, last),
+            result,
+            mapped_type(),
+            detail::hash_table_contains,
+            queue
+        );
+    }
+
+    /// \overload
+    template<class InputIterator, class OutputIterator>
+    size_type contains(InputIterator first,
+                       InputIterator last,
+                       OutputIterator result) const
+    {
+        command_queue queue = default_queue();
+        size_type found = contains(first, last, result, queue);
+        queue.finish();
+        return found;
+    }
+
+    /// Writes the number of elements (zero or one) equal to each key in
+    /// the range [\p first, \p last) to \p result.
+    ///
+    /// This is equivalent to contains().
+    template<class InputIterator, class OutputIterator>
+    size_type count(InputIterator first,
+                    InputIterator last,
+                    OutputIterator result,
+                    command_queue &queue) const
+    {
+        return contains(first, last, result, queue);
+    }
+
+    /// \overload
+    template<class InputIterator, class OutputIterator>
+    size_type count(InputIterator first,
+                    InputIterator last,
+                    OutputIterator result) const
+    {
+        return contains(first, last, result);
+    }
+
+private:
+    command_queue default_queue() const
+    {
+        return m_table.keys().default_queue();
+    }
+
+private:
+    detail::hash_table<Key, T, true> m_table;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_CONTAINER_UNORDERED_MAP_HPP
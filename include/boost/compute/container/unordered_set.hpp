@@ -0,0 +1,276 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CONTAINER_UNORDERED_SET_HPP
+#define BOOST_COMPUTE_CONTAINER_UNORDERED_SET_HPP
+
+#include <cstddef>
+
+#include <boost/compute/context.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/container/detail/hash_table.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class unordered_set
+/// \brief A hash set stored on a compute device.
+///
+/// The unordered_set class stores unique keys in an open-addressing hash
+/// table in device memory. All operations work on whole ranges of keys
+/// (stored on the device) and are performed by a single kernel with one
+/// work-item per key, making the container suitable for large batches of
+/// lookups against a slowly changing set of keys.
+///
+/// Keys must be 32-bit integers (\c int_ or \c uint_). Two key values are
+/// reserved to mark empty and erased slots and can not be inserted. By
+/// default these are the two largest values of the key type.
+///
+/// The table grows automatically when an insert would exceed the maximum
+/// load factor (0.5 by default).
+///
+/// \see unordered_map, flat_set
+template<class Key>
+class unordered_set
+{
+public:
+    typedef Key key_type;
+    typedef Key value_type;
+    typedef size_t size_type;
+
+    /// Creates an empty set in \p context.
+    explicit unordered_set(const context &context = system::default_context())
+        : m_table(
+              0,
+              detail::hash_table_key_traits<Key>::empty_key(),
+              detail::hash_table_key_traits<Key>::deleted_key(),
+              context
+          )
+    {
+    }
+
+    /// Creates an empty set with at least \p bucket_count buckets using
+    /// \p empty_key and \p deleted_key as the reserved keys.
+    unordered_set(size_type bucket_count,
+                  const key_type &empty_key,
+                  const key_type &deleted_key,
+                  const context &context = system::default_context())
+        : m_table(bucket_count, empty_key, deleted_key, context)
+    {
+    }
+
+    /// Creates a new set from \p other.
+    unordered_set(const unordered_set<Key> &other)
+        : m_table(other.m_table)
+    {
+    }
+
+    /// Copies the set from \p other.
+    unordered_set<Key>& operator=(const unordered_set<Key> &other)
+    {
+        if(this != &other){
+            m_table = other.m_table;
+        }
+
+        return *this;
+    }
+
+    ~unordered_set()
+    {
+    }
+
+    /// Returns the number of keys in the set.
+    size_type size() const
+    {
+        return m_table.size();
+    }
+
+    /// Returns \c true if the set is empty.
+    bool empty() const
+    {
+        return m_table.empty();
+    }
+
+    /// Returns the number of buckets in the hash table.
+    size_type bucket_count() const
+    {
+        return m_table.bucket_count();
+    }
+
+    /// Returns the average number of keys per bucket.
+    float load_factor() const
+    {
+        return m_table.load_factor();
+    }
+
+    /// Returns the maximum load factor.
+    float max_load_factor() const
+    {
+        return m_table.max_load_factor();
+    }
+
+    /// Sets the maximum load factor to \p factor (in the range (0, 1)).
+    void max_load_factor(float factor)
+    {
+        m_table.max_load_factor(factor);
+    }
+
+    /// Removes all keys from the set.
+    void clear(command_queue &queue)
+    {
+        m_table.clear(queue);
+    }
+
+    /// \overload
+    void clear()
+    {
+        command_queue queue = default_queue();
+        clear(queue);
+        queue.finish();
+    }
+
+    /// Rebuilds the hash table with at least \p count buckets.
+    void rehash(size_type count, command_queue &queue)
+    {
+        m_table.rehash(count, queue);
+    }
+
+    /// \overload
+    void rehash(size_type count)
+    {
+        command_queue queue = default_queue();
+        rehash(count, queue);
+        queue.finish();
+    }
+
+    /// Reserves space for \p count keys without exceeding the maximum
+    /// load factor.
+    void reserve(size_type count, command_queue &queue)
+    {
+        m_table.reserve(count, queue);
+    }
+
+    /// \overload
+    void reserve(size_type count)
+    {
+        command_queue queue = default_queue();
+        reserve(count, queue);
+        queue.finish();
+    }
+
+    /// Inserts the keys in the range [\p first, \p last) and returns the
+    /// number of keys inserted (keys already in the set are skipped).
+    template<class InputIterator>
+    size_type insert(InputIterator first, InputIterator last, command_queue &queue)
+    {
+        return m_table.insert(
+            first, detail::iterator_range_size(first, last), queue
+        );
+    }
+
+    /// \overload
+    template<class InputIterator>
+    size_type insert(InputIterator first, InputIterator last)
+    {
+        command_queue queue = default_queue();
+        size_type result = insert(first, last, queue);
+        queue.finish();
+        return result;
+    }
+
+    /// Erases the keys in the range [\p first, \p last) and returns the
+    /// number of keys erased.
+    template<class InputIterator>
+    size_type erase(InputIterator first, InputIterator last, command_queue &queue)
+    {
+        return m_table.erase(
+            first, detail::iterator_range_size(first, last), queue
+        );
+    }
+
+    /// \overload
+    template<class InputIterator>
+    size_type erase(InputIterator first, InputIterator last)
+    {
+        command_queue queue = default_queue();
+        size_type result = erase(first, last, queue);
+        queue.finish();
+        return result;
+    }
+
+    /// Writes \c 1 to \p result for each key in the range [\p first,
+    /// \p last) which is in the set and \c 0 otherwise. Returns the number
+    /// of keys found.
+    template<class InputIterator, class OutputIterator>
+    size_type contains(InputIterator first,
+                       InputIterator last,
+                       OutputIterator result,
+                       command_queue &queue) const
+    {
+        return m_table.lookup(
+            first,
+            detail::iterator_range_size(first, last),
+            result,
+            uchar_(0),
+            detail::hash_table_contains,
+            queue
+        );
+    }
+
+    /// \overload
+    template<class InputIterator, class OutputIterator>
+    size_type contains(InputIterator first,
+                       InputIterator last,
+                       OutputIterator result) const
+    {
+        command_queue queue = default_queue();
+        size_type found = contains(first, last, result, queue);
+        queue.finish();
+        return found;
+    }
+
+    /// Writes the number of elements (zero or one) equal to each key in
+    /// the range [\p first, \p last) to \p result.
+    ///
+    /// This is equivalent to contains().
+    template<class InputIterator, class OutputIterator>
+    size_type count(InputIterator first,
+                    InputIterator last,
+                    OutputIterator result,
+                    command_queue &queue) const
+    {
+        return contains(first, last, result, queue);
+    }
+
+    /// \overload
+    template<class InputIterator, class OutputIterator>
+    size_type count(InputIterator first,
+                    InputIterator last,
+                    OutputIterator result) const
+    {
+        return contains(first, last, result);
+    }
+
+private:
+    command_queue default_queue() const
+    {
+        return m_table.keys().default_queue();
+    }
+
+private:
+    detail::hash_table<Key, uchar_, false> m_table;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_CONTAINER_UNORDERED_SET_HPP
@@ -0,0 +1,356 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_ELEMENTWISE_KERNEL_HPP
+#define BOOST_COMPUTE_DETAIL_ELEMENTWISE_KERNEL_HPP
+
+#include <string>
+#include <sstream>
+#include <algorithm>
+
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/is_floating_point.hpp>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/device.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/work_size.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// A meta_kernel which executes a statement for each index in [0, count).
+//
+// Subclasses emit the statement between begin_loop() and end_loop() using
+// the "index" variable and launch the kernel with exec(). The loop has one
+// of two shapes:
+//
+//  - strided: each work-item processes a few values spaced a work-group
+//    apart so that neighbouring work-items access neighbouring values
+//    (coalesced accesses on GPUs).
+//
+//  - chunked: each work-item processes a contiguous chunk of the values in
+//    a single loop and only a few work-items are launched per compute unit.
+//    CPU runtimes run each work-item as a loop iteration on one of a few
+//    threads, so this avoids scheduling a work-item per value and gives
+//    the compiler an inner loop it can vectorize.
+//
+// The chunked shape is chosen for CPU devices.
+//
+// The loop can also be bounded by a count stored on the device (e.g. the
+// result size of a previous algorithm) with set_device_count(). The kernel
+// is then launched for the maximum count passed to exec() and the loop
+// exits early past the device count, so the count never has to be read
+// back by the host.
+//
+// Kernels over contiguous buffers of scalar builtin types can instead
+// process "width" values per index with vload/vstore (see vector_width()).
+// The values before the first aligned vector and after the last whole
+// vector are processed one at a time by the first work-item between
+// begin_scalar_loop() and end_scalar_loop(). The loop between begin_loop()
+// and end_loop() then runs over the vectors and the kernel is launched
+// with exec_vectors().
+class elementwise_kernel : public meta_kernel
+{
+public:
+    enum shape {
+        strided,
+        chunked
+    };
+
+    elementwise_kernel(const std::string &name, const device &device)
+        : meta_kernel(name),
+          m_shape(default_shape(device)),
+          m_count_arg(0),
+          m_n_arg(0),
+          m_head_arg(0),
+          m_vpt(4),
+          m_tpb(128)
+    {
+    }
+
+    // returns the loop shape used for device
+    static shape default_shape(const device &device)
+    {
+        return (device.type() & device::cpu) ? chunked : strided;
+    }
+
+    // sets the loop shape, must be called before begin_loop()
+    void set_shape(shape s)
+    {
+        m_shape = s;
+    }
+
+    shape get_shape() const
+    {
+        return m_shape;
+    }
+
+    // bounds the loop by the uint stored in count_buffer, must be called
+    // before begin_loop()
+    void set_device_count(const buffer &count_buffer)
+    {
+        m_device_count = get_buffer_identifier<uint_>(count_buffer);
+    }
+
+    // emits the start of the loop over the values, the current value is
+    // identified by the uint variable "index"
+    void begin_loop()
+    {
+        if(m_device_count.empty()){
+            m_count_arg = add_arg<uint_>("count");
+        }
+        else {
+            m_count_arg = add_arg<uint_>("max_count");
+            *this <<
+                "const uint count = min(max_count, " << m_device_count << "[0]);\n";
+        }
+
+        if(m_shape == chunked){
+            // chunks are a multiple of 16 values so that each work-item
+            // starts on a vector (and usually a cache line) boundary
+            *this <<
+                "const uint chunk = " <<
+                    "((count + get_global_size(0) - 1) / get_global_size(0) + 15) & ~15u;\n" <<
+                "const uint chunk_begin = min((uint) get_global_id(0) * chunk, count);\n" <<
+                "const uint chunk_end = min(chunk_begin + chunk, count);\n" <<
+                "for(uint index = chunk_begin; index < chunk_end; index++){\n";
+        }
+        else {
+            *this <<
+                "const uint first_index = get_local_id(0) + " <<
+                    "(" << m_vpt * m_tpb << " * get_group_id(0));\n" <<
+                "for(uint i = 0; i < " << m_vpt << "; i++){\n" <<
+                "    const uint index = first_index + i * " << m_tpb << ";\n" <<
+                "    if(index >= count) break;\n";
+        }
+    }
+
+    // emits the end of the loop started with begin_loop()
+    void end_loop()
+    {
+        *this << "}\n";
+    }
+
+    // emits the start of the loop over the values before the first
+    // vector and after the last vector, the current value is identified
+    // by the uint variable "index". must be called before begin_loop().
+    void begin_scalar_loop(uint_ width)
+    {
+        m_n_arg = add_arg<uint_>("n");
+        m_head_arg = add_arg<uint_>("head");
+
+        *this <<
+            "if(get_global_id(0) == 0){\n" <<
+            "    const uint vector_end = head + count * " << width << ";\n" <<
+            "    for(uint j = 0; j < head + n - vector_end; j++){\n" <<
+            "        const uint index = j < head ? j : vector_end + j - head;\n";
+    }
+
+    // emits the end of the loop started with begin_scalar_loop()
+    void end_scalar_loop()
+    {
+        *this << "    }\n}\n";
+    }
+
+    // returns the value of type T at index from pointer
+    template<class T>
+    meta_kernel_variable<typename kernel_value_type<T>::type>
+    load(const std::string &pointer) const
+    {
+        typedef typename kernel_value_type<T>::type value_type;
+
+        if(boost::is_same<T, half_>::value){
+            return make_expr<value_type>("vload_half(index, " + pointer + ")");
+        }
+
+        return make_expr<value_type>(pointer + "[index]");
+    }
+
+    // emits a store of value to pointer at index
+    template<class T, class Expr>
+    void store(const std::string &pointer, const Expr &value)
+    {
+        if(boost::is_same<T, half_>::value){
+            *this << "vstore_half(" << value << ", index, " << pointer << ");\n";
+        }
+        else {
+            *this << pointer << "[index] = " << value << ";\n";
+        }
+    }
+
+    // emits a declaration of the vector name holding the width values of
+    // type T at index in the vector loop from pointer
+    template<class T>
+    void vload(const std::string &name, const std::string &pointer, uint_ width)
+    {
+        *this <<
+            "const " << type<T>() << width << " " << name << " = " <<
+                vector_function<T>("vload", width) <<
+                    "(index, " << pointer << " + head);\n";
+    }
+
+    // emits a store of the vector value to pointer at index in the vector
+    // loop
+    template<class T>
+    void vstore(const std::string &value, const std::string &pointer, uint_ width)
+    {
+        *this <<
+            vector_function<T>("vstore", width) <<
+                "(" << value << ", index, " << pointer << " + head);\n";
+    }
+
+    // returns the name of the i'th component of a vector (e.g. "s3")
+    static std::string vector_component(uint_ i)
+    {
+        std::stringstream stream;
+        stream << "s" << std::hex << i;
+        return stream.str();
+    }
+
+    // returns the number of values of type T to load and store as a
+    // vector on device, or 0 if T cannot be loaded as a vector.
+    //
+    // this follows the device's preferred vector width but is at least
+    // four. devices which prefer scalar code (most GPUs) still load 128
+    // bits at a time for 32-bit types which is what their memory
+    // controllers are best at.
+    template<class T>
+    static uint_ vector_width(const device &device)
+    {
+        if(!boost::is_arithmetic<T>::value || boost::is_same<T, bool>::value){
+            if(!boost::is_same<T, half_>::value){
+                return 0;
+            }
+        }
+
+        uint_ preferred = 0;
+        if(boost::is_same<T, half_>::value){
+            // half values are loaded into float vectors
+            preferred = device.preferred_vector_width<float_>();
+        }
+        else if(boost::is_floating_point<T>::value){
+            preferred = sizeof(T) == sizeof(double_) ?
+                device.preferred_vector_width<double_>() :
+                device.preferred_vector_width<float_>();
+        }
+        else if(sizeof(T) == 1){
+            preferred = device.preferred_vector_width<char_>();
+        }
+        else if(sizeof(T) == 2){
+            preferred = device.preferred_vector_width<short_>();
+        }
+        else if(sizeof(T) == 4){
+            preferred = device.preferred_vector_width<int_>();
+        }
+        else if(sizeof(T) == 8){
+            preferred = device.preferred_vector_width<long_>();
+        }
+
+        if(preferred == 0){
+            // type not supported by the device (e.g. double without fp64)
+            return 0;
+        }
+        else if(preferred <= 4){
+            return 4;
+        }
+        else if(preferred <= 8){
+            return 8;
+        }
+        else {
+            return 16;
+        }
+    }
+
+    // returns the name of the vector load or store function for type T
+    // (e.g. "vload8" or "vload_half8")
+    template<class T>
+    static std::string vector_function(const char *name, uint_ width)
+    {
+        std::stringstream stream;
+        stream << name;
+        if(boost::is_same<T, half_>::value){
+            stream << "_half";
+        }
+        stream << width;
+        return stream.str();
+    }
+
+    // returns the number of scalar values to process before the first
+    // vector so that the vectors stored to a buffer starting at index
+    // are aligned
+    static size_t vector_head(size_t index, size_t count, uint_ width)
+    {
+        return (std::min)((width - index % width) % width, count);
+    }
+
+    // executes the kernel for count values processed width at a time
+    // starting after the first head values
+    event exec_vectors(command_queue &queue,
+                       size_t count,
+                       size_t head,
+                       uint_ width)
+    {
+        set_arg(m_n_arg, uint_(count));
+        set_arg(m_head_arg, uint_(head));
+
+        return exec(queue, (count - head) / width);
+    }
+
+    // executes the kernel for count values
+    event exec(command_queue &queue, size_t count)
+    {
+        if(count == 0){
+            // nothing to do
+            return event();
+        }
+
+        set_arg(m_count_arg, uint_(count));
+
+        if(m_shape == chunked){
+            // a few work-items per compute unit (for load balancing) but
+            // at least a few thousand values per work-item. each work-item
+            // is its own work-group so the runtime can spread them over
+            // its threads.
+            const size_t min_chunk = 4096;
+            const size_t max_work_items =
+                size_t(queue.get_device().compute_units()) * 4;
+            const size_t work_items = (std::max)(
+                size_t(1),
+                (std::min)(max_work_items, (count + min_chunk - 1) / min_chunk)
+            );
+
+            return exec_1d(queue, 0, work_items, 1);
+        }
+
+        const size_t global_work_size = calculate_work_size(count, m_vpt, m_tpb);
+
+        return exec_1d(queue, 0, global_work_size, m_tpb);
+    }
+
+private:
+    shape m_shape;
+    size_t m_count_arg;
+    size_t m_n_arg;
+    size_t m_head_arg;
+    uint_ m_vpt;
+    uint_ m_tpb;
+    std::string m_device_count;
+};
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_ELEMENTWISE_KERNEL_HPP
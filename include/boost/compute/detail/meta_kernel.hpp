@@ -338,18 +338,10 @@ public:
         // generate cache key
         std::string cache_key = detail::sha1(source);
 
-        // try to look the program up in the cache
+        // look the program up in the cache and build it if it is missing
         boost::shared_ptr<program_cache> cache = get_program_cache(context);
-        ::boost::compute::program program = cache->get(cache_key);
-
-        // build the program if it was not in the cache
-        if(!program.get()){
-            program = ::boost::compute::program::build_with_source(
-                source, context, options
-            );
-
-            cache->insert(cache_key, program);
-        }
+        ::boost::compute::program program =
+            cache->get_or_build(cache_key, options, source, context);
 
         // create kernel
         ::boost::compute::kernel kernel = program.create_kernel(name());
@@ -453,7 +445,14 @@ public:
             typename boost::remove_cv<
                 typename boost::remove_pointer<T>::type
             >::type Type;
-        stream << type_name<Type>();
+        if(boost::is_same<Type, half_>::value && !boost::is_pointer<T>::value){
+            // half values are only stored as half, kernels compute
+            // with them as float
+            stream << type_name<float_>();
+        }
+        else {
+            stream << type_name<Type>();
+        }
 
         // pointer
         if(boost::is_pointer<T>::value){
@@ -527,6 +526,11 @@ public:
     BOOST_COMPUTE_META_KERNEL_DECLARE_VECTOR_TYPE_STREAM_OPERATOR(float8_)
     BOOST_COMPUTE_META_KERNEL_DECLARE_VECTOR_TYPE_STREAM_OPERATOR(float16_)
 
+    meta_kernel& operator<<(const half_ &x)
+    {
+        return *this << float(x);
+    }
+
     // define stream operators for variable types
     template<class T>
     meta_kernel& operator<<(const meta_kernel_variable<T> &variable)
@@ -926,6 +930,42 @@ inline meta_kernel& operator<<(meta_kernel &kernel,
                   << "(" << expr.arg2() << "))";
 }
 
+// expression which stores value to iter[index]. the stream operator is
+// overloaded for iterators which store their values with a different type
+// than the one kernels compute with (e.g. buffer_iterator<half_>).
+template<class Iterator, class IndexExpr, class ValueExpr>
+struct store_expr
+{
+    store_expr(const Iterator &iter,
+               const IndexExpr &index,
+               const ValueExpr &value)
+        : m_iter(iter),
+          m_index(index),
+          m_value(value)
+    {
+    }
+
+    Iterator m_iter;
+    IndexExpr m_index;
+    ValueExpr m_value;
+};
+
+template<class Iterator, class IndexExpr, class ValueExpr>
+inline store_expr<Iterator, IndexExpr, ValueExpr>
+make_store_expr(const Iterator &iter,
+                const IndexExpr &index,
+                const ValueExpr &value)
+{
+    return store_expr<Iterator, IndexExpr, ValueExpr>(iter, index, value);
+}
+
+template<class Iterator, class IndexExpr, class ValueExpr>
+inline meta_kernel& operator<<(meta_kernel &kernel,
+                               const store_expr<Iterator, IndexExpr, ValueExpr> &expr)
+{
+    return kernel << expr.m_iter[expr.m_index] << '=' << expr.m_value;
+}
+
 template<class T, class IndexExpr>
 inline meta_kernel& operator<<(meta_kernel &kernel,
                                const detail::device_ptr_index_expr<T, IndexExpr> &expr)
@@ -11,22 +11,153 @@
 #ifndef BOOST_COMPUTE_DETAIL_PROGRAM_CACHE_HPP
 #define BOOST_COMPUTE_DETAIL_PROGRAM_CACHE_HPP
 
+#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include <boost/config.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/noncopyable.hpp>
+#include <boost/enable_shared_from_this.hpp>
 
 #include <boost/compute/context.hpp>
 #include <boost/compute/program.hpp>
+#include <boost/compute/user_event.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/async/detail/continuation.hpp>
 #include <boost/compute/detail/lru_cache.hpp>
 #include <boost/compute/detail/global_static.hpp>
 
+#ifndef BOOST_NO_CXX11_HDR_MUTEX
+#  include <mutex>
+#else
+#  include <boost/thread/mutex.hpp>
+#  include <boost/thread/locks.hpp>
+#endif
+
 namespace boost {
 namespace compute {
 namespace detail {
 
-class program_cache : boost::noncopyable
+// asynchronous builds complete on threads of the OpenCL runtime, so the
+// state updated by them is guarded by a mutex even without
+// BOOST_COMPUTE_THREAD_SAFE
+#ifndef BOOST_NO_CXX11_HDR_MUTEX
+typedef std::mutex program_cache_mutex;
+typedef std::lock_guard<std::mutex> program_cache_lock;
+#else
+typedef boost::mutex program_cache_mutex;
+typedef boost::lock_guard<boost::mutex> program_cache_lock;
+#endif
+
+class program_cache;
+
+#if defined(CL_VERSION_1_1)
+// programs being built asynchronously, shared by all threads so that
+// concurrent requests for the same program wait for a single build. once a
+// build completes its program is inserted into the program caches which
+// requested it and the build is removed so that the registry does not keep
+// programs (and contexts) alive.
+class pending_program_builds : boost::noncopyable
+{
+public:
+    typedef std::pair<cl_context, std::string> key_type;
+
+    // returns the pending build of key or starts building source. the
+    // program is inserted into cache under key once it has been built.
+    static future<program> get_or_start(const context &context,
+                                        const std::string &key,
+                                        const std::string &source,
+                                        const std::string &options,
+                                        const boost::weak_ptr<program_cache> &cache)
+    {
+        pending_program_builds &pending = instance();
+        const key_type k(context.get(), key);
+
+        future<program> build;
+        {
+            program_cache_lock lock(pending.m_mutex);
+
+            build_map::iterator iter = pending.m_builds.find(k);
+            if(iter != pending.m_builds.end()){
+                if(!cache.expired()){
+                    iter->second.caches.push_back(cache);
+                }
+                return iter->second.build;
+            }
+
+            build = program::build_with_source_async(source, context, options);
+
+            pending_build &entry = pending.m_builds[k];
+            entry.build = build;
+            if(!cache.expired()){
+                entry.caches.push_back(cache);
+            }
+        }
+
+        // registered without holding the lock as the callback may be called
+        // immediately if the build has already completed
+        set_status_callback(
+            build.get_event(), completion_callback(k, build.get_event())
+        );
+
+        return build;
+    }
+
+private:
+    struct pending_build
+    {
+        future<program> build;
+        std::vector<boost::weak_ptr<program_cache> > caches;
+    };
+
+    // inserts the program of the build of key into the caches which
+    // requested it and then removes the build
+    struct completion_callback
+    {
+        completion_callback(const key_type &key, const event &event_)
+            : m_key(key),
+              m_event(event_)
+        {
+        }
+
+        void operator()(cl_int status) const;
+
+        key_type m_key;
+        event m_event;
+    };
+
+    typedef std::map<key_type, pending_build> build_map;
+
+    // inserts prog under key into caches[first, caches.size())
+    static void insert_program(
+        const std::vector<boost::weak_ptr<program_cache> > &caches,
+        size_t first,
+        const std::string &key,
+        const program &prog);
+
+    static pending_program_builds& instance()
+    {
+        static pending_program_builds pending;
+
+        return pending;
+    }
+
+    pending_program_builds()
+    {
+    }
+
+    program_cache_mutex m_mutex;
+    build_map m_builds;
+};
+#endif // CL_VERSION_1_1
+
+class program_cache
+    : public boost::enable_shared_from_this<program_cache>,
+      boost::noncopyable
 {
 public:
     program_cache(size_t capacity)
@@ -40,6 +171,8 @@ public:
 
     size_t size() const
     {
+        program_cache_lock lock(m_mutex);
+
         return m_cache.size();
     }
 
@@ -50,18 +183,159 @@ public:
 
     void insert(const std::string &key, const program &program)
     {
+        program_cache_lock lock(m_mutex);
+
         m_cache.insert(key, program);
     }
 
     program get(const std::string &key)
     {
+        program_cache_lock lock(m_mutex);
+
         return m_cache.get(key);
     }
 
+    // returns the program for key, building it from source with options
+    // if it is not in the cache. waits for a pending asynchronous build of
+    // the program rather than starting another
+    program get_or_build(const std::string &key,
+                         const std::string &options,
+                         const std::string &source,
+                         const context &context)
+    {
+        const std::string cache_key = make_key(key, options);
+
+        program prog = get(cache_key);
+        if(!prog.get()){
+            #if defined(CL_VERSION_1_1)
+            if(context.get_device().check_version(1, 1)){
+                prog = pending_program_builds::get_or_start(
+                    context,
+                    cache_key,
+                    source,
+                    options,
+                    boost::weak_ptr<program_cache>()
+                ).get();
+            }
+            else
+            #endif
+            {
+                prog = program::build_with_source(source, context, options);
+            }
+
+            insert(cache_key, prog);
+        }
+
+        return prog;
+    }
+
+    #if defined(CL_VERSION_1_1)
+    // returns a future for the program for key, starting to build it from
+    // source with options if it is neither cached nor already being built.
+    // the program is inserted into the cache once it has been built, so
+    // the cache must be owned by a shared_ptr (see get_program_cache()).
+    future<program> get_or_build_async(const std::string &key,
+                                       const std::string &options,
+                                       const std::string &source,
+                                       const context &context)
+    {
+        const std::string cache_key = make_key(key, options);
+
+        program prog = get(cache_key);
+        if(prog.get()){
+            user_event done(context);
+            done.set_status(CL_COMPLETE);
+            return future<program>(prog, done);
+        }
+
+        return pending_program_builds::get_or_start(
+            context,
+            cache_key,
+            source,
+            options,
+            boost::weak_ptr<program_cache>(shared_from_this())
+        );
+    }
+    #endif // CL_VERSION_1_1
+
 private:
+    static std::string make_key(const std::string &key, const std::string &options)
+    {
+        return options.empty() ? key : key + "," + options;
+    }
+
+private:
+    mutable program_cache_mutex m_mutex;
     lru_cache<std::string, program> m_cache;
 };
 
+#if defined(CL_VERSION_1_1)
+inline void
+pending_program_builds::completion_callback::operator()(cl_int status) const
+{
+    pending_program_builds &pending = instance();
+
+    pending_build entry;
+    {
+        program_cache_lock lock(pending.m_mutex);
+
+        // the build may already have been replaced by a newer one
+        build_map::iterator iter = pending.m_builds.find(m_key);
+        if(iter == pending.m_builds.end() ||
+           iter->second.build.get_event() != m_event){
+            return;
+        }
+
+        entry = iter->second;
+    }
+
+    // the build stays registered until the program is in the caches so
+    // that requests in between wait for it rather than building it again
+    program prog;
+    if(status == CL_COMPLETE){
+        try {
+            prog = entry.build.get();
+        }
+        catch(...){
+            // build errors are reported by the futures of the build
+        }
+    }
+
+    if(prog.get()){
+        insert_program(entry.caches, 0, m_key.second, prog);
+    }
+
+    program_cache_lock lock(pending.m_mutex);
+
+    build_map::iterator iter = pending.m_builds.find(m_key);
+    if(iter != pending.m_builds.end() &&
+       iter->second.build.get_event() == m_event){
+        // caches which requested the program since it was copied
+        if(prog.get()){
+            insert_program(
+                iter->second.caches, entry.caches.size(), m_key.second, prog
+            );
+        }
+
+        pending.m_builds.erase(iter);
+    }
+}
+
+inline void pending_program_builds::insert_program(
+    const std::vector<boost::weak_ptr<program_cache> > &caches,
+    size_t first,
+    const std::string &key,
+    const program &prog)
+{
+    for(size_t i = first; i < caches.size(); i++){
+        boost::shared_ptr<program_cache> cache = caches[i].lock();
+        if(cache){
+            cache->insert(key, prog);
+        }
+    }
+}
+#endif // CL_VERSION_1_1
+
 // returns the program cache for the context
 inline boost::shared_ptr<program_cache> get_program_cache(const context &context)
 {
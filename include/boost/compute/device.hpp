@@ -382,6 +382,77 @@ public:
 
         return partition(properties);
     }
+
+    /// Returns \c true if the device can be partitioned with the
+    /// partitioning scheme \p type (e.g. \c CL_DEVICE_PARTITION_EQUALLY).
+    ///
+    /// \opencl_version_warning{1,2}
+    bool supports_partition_type(cl_device_partition_property type) const
+    {
+        const std::vector<cl_device_partition_property> properties =
+            get_info<std::vector<cl_device_partition_property> >(
+                CL_DEVICE_PARTITION_PROPERTIES
+            );
+
+        return boost::find(properties, type) != properties.end();
+    }
+
+    /// Returns \c true if the device can be partitioned along the affinity
+    /// domain \p domain (e.g. \c CL_DEVICE_AFFINITY_DOMAIN_NUMA).
+    ///
+    /// \opencl_version_warning{1,2}
+    bool supports_affinity_domain(cl_device_affinity_domain domain) const
+    {
+        if(!supports_partition_type(CL_DEVICE_PARTITION_BY_AFFINITY_DOMAIN)){
+            return false;
+        }
+
+        return (get_info<cl_device_affinity_domain>(
+                    CL_DEVICE_PARTITION_AFFINITY_DOMAIN) & domain) != 0;
+    }
+
+    /// Partitions the device into one sub-device per NUMA node. If the
+    /// device cannot be partitioned by NUMA node a vector containing only
+    /// the device itself is returned.
+    ///
+    /// Sub-devices returned by this method can be used with their own
+    /// context and command queue to keep both the work-items executing
+    /// on a node and the memory they touch local to that node:
+    /// \code
+    /// std::vector<device> nodes = cpu.partition_by_numa_node();
+    /// context node_context(nodes[0]);
+    /// command_queue node_queue(node_context, nodes[0]);
+    /// \endcode
+    ///
+    /// \opencl_version_warning{1,2}
+    ///
+    /// \see numa_allocator
+    std::vector<device> partition_by_numa_node() const
+    {
+        if(!supports_affinity_domain(CL_DEVICE_AFFINITY_DOMAIN_NUMA)){
+            return std::vector<device>(1, *this);
+        }
+
+        return partition_by_affinity_domain(CL_DEVICE_AFFINITY_DOMAIN_NUMA);
+    }
+
+    /// Returns the parent device for a sub-device. Returns a null device
+    /// if the device is not a sub-device.
+    ///
+    /// \opencl_version_warning{1,2}
+    device parent_device() const
+    {
+        return device(get_info<cl_device_id>(CL_DEVICE_PARENT_DEVICE));
+    }
+
+    /// Returns the maximum number of sub-devices the device can be
+    /// partitioned into.
+    ///
+    /// \opencl_version_warning{1,2}
+    uint_ partition_max_sub_devices() const
+    {
+        return get_info<uint_>(CL_DEVICE_PARTITION_MAX_SUB_DEVICES);
+    }
     #endif // CL_VERSION_1_2
 
     /// Returns \c true if the device is the same at \p other.
@@ -416,6 +487,13 @@ private:
     cl_device_id m_id;
 };
 
+/// \internal_
+template<>
+inline uint_ device::preferred_vector_width<char_>() const
+{
+    return get_info<uint_>(CL_DEVICE_PREFERRED_VECTOR_WIDTH_CHAR);
+}
+
 /// \internal_
 template<>
 inline uint_ device::preferred_vector_width<short_>() const
@@ -11,10 +11,11 @@
 #ifndef BOOST_COMPUTE_EXPERIMENTAL_TRANSFORM_IF_HPP
 #define BOOST_COMPUTE_EXPERIMENTAL_TRANSFORM_IF_HPP
 
+#include <iterator>
+
 #include <boost/compute/command_queue.hpp>
-#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/elementwise_kernel.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
-#include <boost/compute/algorithm/detail/copy_on_device.hpp>
 
 namespace boost {
 namespace compute {
@@ -39,19 +40,17 @@ inline OutputIterator transform_if(InputIterator first,
         return result;
     }
 
-    detail::meta_kernel k("transform_if");
+    detail::elementwise_kernel k("transform_if", queue.get_device());
 
+    k.begin_loop();
     k <<
-        k.if_(predicate(first[k.get_global_id(0)])) << "{\n" <<
-            result[k.get_global_id(0)] << '=' <<
-                op(first[k.get_global_id(0)]) << ";\n"
+        k.if_(predicate(first[k.var<uint_>("index")])) << "{\n" <<
+            result[k.var<uint_>("index")] << '=' <<
+                op(first[k.var<uint_>("index")]) << ";\n"
         "}\n";
+    k.end_loop();
 
-    const device &device = queue.get_device();
-    const size_t work_group_size =
-        detail::pick_copy_work_group_size(count, device);
-
-    k.exec_1d(queue, 0, count, work_group_size);
+    k.exec(queue, static_cast<size_t>(count));
 
     return result + count;
 }
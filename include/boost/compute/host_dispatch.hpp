@@ -0,0 +1,267 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_HOST_DISPATCH_HPP
+#define BOOST_COMPUTE_HOST_DISPATCH_HPP
+
+#include <map>
+#include <cstdlib>
+#include <iterator>
+
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/device.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/detail/getenv.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+
+#ifdef BOOST_COMPUTE_THREAD_SAFE
+#  ifdef BOOST_COMPUTE_HAVE_THREAD_LOCAL
+#    include <mutex>
+#  else
+#    include <boost/thread/mutex.hpp>
+#    include <boost/thread/locks.hpp>
+#  endif
+#endif
+
+namespace boost {
+namespace compute {
+
+/// \class host_dispatch
+/// \brief Selects between running an algorithm on the host and on the
+///        device based on the size of its input.
+///
+/// Launching a kernel costs a fixed amount of time (generating and looking
+/// up its program, enqueuing it and waiting for the result) which for
+/// small inputs is far more than the time taken by the equivalent \c std
+/// algorithm. Algorithms which support it check the size of their input
+/// against a per-device threshold and, when it is not greater, run the
+/// \c std algorithm on the host instead. Device data is accessed by
+/// mapping its buffer, which on CPU devices does not copy it.
+///
+/// The thresholds start at defaults chosen for the type of the device.
+/// They can be overridden with the \c BOOST_COMPUTE_HOST_DISPATCH_SORT,
+/// \c BOOST_COMPUTE_HOST_DISPATCH_COUNT and \c BOOST_COMPUTE_HOST_DISPATCH_FIND
+/// environment variables, set with set_threshold(), or measured for a
+/// device with calibrate_host_dispatch(). A threshold of zero always runs
+/// the algorithm on the device. The thresholds are shared by all threads
+/// of the process.
+///
+/// \see calibrate_host_dispatch()
+class host_dispatch
+{
+public:
+    /// Algorithms with a host implementation.
+    enum algorithm {
+        sort_algorithm = 0,
+        count_algorithm,
+        find_algorithm,
+        algorithm_count
+    };
+
+    /// Returns the largest input size for which \p algorithm runs on the
+    /// host for \p device.
+    static size_t threshold(const device &device, algorithm algorithm)
+    {
+        registry &r = get_registry();
+        lock_type lock(r.mutex);
+
+        return get_thresholds(r, device).values[algorithm];
+    }
+
+    /// Sets the largest input size for which \p algorithm runs on the host
+    /// for \p device to \p size. The threshold is shared by all threads.
+    static void set_threshold(const device &device,
+                              algorithm algorithm,
+                              size_t size)
+    {
+        registry &r = get_registry();
+        lock_type lock(r.mutex);
+
+        get_thresholds(r, device).values[algorithm] = size;
+    }
+
+    /// Returns the name of \p algorithm.
+    static const char* name(algorithm algorithm)
+    {
+        static const char *names[] = { "sort", "count", "find" };
+
+        return names[algorithm];
+    }
+
+private:
+    struct thresholds
+    {
+        size_t values[algorithm_count];
+    };
+
+    typedef std::map<cl_device_id, thresholds> threshold_map;
+
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+    #  ifdef BOOST_COMPUTE_HAVE_THREAD_LOCAL
+    typedef std::mutex mutex_type;
+    typedef std::lock_guard<std::mutex> lock_type;
+    #  else
+    typedef boost::mutex mutex_type;
+    typedef boost::lock_guard<boost::mutex> lock_type;
+    #  endif
+    #else
+    struct mutex_type { };
+    struct lock_type { explicit lock_type(mutex_type &) { } };
+    #endif
+
+    // thresholds of each device, shared by all threads
+    struct registry
+    {
+        mutex_type mutex;
+        threshold_map devices;
+    };
+
+    static registry& get_registry()
+    {
+        static registry r;
+
+        return r;
+    }
+
+    // returns the thresholds of device, the registry's mutex must be held
+    static thresholds& get_thresholds(registry &r, const device &device)
+    {
+        threshold_map::iterator iter = r.devices.find(device.id());
+        if(iter == r.devices.end()){
+            iter = r.devices.insert(
+                std::make_pair(device.id(), default_thresholds(device))
+            ).first;
+        }
+
+        return iter->second;
+    }
+
+    static thresholds default_thresholds(const device &device)
+    {
+        thresholds t;
+
+        if(device.type() & device::cpu){
+            // the device shares the host's memory and processors so only
+            // large inputs amortize the cost of the kernel launch
+            t.values[sort_algorithm] = 2048;
+            t.values[count_algorithm] = 32768;
+            t.values[find_algorithm] = 32768;
+        }
+        else {
+            // mapping device memory transfers it, so only inputs which
+            // would otherwise be handled by a single work-item are moved
+            t.values[sort_algorithm] = 32;
+            t.values[count_algorithm] = 32;
+            t.values[find_algorithm] = 32;
+        }
+
+        static const char *variables[] = {
+            "BOOST_COMPUTE_HOST_DISPATCH_SORT",
+            "BOOST_COMPUTE_HOST_DISPATCH_COUNT",
+            "BOOST_COMPUTE_HOST_DISPATCH_FIND"
+        };
+
+        for(size_t i = 0; i < algorithm_count; i++){
+            if(const char *value = detail::getenv(variables[i])){
+                t.values[i] = static_cast<size_t>(std::strtoul(value, 0, 10));
+            }
+        }
+
+        return t;
+    }
+};
+
+namespace detail {
+
+// maps the values in the range [first, first + count) of a buffer for
+// access on the host while in scope
+template<class T>
+class scoped_host_map
+{
+public:
+    scoped_host_map(const buffer_iterator<T> &first,
+                    size_t count,
+                    cl_map_flags flags,
+                    command_queue &queue)
+        : m_buffer(first.get_buffer()),
+          m_queue(queue)
+    {
+        m_pointer = static_cast<T *>(
+            queue.enqueue_map_buffer(
+                m_buffer, flags, first.get_index() * sizeof(T), count * sizeof(T)
+            )
+        );
+        m_count = count;
+    }
+
+    ~scoped_host_map()
+    {
+        m_queue.enqueue_unmap_buffer(m_buffer, m_pointer);
+    }
+
+    T* begin() const
+    {
+        return m_pointer;
+    }
+
+    T* end() const
+    {
+        return m_pointer + m_count;
+    }
+
+private:
+    buffer m_buffer;
+    command_queue m_queue;
+    T *m_pointer;
+    size_t m_count;
+};
+
+// true if the values of the iterator are stored in a buffer and can be
+// processed by the std algorithms
+template<class Iterator>
+struct is_host_dispatchable : boost::integral_constant<
+    bool,
+    boost::is_same<
+        Iterator,
+        buffer_iterator<typename std::iterator_traits<Iterator>::value_type>
+    >::value &&
+    boost::is_arithmetic<
+        typename std::iterator_traits<Iterator>::value_type
+    >::value
+> {};
+
+// returns true if algorithm should run on the host for the (non-empty)
+// range
+template<class Iterator>
+inline bool dispatch_to_host(Iterator first,
+                             Iterator last,
+                             host_dispatch::algorithm algorithm,
+                             command_queue &queue)
+{
+    if(!is_host_dispatchable<Iterator>::value){
+        return false;
+    }
+
+    const size_t count = iterator_range_size(first, last);
+
+    return count > 0 &&
+           count <= host_dispatch::threshold(queue.get_device(), algorithm);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_HOST_DISPATCH_HPP
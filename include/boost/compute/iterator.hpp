@@ -21,6 +21,7 @@
 #include <boost/compute/iterator/counting_iterator.hpp>
 #include <boost/compute/iterator/discard_iterator.hpp>
 #include <boost/compute/iterator/function_input_iterator.hpp>
+#include <boost/compute/iterator/packed_iterator.hpp>
 #include <boost/compute/iterator/permutation_iterator.hpp>
 #include <boost/compute/iterator/transform_iterator.hpp>
 #include <boost/compute/iterator/zip_iterator.hpp>
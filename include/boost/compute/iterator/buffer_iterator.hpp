@@ -51,7 +51,7 @@ public:
 template<class T, class IndexExpr>
 struct buffer_iterator_index_expr
 {
-    typedef T result_type;
+    typedef typename kernel_value_type<T>::type result_type;
 
     buffer_iterator_index_expr(const buffer &buffer,
                                size_t index,
@@ -94,6 +94,25 @@ inline meta_kernel& operator<<(meta_kernel &kernel,
     }
 }
 
+// half values are loaded with vload_half()
+template<class IndexExpr>
+inline meta_kernel& operator<<(meta_kernel &kernel,
+                               const buffer_iterator_index_expr<half_, IndexExpr> &expr)
+{
+    kernel << "vload_half(";
+    if(expr.m_index == 0){
+        kernel << expr.m_expr;
+    }
+    else {
+        kernel << uint_(expr.m_index) << "+(" << expr.m_expr << ")";
+    }
+
+    return kernel <<
+               ", " <<
+               kernel.get_buffer_identifier<half_>(expr.m_buffer, expr.m_address_space) <<
+               ')';
+}
+
 } // end detail namespace
 
 /// \class buffer_iterator
@@ -258,6 +277,27 @@ struct is_device_iterator<
     >::type
 > : public boost::true_type {};
 
+// half values are stored with vstore_half()
+template<class IndexExpr, class ValueExpr>
+inline meta_kernel& operator<<(meta_kernel &kernel,
+                               const store_expr<buffer_iterator<half_>,
+                                                IndexExpr,
+                                                ValueExpr> &expr)
+{
+    kernel << "vstore_half(" << expr.m_value << ", ";
+    if(expr.m_iter.get_index() == 0){
+        kernel << expr.m_index;
+    }
+    else {
+        kernel << uint_(expr.m_iter.get_index()) << "+(" << expr.m_index << ")";
+    }
+
+    return kernel <<
+               ", " <<
+               kernel.get_buffer_identifier<half_>(expr.m_iter.get_buffer()) <<
+               ')';
+}
+
 } // end detail namespace
 
 } // end compute namespace
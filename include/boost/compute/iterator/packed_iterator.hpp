@@ -0,0 +1,303 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ITERATOR_PACKED_ITERATOR_HPP
+#define BOOST_COMPUTE_ITERATOR_PACKED_ITERATOR_HPP
+
+#include <string>
+#include <cstddef>
+#include <climits>
+#include <iterator>
+
+#include <boost/config.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_signed.hpp>
+#include <boost/type_traits/remove_const.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/types/builtin.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/is_device_iterator.hpp>
+
+namespace boost {
+namespace compute {
+
+// forward declaration for packed_iterator_base
+template<class T, size_t Bits, bool FrameOfReference>
+class packed_iterator;
+
+namespace detail {
+
+// helper class which defines the iterator_facade super-class
+// type for packed_iterator
+template<class T, size_t Bits, bool FrameOfReference>
+class packed_iterator_base
+{
+public:
+    typedef ::boost::iterator_facade<
+        ::boost::compute::packed_iterator<T, Bits, FrameOfReference>,
+        T,
+        ::std::random_access_iterator_tag,
+        T
+    > type;
+};
+
+// returns the bits wide value starting at bit in words. each value is
+// read from the two words it may straddle, so the words are followed by
+// an extra padding word.
+inline std::string packed_unpack_function()
+{
+    return
+        "inline uint boost_packed_unpack(__global const uint *words,\n"
+        "                                const ulong bit,\n"
+        "                                const uint bits)\n"
+        "{\n"
+        "    const ulong i = bit >> 5;\n"
+        "    const ulong pair = ((ulong) words[i + 1] << 32) | words[i];\n"
+        "    return (uint)(pair >> (bit & 31)) & (0xffffffffu >> (32 - bits));\n"
+        "}\n";
+}
+
+template<class T, size_t Bits, bool FrameOfReference, class IndexExpr>
+struct packed_iterator_index_expr
+{
+    typedef T result_type;
+
+    packed_iterator_index_expr(const buffer &words,
+                               const buffer &bases,
+                               size_t index,
+                               const IndexExpr &expr)
+        : m_words(words),
+          m_bases(bases),
+          m_index(index),
+          m_expr(expr)
+    {
+    }
+
+    const buffer &m_words;
+    const buffer &m_bases;
+    size_t m_index;
+    IndexExpr m_expr;
+};
+
+template<class T, size_t Bits, bool FrameOfReference, class IndexExpr>
+inline meta_kernel& operator<<(meta_kernel &kernel,
+                               const packed_iterator_index_expr<T,
+                                                                Bits,
+                                                                FrameOfReference,
+                                                                IndexExpr> &expr)
+{
+    kernel.add_function("boost_packed_unpack", packed_unpack_function());
+
+    const std::string words = kernel.get_buffer_identifier<uint_>(expr.m_words);
+
+    kernel << "((" << type_name<T>() << ")(";
+
+    if(FrameOfReference){
+        // values are stored as the difference to their block's base
+        kernel << kernel.get_buffer_identifier<T>(expr.m_bases) <<
+                  "[(" << uint_(expr.m_index) << "+(" << expr.m_expr << "))/" <<
+                  uint_(packed_iterator<T, Bits, FrameOfReference>::block_size) <<
+                  "]+(" << type_name<T>() << ")";
+    }
+    else if(boost::is_signed<T>::value){
+        // sign-extend the value from its top bit
+        kernel << "((int)(";
+    }
+
+    kernel << "boost_packed_unpack(" << words << ",(ulong)(" <<
+              uint_(expr.m_index) << "+(" << expr.m_expr << "))*" << uint_(Bits) <<
+              "," << uint_(Bits) << ")";
+
+    if(!FrameOfReference && boost::is_signed<T>::value){
+        kernel << "<<" << uint_(32 - Bits) << ")>>" << uint_(32 - Bits) << ")";
+    }
+
+    return kernel << "))";
+}
+
+} // end detail namespace
+
+/// \class packed_iterator
+/// \brief An iterator over integers packed into \p Bits bits each.
+///
+/// The packed_iterator class iterates over the values of a packed_vector.
+/// The values are unpacked inline in the kernels which read them, so
+/// algorithms scanning a packed range read only \p Bits bits per value
+/// from memory.
+///
+/// If \p FrameOfReference is \c true, each value is stored as its
+/// difference to the smallest value of its block of \c block_size values
+/// and the base of the block is added back when the value is read.
+///
+/// Packed iterators are input-only. Ranges of packed values are written
+/// with packed_vector::assign().
+///
+/// \see packed_vector
+template<class T, size_t Bits, bool FrameOfReference = false>
+class packed_iterator
+    : public detail::packed_iterator_base<T, Bits, FrameOfReference>::type
+{
+public:
+    typedef typename
+        detail::packed_iterator_base<T, Bits, FrameOfReference>::type super_type;
+    typedef typename super_type::value_type value_type;
+    typedef typename super_type::reference reference;
+    typedef typename super_type::difference_type difference_type;
+
+    BOOST_STATIC_ASSERT(boost::is_integral<T>::value);
+    BOOST_STATIC_ASSERT(Bits > 0 && Bits <= 32);
+    BOOST_STATIC_ASSERT(FrameOfReference || Bits <= sizeof(T) * CHAR_BIT);
+
+    BOOST_STATIC_CONSTANT(size_t, bits = Bits);
+    BOOST_STATIC_CONSTANT(bool, frame_of_reference = FrameOfReference);
+    BOOST_STATIC_CONSTANT(size_t, block_size = 128);
+
+    packed_iterator()
+        : m_index(0)
+    {
+    }
+
+    packed_iterator(const buffer &words, const buffer &bases, size_t index)
+        : m_words(words.get(), false),
+          m_bases(bases.get(), false),
+          m_index(index)
+    {
+    }
+
+    packed_iterator(const packed_iterator<T, Bits, FrameOfReference> &other)
+        : m_words(other.m_words.get(), false),
+          m_bases(other.m_bases.get(), false),
+          m_index(other.m_index)
+    {
+    }
+
+    packed_iterator<T, Bits, FrameOfReference>&
+    operator=(const packed_iterator<T, Bits, FrameOfReference> &other)
+    {
+        if(this != &other){
+            m_words.get() = other.m_words.get();
+            m_bases.get() = other.m_bases.get();
+            m_index = other.m_index;
+        }
+
+        return *this;
+    }
+
+    ~packed_iterator()
+    {
+        // set memory objects to null so that their
+        // destructors do not try to decrement their
+        // reference counts
+        m_words.get() = 0;
+        m_bases.get() = 0;
+    }
+
+    /// Returns the buffer holding the packed bits.
+    const buffer& get_words_buffer() const
+    {
+        return m_words;
+    }
+
+    /// Returns the buffer holding the block bases. The buffer is null if
+    /// \p FrameOfReference is \c false.
+    const buffer& get_bases_buffer() const
+    {
+        return m_bases;
+    }
+
+    size_t get_index() const
+    {
+        return m_index;
+    }
+
+    /// \internal_
+    template<class IndexExpr>
+    detail::packed_iterator_index_expr<T, Bits, FrameOfReference, IndexExpr>
+    operator[](const IndexExpr &expr) const
+    {
+        return detail::packed_iterator_index_expr<
+                   T, Bits, FrameOfReference, IndexExpr
+               >(m_words, m_bases, m_index, expr);
+    }
+
+private:
+    friend class ::boost::iterator_core_access;
+
+    /// \internal_
+    reference dereference() const
+    {
+        return T();
+    }
+
+    /// \internal_
+    bool equal(const packed_iterator<T, Bits, FrameOfReference> &other) const
+    {
+        return m_words.get() == other.m_words.get() &&
+               m_index == other.m_index;
+    }
+
+    /// \internal_
+    void increment()
+    {
+        m_index++;
+    }
+
+    /// \internal_
+    void decrement()
+    {
+        m_index--;
+    }
+
+    /// \internal_
+    void advance(difference_type n)
+    {
+        m_index = static_cast<size_t>(static_cast<difference_type>(m_index) + n);
+    }
+
+    /// \internal_
+    difference_type
+    distance_to(const packed_iterator<T, Bits, FrameOfReference> &other) const
+    {
+        return static_cast<difference_type>(other.m_index - m_index);
+    }
+
+private:
+    buffer m_words;
+    buffer m_bases;
+    size_t m_index;
+};
+
+namespace detail {
+
+// is_device_iterator specialization for packed_iterator
+template<class Iterator>
+struct is_device_iterator<
+    Iterator,
+    typename boost::enable_if<
+        boost::is_same<
+            packed_iterator<typename Iterator::value_type,
+                            Iterator::bits,
+                            Iterator::frame_of_reference>,
+            typename boost::remove_const<Iterator>::type
+        >
+    >::type
+> : public boost::true_type {};
+
+} // end detail namespace
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ITERATOR_PACKED_ITERATOR_HPP
@@ -0,0 +1,353 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_KERNEL_BUNDLE_HPP
+#define BOOST_COMPUTE_KERNEL_BUNDLE_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iterator>
+
+#include <boost/cstdint.hpp>
+
+#include <boost/compute/detail/getenv.hpp>
+
+#ifdef BOOST_COMPUTE_THREAD_SAFE
+#  ifdef BOOST_COMPUTE_HAVE_THREAD_LOCAL
+#    include <mutex>
+#  else
+#    include <boost/thread/mutex.hpp>
+#    include <boost/thread/locks.hpp>
+#  endif
+#endif
+
+namespace boost {
+namespace compute {
+
+/// \class kernel_bundle
+/// \brief A set of program binaries compiled ahead of time.
+///
+/// Every program built with program::build_with_source() (which includes
+/// the programs of all the Boost.Compute algorithms) is first looked up in
+/// the kernel bundle. Programs are identified by their source, build
+/// options, device, driver version and platform version, so binaries built
+/// with another driver are never found and programs whose binaries fail to
+/// load are built from source as usual.
+///
+/// Bundles are created by the \c kernel_bundle build target (see the
+/// \c tools directory), which runs a configurable list of algorithms for
+/// each device while recording the programs they build. The bundle is
+/// loaded from the file named by the \c BOOST_COMPUTE_KERNEL_BUNDLE
+/// environment variable on first use, or explicitly with load():
+/// \code
+/// // load binaries embedded with the generated header
+/// #include "boost_compute_kernels.hpp"
+///
+/// boost::compute::kernel_bundle::load(
+///     boost_compute_kernel_bundle_data, sizeof(boost_compute_kernel_bundle_data)
+/// );
+/// \endcode
+///
+/// The bundle is shared by all threads and may be loaded or recorded while
+/// other threads build programs.
+///
+/// \see program::build_with_source()
+class kernel_bundle
+{
+public:
+    /// Adds the binaries in the bundle file at \p path. Returns \c false
+    /// if the file cannot be read or is not a valid bundle.
+    static bool load(const std::string &path)
+    {
+        entry_map entries;
+        if(!load_file(entries, path)){
+            return false;
+        }
+
+        merge(entries);
+        return true;
+    }
+
+    /// Adds the binaries in the bundle of \p size bytes at \p data.
+    /// Returns \c false if the data is not a valid bundle.
+    static bool load(const unsigned char *data, size_t size)
+    {
+        entry_map entries;
+        if(!parse(entries, data, size)){
+            return false;
+        }
+
+        merge(entries);
+        return true;
+    }
+
+    /// Writes the binaries in the bundle to the file at \p path. Returns
+    /// \c false if the file cannot be written.
+    static bool save(const std::string &path)
+    {
+        state &s = get_state();
+        lock_type lock(s.mutex);
+
+        std::ofstream stream(path.c_str(), std::ios::out | std::ios::binary);
+        if(!stream){
+            return false;
+        }
+
+        stream.write(magic(), 4);
+        write_integer<uint32_t>(stream, version());
+        write_integer<uint32_t>(stream, static_cast<uint32_t>(s.entries.size()));
+
+        for(entry_map::const_iterator i = s.entries.begin(); i != s.entries.end(); ++i){
+            write_integer<uint32_t>(stream, static_cast<uint32_t>(i->first.size()));
+            stream.write(i->first.data(), i->first.size());
+            write_integer<uint64_t>(stream, i->second.size());
+            if(!i->second.empty()){
+                stream.write(
+                    reinterpret_cast<const char *>(&i->second[0]), i->second.size()
+                );
+            }
+        }
+
+        return static_cast<bool>(stream);
+    }
+
+    /// Returns the number of binaries in the bundle.
+    static size_t size()
+    {
+        state &s = get_state();
+        lock_type lock(s.mutex);
+
+        return s.entries.size();
+    }
+
+    /// Removes all binaries from the bundle.
+    static void clear()
+    {
+        state &s = get_state();
+        lock_type lock(s.mutex);
+
+        s.entries.clear();
+    }
+
+    /// Enables or disables recording. While recording, the binary of every
+    /// program built from source is added to the bundle.
+    static void set_recording(bool enable)
+    {
+        state &s = get_state();
+        lock_type lock(s.mutex);
+
+        s.recording = enable;
+    }
+
+    /// Returns \c true if the binaries of built programs are being added to
+    /// the bundle.
+    static bool is_recording()
+    {
+        state &s = get_state();
+        lock_type lock(s.mutex);
+
+        return s.recording;
+    }
+
+    /// \internal_
+    static bool is_enabled()
+    {
+        state &s = get_state();
+        lock_type lock(s.mutex);
+
+        return s.recording || !s.entries.empty();
+    }
+
+    /// \internal_
+    ///
+    /// Copies the binary for \p key to \p binary. Returns \c false if the
+    /// bundle has no binary for \p key.
+    static bool find(const std::string &key, std::vector<unsigned char> &binary)
+    {
+        state &s = get_state();
+        lock_type lock(s.mutex);
+
+        entry_map::const_iterator i = s.entries.find(key);
+        if(i == s.entries.end()){
+            return false;
+        }
+
+        binary = i->second;
+        return true;
+    }
+
+    /// \internal_
+    static void insert(const std::string &key,
+                       const std::vector<unsigned char> &binary)
+    {
+        state &s = get_state();
+        lock_type lock(s.mutex);
+
+        s.entries[key] = binary;
+    }
+
+private:
+    typedef std::map<std::string, std::vector<unsigned char> > entry_map;
+
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+    #  ifdef BOOST_COMPUTE_HAVE_THREAD_LOCAL
+    typedef std::mutex mutex_type;
+    typedef std::lock_guard<std::mutex> lock_type;
+    #  else
+    typedef boost::mutex mutex_type;
+    typedef boost::lock_guard<boost::mutex> lock_type;
+    #  endif
+    #else
+    struct mutex_type { };
+    struct lock_type { explicit lock_type(mutex_type &) { } };
+    #endif
+
+    struct state
+    {
+        state()
+            : recording(false)
+        {
+            if(const char *path = detail::getenv("BOOST_COMPUTE_KERNEL_BUNDLE")){
+                load_file(entries, path);
+            }
+        }
+
+        mutex_type mutex;
+        entry_map entries;
+        bool recording;
+    };
+
+    static state& get_state()
+    {
+        // shared by all threads (unlike BOOST_COMPUTE_DETAIL_GLOBAL_STATIC)
+        // so a bundle only needs to be loaded once
+        static state s;
+
+        return s;
+    }
+
+    // adds entries to the bundle, replacing binaries with the same keys
+    static void merge(entry_map &entries)
+    {
+        state &s = get_state();
+        lock_type lock(s.mutex);
+
+        for(entry_map::iterator i = entries.begin(); i != entries.end(); ++i){
+            s.entries[i->first].swap(i->second);
+        }
+    }
+
+    static const char* magic()
+    {
+        return "BCKB";
+    }
+
+    static uint32_t version()
+    {
+        return 1;
+    }
+
+    template<class Integer>
+    static void write_integer(std::ostream &stream, Integer value)
+    {
+        // little-endian regardless of the host
+        for(size_t i = 0; i < sizeof(Integer); i++){
+            stream.put(static_cast<char>((value >> (8 * i)) & 0xff));
+        }
+    }
+
+    template<class Integer>
+    static bool read_integer(const unsigned char *&data,
+                             const unsigned char *end,
+                             Integer &value)
+    {
+        if(size_t(end - data) < sizeof(Integer)){
+            return false;
+        }
+
+        value = 0;
+        for(size_t i = 0; i < sizeof(Integer); i++){
+            value |= static_cast<Integer>(data[i]) << (8 * i);
+        }
+        data += sizeof(Integer);
+
+        return true;
+    }
+
+    static bool load_file(entry_map &entries, const std::string &path)
+    {
+        std::ifstream stream(path.c_str(), std::ios::in | std::ios::binary);
+        if(!stream){
+            return false;
+        }
+
+        std::vector<unsigned char> data(
+            (std::istreambuf_iterator<char>(stream)),
+            std::istreambuf_iterator<char>()
+        );
+        if(data.empty()){
+            return false;
+        }
+
+        return parse(entries, &data[0], data.size());
+    }
+
+    // reads the entries of a bundle into entries, which is left unchanged
+    // if the bundle is not valid
+    static bool parse(entry_map &result, const unsigned char *data, size_t size)
+    {
+        const unsigned char *end = data + size;
+
+        if(size < 4 || std::string(data, data + 4) != magic()){
+            return false;
+        }
+        data += 4;
+
+        uint32_t file_version = 0;
+        uint32_t count = 0;
+        if(!read_integer(data, end, file_version) ||
+           file_version != version() ||
+           !read_integer(data, end, count)){
+            return false;
+        }
+
+        // only add the entries once the whole bundle has been validated
+        entry_map entries;
+        for(uint32_t i = 0; i < count; i++){
+            uint32_t key_size = 0;
+            if(!read_integer(data, end, key_size) || size_t(end - data) < key_size){
+                return false;
+            }
+            std::string key(data, data + key_size);
+            data += key_size;
+
+            uint64_t binary_size = 0;
+            if(!read_integer(data, end, binary_size) ||
+               uint64_t(end - data) < binary_size){
+                return false;
+            }
+            entries[key].assign(data, data + static_cast<size_t>(binary_size));
+            data += static_cast<size_t>(binary_size);
+        }
+
+        for(entry_map::iterator i = entries.begin(); i != entries.end(); ++i){
+            result[i->first].swap(i->second);
+        }
+
+        return true;
+    }
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_KERNEL_BUNDLE_HPP
@@ -0,0 +1,82 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_PREFETCH_KERNELS_HPP
+#define BOOST_COMPUTE_PREFETCH_KERNELS_HPP
+
+#include <string>
+#include <vector>
+
+#include <boost/compute/context.hpp>
+#include <boost/compute/program.hpp>
+#include <boost/compute/detail/sha1.hpp>
+#include <boost/compute/detail/program_cache.hpp>
+
+namespace boost {
+namespace compute {
+
+#if defined(CL_VERSION_1_1) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
+/// Starts building the programs with \p sources for \p context in the
+/// background and returns a future for each of them.
+///
+/// The builds are registered with the program cache used by the
+/// Boost.Compute algorithms. An algorithm which needs one of the programs
+/// while it is being built waits for that build instead of starting
+/// another. Once a build completes its program is inserted into the cache,
+/// so algorithms run afterwards use it without building it again. This
+/// allows services to start compiling the kernels they will use at startup
+/// while continuing to serve requests.
+///
+/// With \c BOOST_COMPUTE_THREAD_SAFE the program caches are per thread and
+/// the programs are inserted into the cache of the calling thread.
+///
+/// The sources of the programs used by the algorithms can be collected
+/// from a process which has run them (see program::source()) and stored
+/// with the service.
+///
+/// For example:
+/// \code
+/// std::vector<program_future> builds =
+///     boost::compute::prefetch_kernels(sources, context);
+///
+/// // ... serve requests ...
+/// \endcode
+///
+/// \opencl_version_warning{1,1}
+///
+/// \see program::build_with_source_async(), kernel_bundle
+inline std::vector<program_future>
+prefetch_kernels(const std::vector<std::string> &sources,
+                 const context &context,
+                 const std::string &options = std::string())
+{
+    boost::shared_ptr<detail::program_cache> cache =
+        detail::get_program_cache(context);
+
+    std::vector<program_future> builds;
+    builds.reserve(sources.size());
+
+    for(size_t i = 0; i < sources.size(); i++){
+        // programs of the algorithms are cached by the hash of their source
+        builds.push_back(
+            cache->get_or_build_async(
+                detail::sha1(sources[i]), options, sources[i], context
+            )
+        );
+    }
+
+    return builds;
+}
+#endif // CL_VERSION_1_1
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_PREFETCH_KERNELS_HPP
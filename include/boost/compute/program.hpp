@@ -25,13 +25,21 @@
 #include <boost/compute/exception.hpp>
 #include <boost/compute/detail/assert_cl_success.hpp>
 
-#ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
 #include <sstream>
+
+#include <boost/bind.hpp>
+
+#include <boost/compute/platform.hpp>
+#include <boost/compute/user_event.hpp>
+#include <boost/compute/kernel_bundle.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/async/detail/atomic_count.hpp>
+#include <boost/compute/detail/sha1.hpp>
+
+#ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
 #include <boost/optional.hpp>
 #include <boost/filesystem.hpp>
-#include <boost/compute/platform.hpp>
 #include <boost/compute/detail/getenv.hpp>
-#include <boost/compute/detail/sha1.hpp>
 #endif
 
 namespace boost {
@@ -492,6 +500,10 @@ public:
 
     /// Create a new program with \p source in \p context and builds it with \p options.
     /**
+     * The program is first looked up in the kernel_bundle and is only
+     * compiled from source if it is not found there or if its binary
+     * cannot be loaded (e.g. because it was built with another driver).
+     *
      * In case BOOST_COMPUTE_USE_OFFLINE_CACHE macro is defined,
      * the compiled binary is stored for reuse in the offline cache located in
      * $HOME/.boost_compute on UNIX-like systems and in %APPDATA%/boost_compute
@@ -503,28 +515,43 @@ public:
             const std::string &options = std::string()
             )
     {
+        const bool use_bundle = kernel_bundle::is_enabled();
+
 #ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
+        const bool use_hash = true;
+#else
+        const bool use_hash = use_bundle;
+#endif
+
         // Get hash string for the kernel.
         std::string hash;
-        {
-            device   d(context.get_device());
-            platform p(d.get_info<cl_platform_id>(CL_DEVICE_PLATFORM));
-
-            std::ostringstream src;
-            src << "// " << p.name() << " v" << p.version() << "\n"
-                << "// " << context.get_device().name() << "\n"
-                << "// " << options << "\n\n"
-                << source;
+        if (use_hash) {
+            hash = binary_hash(source, context, options);
+        }
 
-            hash = detail::sha1(src.str());
+        // Try to get the program binary from the kernel bundle:
+        if (use_bundle) {
+            std::vector<unsigned char> binary;
+            if (kernel_bundle::find(hash, binary)) {
+                try {
+                    program prog = create_with_binary(binary, context);
+                    prog.build(options);
+                    return prog;
+                } catch (...) {
+                    // The binary does not match the driver. Fallback to
+                    // normal compilation.
+                }
+            }
         }
 
+#ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
         // Try to get cached program binaries:
         try {
             boost::optional<program> prog = load_program_binary(hash, context);
 
             if (prog) {
                 prog->build(options);
+                record_program_binary(hash, *prog);
                 return *prog;
             }
         } catch (...) {
@@ -553,10 +580,220 @@ public:
         save_program_binary(hash, prog);
 #endif
 
+        if (use_bundle) {
+            record_program_binary(hash, prog);
+        }
+
         return prog;
     }
 
+    #if defined(CL_VERSION_1_1) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
+    /// Creates a new program with \p source in \p context and starts building
+    /// it with \p options without blocking. The returned future's get()
+    /// method waits for the build to complete and returns the program or
+    /// throws an opencl_error if it failed to build.
+    ///
+    /// Programs found in the kernel_bundle (or the offline cache) are only
+    /// linked from their binaries and are built before returning.
+    ///
+    /// Note that some OpenCL implementations build programs synchronously
+    /// even when asked not to.
+    ///
+    /// \opencl_version_warning{1,1}
+    ///
+    /// \see build_with_source(), prefetch_kernels()
+    static future<program> build_with_source_async(
+            const std::string &source,
+            const context     &context,
+            const std::string &options = std::string()
+            )
+    {
+        const bool use_bundle = kernel_bundle::is_enabled();
+
+#ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
+        const bool use_hash = true;
+#else
+        const bool use_hash = use_bundle;
+#endif
+
+        std::string hash;
+        if (use_hash) {
+            hash = binary_hash(source, context, options);
+        }
+
+        // Programs with binaries are built synchronously.
+        std::vector<unsigned char> binary;
+        bool has_binary = use_bundle && kernel_bundle::find(hash, binary);
+#ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
+        has_binary = has_binary ||
+            boost::filesystem::exists(program_binary_path(hash) + "kernel");
+#endif
+        if (has_binary) {
+            program prog = build_with_source(source, context, options);
+
+            user_event done(context);
+            done.set_status(CL_COMPLETE);
+            return future<program>(prog, done);
+        }
+
+        const char *source_string = source.c_str();
+
+        cl_int error = 0;
+        cl_program program_ = clCreateProgramWithSource(context,
+                                                        uint_(1),
+                                                        &source_string,
+                                                        0,
+                                                        &error);
+        if(!program_){
+            BOOST_THROW_EXCEPTION(opencl_error(error));
+        }
+
+        program prog(program_, false);
+
+        // The user event is completed by the build callback, which holds
+        // its own reference to it.
+        user_event done(context);
+        async_build *build = new async_build(done);
+
+        error = clBuildProgram(prog.get(),
+                               0,
+                               0,
+                               options.empty() ? 0 : options.c_str(),
+                               &program::build_callback,
+                               build);
+        if (error != CL_SUCCESS) {
+            // The callback may or may not have been called before the
+            // error was returned but it is not called afterwards.
+            complete_async_build(build);
+            if (!build->callback_invoked) {
+                release_async_build(build);
+            }
+        }
+        release_async_build(build);
+
+        return future<program>(
+            done,
+            boost::bind(&program::finish_async_build, prog, hash, error)
+        );
+    }
+    #endif // CL_VERSION_1_1
+
 private:
+    // Returns the key identifying the binary of a program built from
+    // source with options for the device of context.
+    static std::string binary_hash(const std::string &source,
+                                   const context     &context,
+                                   const std::string &options)
+    {
+        device   d(context.get_device());
+        platform p(d.get_info<cl_platform_id>(CL_DEVICE_PLATFORM));
+
+        std::ostringstream src;
+        src << "// " << p.name() << " v" << p.version() << "\n"
+            << "// " << d.name() << " (driver " << d.driver_version() << ")\n"
+            << "// " << options << "\n\n"
+            << source;
+
+        return detail::sha1(src.str());
+    }
+
+    // Adds the program binary to the kernel bundle if it is being recorded.
+    static void record_program_binary(const std::string &hash, const program &prog)
+    {
+        if (kernel_bundle::is_recording()) {
+            kernel_bundle::insert(hash, prog.binary());
+        }
+    }
+
+    #if defined(CL_VERSION_1_1)
+    // State of an asynchronous build shared by build_with_source_async()
+    // and the build callback, each of which holds a reference to it.
+    struct async_build
+    {
+        explicit async_build(const user_event &done_)
+            : done(done_),
+              completed(0),
+              callback_invoked(0),
+              references(2)
+        {
+        }
+
+        user_event done;
+        detail::atomic_count completed;
+        detail::atomic_count callback_invoked;
+        detail::atomic_count references;
+    };
+
+    // Completes the user event of the build. Only the first call has an
+    // effect as the callback can be invoked for builds which fail
+    // synchronously.
+    static void complete_async_build(async_build *build)
+    {
+        if (++build->completed == 1) {
+            build->done.set_status(CL_COMPLETE);
+        }
+    }
+
+    static void release_async_build(async_build *build)
+    {
+        if (--build->references == 0) {
+            delete build;
+        }
+    }
+
+    // Completes the user event passed to clBuildProgram().
+    static void BOOST_COMPUTE_CL_CALLBACK
+    build_callback(cl_program program_, void *user_data)
+    {
+        (void) program_;
+
+        async_build *build = static_cast<async_build *>(user_data);
+        build->callback_invoked = 1;
+        complete_async_build(build);
+        release_async_build(build);
+    }
+
+    // Checks the result of an asynchronous build and stores the binary of
+    // the built program.
+    static program finish_async_build(const program &prog,
+                                      const std::string &hash,
+                                      cl_int error)
+    {
+        if (error == CL_SUCCESS) {
+            const std::vector<device> devices = prog.get_devices();
+            for (size_t i = 0; i < devices.size(); i++) {
+                cl_build_status status = prog.get_build_info<cl_build_status>(
+                    CL_PROGRAM_BUILD_STATUS, devices[i]
+                );
+                if (status != CL_BUILD_SUCCESS) {
+                    error = CL_BUILD_PROGRAM_FAILURE;
+                }
+            }
+        }
+
+        if (error != CL_SUCCESS) {
+            #ifdef BOOST_COMPUTE_DEBUG_KERNEL_COMPILATION
+            std::cerr << "Boost.Compute: "
+                      << "kernel compilation failed (" << error << ")\n"
+                      << "--- source ---\n"
+                      << prog.source()
+                      << "\n--- build log ---\n"
+                      << prog.build_log()
+                      << std::endl;
+            #endif
+
+            BOOST_THROW_EXCEPTION(opencl_error(error));
+        }
+
+#ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
+        save_program_binary(hash, prog);
+#endif
+        record_program_binary(hash, prog);
+
+        return prog;
+    }
+    #endif // CL_VERSION_1_1
+
 #ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
     // Path delimiter symbol for the current OS.
     static const std::string& path_delim() {
@@ -632,6 +869,11 @@ private:
     cl_program m_program;
 };
 
+/// A future for a program being built asynchronously.
+///
+/// \see program::build_with_source_async(), prefetch_kernels()
+typedef future<program> program_future;
+
 /// \internal_ define get_info() specializations for program
 BOOST_COMPUTE_DETAIL_DEFINE_GET_INFO_SPECIALIZATIONS(program,
     ((cl_uint, CL_PROGRAM_REFERENCE_COUNT))
@@ -15,6 +15,7 @@
 #include <boost/preprocessor/stringize.hpp>
 
 #include <boost/compute/types/builtin.hpp>
+#include <boost/compute/types/half.hpp>
 
 namespace boost {
 namespace compute {
@@ -64,6 +65,9 @@ BOOST_COMPUTE_DEFINE_TYPE_NAME_FUNCTIONS(ulong)
 BOOST_COMPUTE_DEFINE_TYPE_NAME_FUNCTIONS(float)
 BOOST_COMPUTE_DEFINE_TYPE_NAME_FUNCTIONS(double)
 
+// half is a storage-only type, see half_
+BOOST_COMPUTE_DEFINE_SCALAR_TYPE_NAME_FUNCTION(half)
+
 /// \internal_
 #define BOOST_COMPUTE_DEFINE_BUILTIN_TYPE_NAME_FUNCTION(type) \
     template<> \
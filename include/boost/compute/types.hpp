@@ -17,6 +17,7 @@
 
 #include <boost/compute/types/builtin.hpp>
 #include <boost/compute/types/complex.hpp>
+#include <boost/compute/types/half.hpp>
 #include <boost/compute/types/pair.hpp>
 #include <boost/compute/types/struct.hpp>
 #include <boost/compute/types/tuple.hpp>
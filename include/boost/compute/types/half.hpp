@@ -0,0 +1,210 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_TYPES_HALF_HPP
+#define BOOST_COMPUTE_TYPES_HALF_HPP
+
+#include <cstring>
+#include <ostream>
+
+#include <boost/type_traits/common_type.hpp>
+
+#include <boost/compute/types/builtin.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// converts value to the bits of the nearest half (ties to even)
+inline ushort_ float_to_half_bits(float value)
+{
+    uint_ bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const uint_ sign = (bits >> 16) & 0x8000;
+    const uint_ abs = bits & 0x7fffffff;
+
+    // infinity and nan (keeping nans quiet)
+    if(abs >= 0x7f800000){
+        const uint_ nan = abs > 0x7f800000 ? (0x200 | ((abs >> 13) & 0x3ff)) : 0;
+        return static_cast<ushort_>(sign | 0x7c00 | nan);
+    }
+
+    // values rounding to more than 65504 overflow to infinity
+    if(abs >= 0x477ff000){
+        return static_cast<ushort_>(sign | 0x7c00);
+    }
+
+    uint_ half;
+    uint_ remainder;
+    uint_ halfway;
+    if(abs >= 0x38800000){
+        // normal half, rebias the exponent from 127 to 15
+        half = (abs >> 13) - (112 << 10);
+        remainder = abs & 0x1fff;
+        halfway = 0x1000;
+    }
+    else if(abs >= 0x33000000){
+        // subnormal half (2^-24 units)
+        const uint_ mantissa = (abs & 0x7fffff) | 0x800000;
+        const uint_ shift = 126 - (abs >> 23);
+
+        half = mantissa >> shift;
+        remainder = mantissa & ((1u << shift) - 1);
+        halfway = 1u << (shift - 1);
+    }
+    else {
+        // rounds to zero
+        return static_cast<ushort_>(sign);
+    }
+
+    if(remainder > halfway || (remainder == halfway && (half & 1))){
+        half++;
+    }
+
+    return static_cast<ushort_>(sign | half);
+}
+
+// converts the bits of a half to a float (exactly)
+inline float half_bits_to_float(ushort_ half)
+{
+    const uint_ sign = uint_(half & 0x8000) << 16;
+    const uint_ exponent = (half >> 10) & 0x1f;
+    uint_ mantissa = half & 0x3ff;
+
+    uint_ bits;
+    if(exponent == 0x1f){
+        // infinity and nan
+        bits = sign | 0x7f800000 | (mantissa << 13);
+    }
+    else if(exponent != 0){
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+    else if(mantissa != 0){
+        // subnormal half, normalize it
+        uint_ e = 113;
+        while(!(mantissa & 0x400)){
+            mantissa <<= 1;
+            e--;
+        }
+        bits = sign | (e << 23) | ((mantissa & 0x3ff) << 13);
+    }
+    else {
+        bits = sign;
+    }
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+} // end detail namespace
+
+/// \class half_
+/// \brief A 16-bit floating-point storage type.
+///
+/// The half_ type stores IEEE 754 half-precision values. It can be used
+/// with containers (e.g. vector<half_>), iterators and algorithms in
+/// order to halve the memory footprint and bandwidth of values which do
+/// not need single precision.
+///
+/// Kernels load half values with \c vload_half() and compute with them
+/// as \c float. Results stored to half buffers are rounded with
+/// \c vstore_half(). Neither requires the \c cl_khr_fp16 extension so
+/// half values can be used on any device.
+///
+/// On the host, half_ values convert to and from \c float:
+/// \code
+/// std::vector<float> values = ...;
+/// std::vector<half_> halves(values.begin(), values.end());
+///
+/// boost::compute::vector<half_> device_halves(halves.begin(), halves.end(), queue);
+/// \endcode
+///
+/// The copy(), transform(), reduce() and sort() algorithms support half
+/// ranges. reduce() computes in \c float and its result should be a
+/// \c float.
+class half_
+{
+public:
+    half_()
+        : m_bits(0)
+    {
+    }
+
+    half_(float value)
+        : m_bits(detail::float_to_half_bits(value))
+    {
+    }
+
+    operator float() const
+    {
+        return detail::half_bits_to_float(m_bits);
+    }
+
+    /// Returns the bits of the half value.
+    ushort_ bits() const
+    {
+        return m_bits;
+    }
+
+    /// Returns the half value with \p bits.
+    static half_ from_bits(ushort_ bits)
+    {
+        half_ value;
+        value.m_bits = bits;
+        return value;
+    }
+
+private:
+    ushort_ m_bits;
+};
+
+inline std::ostream& operator<<(std::ostream &stream, const half_ &value)
+{
+    return stream << float(value);
+}
+
+namespace detail {
+
+// the type values of T are loaded as in kernels, half values are loaded
+// into floats
+template<class T>
+struct kernel_value_type
+{
+    typedef T type;
+};
+
+template<>
+struct kernel_value_type<half_>
+{
+    typedef float_ type;
+};
+
+} // end detail namespace
+} // end compute namespace
+
+// arithmetic with half values is done in float (this is used to deduce the
+// result types of lambda expressions)
+template<class T>
+struct common_type<compute::half_, T> : common_type<compute::float_, T> {};
+
+template<class T>
+struct common_type<T, compute::half_> : common_type<T, compute::float_> {};
+
+template<>
+struct common_type<compute::half_, compute::half_>
+{
+    typedef compute::float_ type;
+};
+
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_TYPES_HALF_HPP
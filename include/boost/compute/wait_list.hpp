@@ -120,6 +120,12 @@ public:
         return reinterpret_cast<const cl_event *>(&m_events[0]);
     }
 
+    /// Returns the event at \p index in the wait-list.
+    const event& operator[](size_t index) const
+    {
+        return m_events[index];
+    }
+
     /// Inserts \p event into the wait-list.
     void insert(const event &event)
     {
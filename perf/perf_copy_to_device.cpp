@@ -12,8 +12,58 @@
 #include <cstdlib>
 #include <iostream>
 
+#include <boost/chrono.hpp>
 #include <boost/compute.hpp>
 
+// prints the best times of copying host_vector to device_vector and
+// back with blocking copy() calls
+template<class Vector>
+void time_copy(const char *name,
+               std::vector<int> &host_vector,
+               Vector &device_vector,
+               boost::compute::command_queue &queue)
+{
+    typedef boost::chrono::high_resolution_clock clock;
+
+    const size_t trials = 10;
+    const float bytes = float(host_vector.size() * sizeof(int));
+
+    size_t to_device = size_t(-1);
+    size_t to_host = size_t(-1);
+    for(size_t i = 0; i < trials; i++){
+        clock::time_point start = clock::now();
+        boost::compute::copy(
+            host_vector.begin(), host_vector.end(), device_vector.begin(), queue
+        );
+        queue.finish();
+        clock::time_point middle = clock::now();
+        boost::compute::copy(
+            device_vector.begin(), device_vector.end(), host_vector.begin(), queue
+        );
+        queue.finish();
+        clock::time_point stop = clock::now();
+
+        to_device = (std::min)(to_device, size_t(
+            boost::chrono::duration_cast<boost::chrono::nanoseconds>(
+                middle - start
+            ).count()
+        ));
+        to_host = (std::min)(to_host, size_t(
+            boost::chrono::duration_cast<boost::chrono::nanoseconds>(
+                stop - middle
+            ).count()
+        ));
+    }
+
+    std::cout << name << ":" << std::endl;
+    std::cout << "  to device: " << to_device / 1e6 << " ms ("
+              << (bytes / (std::max)(to_device, size_t(1))) * 1000.f << " MB/s)"
+              << std::endl;
+    std::cout << "  to host:   " << to_host / 1e6 << " ms ("
+              << (bytes / (std::max)(to_host, size_t(1))) * 1000.f << " MB/s)"
+              << std::endl;
+}
+
 int main(int argc, char *argv[])
 {
     size_t size = 1000;
@@ -28,6 +78,11 @@ int main(int argc, char *argv[])
         properties = boost::compute::command_queue::enable_profiling;
     boost::compute::command_queue queue(context, device, properties);
 
+    std::cout << "device: " << device.name() << std::endl;
+    std::cout << "host unified memory: "
+              << boost::compute::detail::is_host_unified_device(device)
+              << std::endl;
+
     std::vector<int> host_vector(size);
     std::generate(host_vector.begin(), host_vector.end(), rand);
 
@@ -51,5 +106,12 @@ int main(int argc, char *argv[])
     float rate = (float(size * sizeof(int)) / elapsed) * 1000.f;
     std::cout << "rate: " << rate << " MB/s" << std::endl;
 
+    // compare read/write commands with mapping on host-unified devices
+    time_copy("buffer_allocator (read/write)", host_vector, device_vector, queue);
+
+    boost::compute::vector<int, boost::compute::zero_copy_allocator<int> >
+        zero_copy_vector(host_vector.size(), context);
+    time_copy("zero_copy_allocator (map)", host_vector, zero_copy_vector, queue);
+
     return 0;
 }
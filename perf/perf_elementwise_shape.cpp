@@ -0,0 +1,140 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#include <iostream>
+#include <vector>
+
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/functional/math.hpp>
+#include <boost/compute/functional/detail/unpack.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/iterator/zip_iterator.hpp>
+#include <boost/compute/iterator/transform_iterator.hpp>
+
+#include "perf.hpp"
+
+namespace compute = boost::compute;
+
+typedef compute::detail::elementwise_kernel elementwise_kernel;
+
+// returns the time taken to copy [first, last) to result with a copy
+// kernel using shape
+template<class InputIterator, class OutputIterator>
+double time_copy_kernel(InputIterator first,
+                        InputIterator last,
+                        OutputIterator result,
+                        elementwise_kernel::shape shape,
+                        compute::command_queue &queue)
+{
+    compute::detail::copy_kernel<InputIterator, OutputIterator>
+        kernel(queue.get_device());
+    kernel.set_shape(shape);
+    kernel.set_range(first, last, result);
+
+    // build the program before timing it
+    kernel.exec(queue);
+    queue.finish();
+
+    perf_timer t;
+    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+        t.start();
+        kernel.exec(queue);
+        queue.finish();
+        t.stop();
+    }
+
+    return t.min_time();
+}
+
+template<class InputIterator, class OutputIterator>
+void compare_shapes(const char *name,
+                    InputIterator first,
+                    InputIterator last,
+                    OutputIterator result,
+                    compute::command_queue &queue)
+{
+    const double strided_time =
+        time_copy_kernel(first, last, result, elementwise_kernel::strided, queue);
+    const double chunked_time =
+        time_copy_kernel(first, last, result, elementwise_kernel::chunked, queue);
+
+    std::cout << name << ": "
+              << "strided: " << strided_time / 1e6 << " ms, "
+              << "chunked: " << chunked_time / 1e6 << " ms, "
+              << "speedup: " << strided_time / chunked_time << "x"
+              << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    perf_parse_args(argc, argv);
+
+    using compute::lambda::_1;
+    using compute::lambda::_2;
+
+    std::cout << "size: " << PERF_N << std::endl;
+
+    // the shapes are compared on the first cpu device
+    std::vector<compute::device> devices = compute::system::devices();
+    compute::device device;
+    for(size_t i = 0; i < devices.size(); i++){
+        if(devices[i].type() & compute::device::cpu){
+            device = devices[i];
+            break;
+        }
+    }
+    if(device.id() == 0){
+        std::cout << "skipping: no cpu device found" << std::endl;
+        return 0;
+    }
+
+    compute::context context(device);
+    compute::command_queue queue(context, device);
+    std::cout << "device: " << device.name() << std::endl;
+    std::cout << "compute units: " << device.compute_units() << std::endl;
+
+    std::vector<float> host_x = generate_random_vector<float>(PERF_N);
+    std::vector<float> host_y = generate_random_vector<float>(PERF_N);
+    compute::vector<float> x(host_x.begin(), host_x.end(), queue);
+    compute::vector<float> y(host_y.begin(), host_y.end(), queue);
+    compute::vector<float> z(PERF_N, context);
+
+    // z <- x
+    compare_shapes("copy", x.begin(), x.end(), z.begin(), queue);
+
+    // z <- sqrt(x)
+    compare_shapes(
+        "transform",
+        compute::make_transform_iterator(x.begin(), compute::sqrt<float>()),
+        compute::make_transform_iterator(x.end(), compute::sqrt<float>()),
+        z.begin(),
+        queue
+    );
+
+    // z <- alpha * x + y
+    const float alpha = 2.5f;
+    compare_shapes(
+        "saxpy",
+        compute::make_transform_iterator(
+            compute::make_zip_iterator(boost::make_tuple(x.begin(), y.begin())),
+            compute::detail::unpack(alpha * _1 + _2)
+        ),
+        compute::make_transform_iterator(
+            compute::make_zip_iterator(boost::make_tuple(x.end(), y.end())),
+            compute::detail::unpack(alpha * _1 + _2)
+        ),
+        z.begin(),
+        queue
+    );
+
+    return 0;
+}
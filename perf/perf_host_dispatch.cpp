@@ -0,0 +1,133 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/host_dispatch.hpp>
+#include <boost/compute/calibrate_host_dispatch.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/count.hpp>
+#include <boost/compute/algorithm/find.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "perf.hpp"
+
+namespace compute = boost::compute;
+
+// times algorithm on the first size values with the given threshold
+double time_algorithm(compute::host_dispatch::algorithm algorithm,
+                      size_t threshold,
+                      const std::vector<int> &host_vector,
+                      compute::vector<int> &device_vector,
+                      size_t size,
+                      compute::command_queue &queue)
+{
+    const compute::device device = queue.get_device();
+    compute::host_dispatch::set_threshold(device, algorithm, threshold);
+
+    perf_timer t;
+    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+        compute::copy(
+            host_vector.begin(), host_vector.begin() + size,
+            device_vector.begin(), queue
+        );
+        queue.finish();
+
+        t.start();
+        switch(algorithm){
+        case compute::host_dispatch::sort_algorithm:
+            compute::sort(device_vector.begin(), device_vector.begin() + size, queue);
+            break;
+        case compute::host_dispatch::count_algorithm:
+            compute::count(device_vector.begin(), device_vector.begin() + size, -1, queue);
+            break;
+        case compute::host_dispatch::find_algorithm:
+            compute::find(device_vector.begin(), device_vector.begin() + size, -1, queue);
+            break;
+        default:
+            break;
+        }
+        queue.finish();
+        t.stop();
+    }
+
+    return t.min_time() / 1e6;
+}
+
+int main(int argc, char *argv[])
+{
+    perf_parse_args(argc, argv);
+    std::cout << "size: " << PERF_N << std::endl;
+
+    // setup context and queue for the default device
+    compute::device device = compute::system::default_device();
+    compute::context context(device);
+    compute::command_queue queue(context, device);
+    std::cout << "device: " << device.name() << std::endl;
+
+    std::vector<int> host_vector = generate_random_vector<int>(PERF_N);
+    compute::vector<int> device_vector(PERF_N, context);
+
+    // time each algorithm on the host and on the device for doubling sizes
+    // and report the first size at which the device is faster
+    for(size_t i = 0; i < compute::host_dispatch::algorithm_count; i++){
+        compute::host_dispatch::algorithm algorithm =
+            static_cast<compute::host_dispatch::algorithm>(i);
+        std::cout << std::endl << compute::host_dispatch::name(algorithm) << std::endl;
+        std::cout << std::setw(10) << "size"
+                  << std::setw(14) << "host (ms)"
+                  << std::setw(14) << "device (ms)" << std::endl;
+
+        // build the kernels before timing them
+        time_algorithm(algorithm, 0, host_vector, device_vector, PERF_N, queue);
+
+        size_t crossover = 0;
+        for(size_t size = 4; size <= PERF_N; size *= 2){
+            double host_time = time_algorithm(
+                algorithm, size, host_vector, device_vector, size, queue
+            );
+            double device_time = time_algorithm(
+                algorithm, 0, host_vector, device_vector, size, queue
+            );
+            std::cout << std::setw(10) << size
+                      << std::setw(14) << host_time
+                      << std::setw(14) << device_time << std::endl;
+
+            if(crossover == 0 && device_time < host_time){
+                crossover = size;
+            }
+        }
+
+        if(crossover){
+            std::cout << "crossover: " << crossover << std::endl;
+        }
+        else {
+            std::cout << "crossover: > " << PERF_N << std::endl;
+        }
+    }
+
+    // compare with the thresholds measured by calibrate_host_dispatch()
+    compute::calibrate_host_dispatch(queue, PERF_N);
+    std::cout << std::endl << "calibrated thresholds:" << std::endl;
+    for(size_t i = 0; i < compute::host_dispatch::algorithm_count; i++){
+        compute::host_dispatch::algorithm algorithm =
+            static_cast<compute::host_dispatch::algorithm>(i);
+        std::cout << "  " << compute::host_dispatch::name(algorithm) << ": "
+                  << compute::host_dispatch::threshold(device, algorithm)
+                  << std::endl;
+    }
+
+    return 0;
+}
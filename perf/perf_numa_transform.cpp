@@ -0,0 +1,106 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#include <iostream>
+#include <vector>
+
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/allocator/numa_allocator.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "perf.hpp"
+
+namespace compute = boost::compute;
+
+#ifdef CL_VERSION_1_2
+typedef compute::vector<float, compute::numa_allocator<float> > numa_vector;
+
+// runs a bandwidth-bound saxpy transform on each of the devices in
+// parallel with each device processing an equal share of the input
+double run_transform(const std::vector<compute::device> &devices)
+{
+    using compute::lambda::_1;
+    using compute::lambda::_2;
+
+    const size_t n = PERF_N / devices.size();
+
+    std::vector<compute::command_queue> queues;
+    std::vector<numa_vector*> xs;
+    std::vector<numa_vector*> ys;
+    for(size_t i = 0; i < devices.size(); i++){
+        compute::context context(devices[i]);
+        queues.push_back(compute::command_queue(context, devices[i]));
+
+        // the numa_allocator touches the memory from the sub-device so
+        // that its pages are placed on the sub-device's numa node
+        xs.push_back(new numa_vector(n, context));
+        ys.push_back(new numa_vector(n, context));
+    }
+
+    perf_timer t;
+    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+        t.start();
+        for(size_t i = 0; i < devices.size(); i++){
+            compute::transform(
+                xs[i]->begin(), xs[i]->end(), ys[i]->begin(), ys[i]->begin(),
+                2.5f * _1 + _2, queues[i]
+            );
+        }
+        for(size_t i = 0; i < devices.size(); i++){
+            queues[i].finish();
+        }
+        t.stop();
+    }
+
+    for(size_t i = 0; i < devices.size(); i++){
+        delete xs[i];
+        delete ys[i];
+    }
+
+    return t.min_time();
+}
+
+int main(int argc, char *argv[])
+{
+    perf_parse_args(argc, argv);
+
+    std::cout << "size: " << PERF_N << std::endl;
+
+    compute::device device = compute::system::default_device();
+    std::cout << "device: " << device.name() << std::endl;
+
+    if(!device.check_version(1, 2)){
+        std::cout << "skipping: device does not support OpenCL 1.2" << std::endl;
+        return 0;
+    }
+
+    // the whole device with one context and queue
+    const double whole_time = run_transform(std::vector<compute::device>(1, device));
+    std::cout << "time (whole device): " << whole_time / 1e6 << " ms" << std::endl;
+
+    // one sub-device, context and queue per numa node
+    std::vector<compute::device> nodes = device.partition_by_numa_node();
+    std::cout << "numa nodes: " << nodes.size() << std::endl;
+    if(nodes.size() > 1){
+        const double numa_time = run_transform(nodes);
+        std::cout << "time (per numa node): " << numa_time / 1e6 << " ms" << std::endl;
+    }
+
+    return 0;
+}
+#else // CL_VERSION_1_2
+int main()
+{
+    std::cout << "skipping: built without OpenCL 1.2 support" << std::endl;
+    return 0;
+}
+#endif // CL_VERSION_1_2
@@ -79,6 +79,10 @@ int main(int argc, char *argv[])
     }
     std::cout << "time: " << t.min_time() / 1e6 << " ms" << std::endl;
 
+    // saxpy reads x and y and writes y
+    const double bytes = 3.0 * PERF_N * sizeof(float);
+    std::cout << "bandwidth: " << bytes / t.min_time() << " GB/s" << std::endl;
+
     // perform saxpy on host
     serial_saxpy(PERF_N, alpha, &host_x[0], &host_y[0]);
 
@@ -0,0 +1,99 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/container/flat_map.hpp>
+#include <boost/compute/container/unordered_map.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "perf.hpp"
+
+namespace compute = boost::compute;
+
+int rand_int()
+{
+    return static_cast<int>(rand() % (1 << 30));
+}
+
+int main(int argc, char *argv[])
+{
+    perf_parse_args(argc, argv);
+    std::cout << "size: " << PERF_N << std::endl;
+
+    // setup context and queue for the default device
+    compute::device device = compute::system::default_device();
+    compute::context context(device);
+    compute::command_queue queue(context, device);
+    std::cout << "device: " << device.name() << std::endl;
+
+    // random keys and values for the dictionary
+    std::vector<int> host_keys(PERF_N);
+    std::generate(host_keys.begin(), host_keys.end(), rand_int);
+    std::vector<float> host_values(PERF_N);
+    std::generate(host_values.begin(), host_values.end(), rand);
+
+    compute::vector<int> keys(host_keys.begin(), host_keys.end(), queue);
+    compute::vector<float> values(host_values.begin(), host_values.end(), queue);
+
+    // look up every key (in a different order than inserted)
+    std::random_shuffle(host_keys.begin(), host_keys.end());
+    compute::vector<int> queries(host_keys.begin(), host_keys.end(), queue);
+    compute::vector<float> result(PERF_N, context);
+
+    // hash table
+    compute::unordered_map<int, float> map(context);
+    map.reserve(PERF_N, queue);
+
+    perf_timer insert_timer;
+    perf_timer t;
+    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+        map.clear(queue);
+        queue.finish();
+
+        insert_timer.start();
+        map.insert(keys.begin(), keys.end(), values.begin(), queue);
+        queue.finish();
+        insert_timer.stop();
+
+        t.start();
+        map.find(queries.begin(), queries.end(), result.begin(), 0.f, queue);
+        queue.finish();
+        t.stop();
+    }
+    std::cout << "insert time: " << insert_timer.min_time() / 1e6 << " ms" << std::endl;
+    std::cout << "time: " << t.min_time() / 1e6 << " ms" << std::endl;
+
+    // sorted flat_map with batched binary search lookups (which only find
+    // the index of each key) for comparison
+    std::vector<std::pair<int, float> > host_pairs(PERF_N);
+    for(size_t i = 0; i < PERF_N; i++){
+        host_pairs[i] = std::make_pair(host_keys[i], host_values[i]);
+    }
+    compute::flat_map<int, float> flat_map(context);
+    flat_map.insert(host_pairs.begin(), host_pairs.end(), queue);
+
+    compute::vector<compute::uint_> indices(PERF_N, context);
+
+    perf_timer flat_timer;
+    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+        flat_timer.start();
+        flat_map.find(queries.begin(), queries.end(), indices.begin(), queue);
+        queue.finish();
+        flat_timer.stop();
+    }
+    std::cout << "flat_map time: " << flat_timer.min_time() / 1e6 << " ms" << std::endl;
+
+    return 0;
+}
@@ -13,6 +13,7 @@
 
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/accumulate.hpp>
+#include <boost/compute/algorithm/fill.hpp>
 #include <boost/compute/algorithm/iota.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/iterator/counting_iterator.hpp>
@@ -249,4 +250,37 @@ BOOST_AUTO_TEST_CASE(min_max)
     BOOST_CHECK_EQUAL(max_value, 10.f);
 }
 
+BOOST_AUTO_TEST_CASE(sum_float_summation_policies)
+{
+    namespace compute = boost::compute;
+
+    // spans several levels of reproducible block sums
+    compute::vector<float> vector(2000000, context);
+    compute::fill(vector.begin(), vector.end(), 0.1f, queue);
+
+    const float compensated = compute::accumulate(
+        vector.begin(), vector.end(), 1.0f, compute::plus<float>(),
+        compute::compensated_summation(), queue
+    );
+    BOOST_CHECK_CLOSE(compensated, 200001.0f, 1e-4);
+
+    const float reproducible = compute::accumulate(
+        vector.begin(), vector.end(), 1.0f, compute::plus<float>(),
+        compute::reproducible_summation(), queue
+    );
+    BOOST_CHECK_CLOSE(reproducible, 200001.0f, 1e-4);
+
+    // the default policy for float sums is reproducible_summation
+    BOOST_CHECK_EQUAL(
+        compute::accumulate(vector.begin(), vector.end(), 1.0f, queue),
+        reproducible
+    );
+
+    const float fast = compute::accumulate(
+        vector.begin(), vector.end(), 1.0f, compute::plus<float>(),
+        compute::fast_summation(), queue
+    );
+    BOOST_CHECK_CLOSE(fast, 200001.0f, 1e-1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -12,15 +12,21 @@
 #include <boost/test/unit_test.hpp>
 
 #include <iterator>
+#include <vector>
+#include <algorithm>
 
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/binary_search.hpp>
 #include <boost/compute/algorithm/lower_bound.hpp>
 #include <boost/compute/algorithm/upper_bound.hpp>
+#include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/container/vector.hpp>
 
+#include "check_macros.hpp"
 #include "context_setup.hpp"
 
+namespace compute = boost::compute;
+
 BOOST_AUTO_TEST_CASE(binary_search_int)
 {
     int data[] = { 1, 2, 2, 2, 4, 4, 5, 7 };
@@ -64,4 +70,63 @@ BOOST_AUTO_TEST_CASE(range_bounds_int)
     BOOST_CHECK(boost::compute::upper_bound(vector.begin(), vector.end(), int(6)) == vector.end());
 }
 
+BOOST_AUTO_TEST_CASE(range_bounds_many_values)
+{
+    int data[] = { 1, 2, 2, 2, 3, 3, 4, 5 };
+    compute::vector<int> vector(data, data + 8, queue);
+
+    int values_data[] = { 3, 0, 6, 2, 5, 1, 4 };
+    compute::vector<int> values(values_data, values_data + 7, queue);
+    compute::vector<compute::uint_> result(7, context);
+
+    compute::lower_bound(
+        vector.begin(), vector.end(), values.begin(), values.end(),
+        result.begin(), queue
+    );
+    CHECK_RANGE_EQUAL(compute::uint_, 7, result, (4, 0, 8, 1, 7, 0, 6));
+
+    compute::upper_bound(
+        vector.begin(), vector.end(), values.begin(), values.end(),
+        result.begin(), queue
+    );
+    CHECK_RANGE_EQUAL(compute::uint_, 7, result, (6, 0, 8, 4, 8, 1, 7));
+}
+
+BOOST_AUTO_TEST_CASE(lower_bound_many_values_large_range)
+{
+    // large enough for the local memory cache, with both unsorted and
+    // sorted values (which take the merge-like path when declared sorted)
+    std::vector<int> data(20000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<int>(i / 3);
+    }
+    compute::vector<int> vector(data.begin(), data.end(), queue);
+
+    std::vector<int> values_data(1000);
+    for(size_t i = 0; i < values_data.size(); i++){
+        values_data[i] = static_cast<int>((i * 7919) % 7000) - 100;
+    }
+
+    for(int sorted = 0; sorted < 2; sorted++){
+        if(sorted){
+            std::sort(values_data.begin(), values_data.end());
+        }
+        compute::vector<int> values(values_data.begin(), values_data.end(), queue);
+        compute::vector<compute::uint_> result(values_data.size(), context);
+
+        compute::lower_bound(
+            vector.begin(), vector.end(), values.begin(), values.end(),
+            result.begin(), sorted == 1, queue
+        );
+
+        std::vector<compute::uint_> host_result(values_data.size());
+        compute::copy(result.begin(), result.end(), host_result.begin(), queue);
+        for(size_t i = 0; i < values_data.size(); i++){
+            const size_t expected =
+                std::lower_bound(data.begin(), data.end(), values_data[i]) - data.begin();
+            BOOST_CHECK_EQUAL(host_result[i], compute::uint_(expected));
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -276,6 +276,38 @@ BOOST_AUTO_TEST_CASE(check_copy_type)
     CHECK_HOST_RANGE_EQUAL(int, 8, data, (1, 2, 3, 4, 5, 6, 7, 8));
 }
 
+BOOST_AUTO_TEST_CASE(copy_kernel_shapes)
+{
+    typedef compute::vector<int>::iterator iterator;
+    typedef compute::detail::elementwise_kernel elementwise_kernel;
+
+    // an odd count which does not divide into the chunks or work-groups
+    const size_t size = 10007;
+
+    compute::vector<int> input(size, context);
+    compute::iota(input.begin(), input.end(), 0, queue);
+
+    elementwise_kernel::shape shapes[] = {
+        elementwise_kernel::strided, elementwise_kernel::chunked
+    };
+
+    for(size_t i = 0; i < 2; i++){
+        compute::vector<int> output(size, context);
+        compute::fill(output.begin(), output.end(), -1, queue);
+
+        compute::detail::copy_kernel<iterator, iterator> kernel(device);
+        kernel.set_shape(shapes[i]);
+        kernel.set_range(input.begin(), input.end(), output.begin());
+        kernel.exec(queue);
+
+        std::vector<int> host_output(size);
+        compute::copy(output.begin(), output.end(), host_output.begin(), queue);
+        for(size_t j = 0; j < size; j++){
+            BOOST_CHECK_EQUAL(host_output[j], static_cast<int>(j));
+        }
+    }
+}
+
 #ifdef CL_VERSION_2_0
 BOOST_AUTO_TEST_CASE(copy_svm_ptr)
 {
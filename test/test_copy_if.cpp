@@ -13,6 +13,9 @@
 
 #include <boost/compute/lambda.hpp>
 #include <boost/compute/algorithm/copy_if.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/transform.hpp>
 #include <boost/compute/container/vector.hpp>
 
 #include "check_macros.hpp"
@@ -108,4 +111,49 @@ BOOST_AUTO_TEST_CASE(copy_index_if_int)
     CHECK_RANGE_EQUAL(int, 7, output, (0, 2, 5, 6, -1, -1, -1));
 }
 
+BOOST_AUTO_TEST_CASE(copy_if_async_int)
+{
+    int data[] = { 1, 6, 3, 5, 8, 2, 4 };
+    bc::vector<int> input(data, data + 7, queue);
+
+    bc::vector<int> output(input.size(), context);
+    bc::fill(output.begin(), output.end(), -1, queue);
+
+    using ::boost::compute::_1;
+
+    bc::future<bc::vector<int>::iterator> future =
+        bc::copy_if_async(input.begin(), input.end(), output.begin(), _1 < 5, queue);
+    bc::vector<int>::iterator iter = future.get();
+
+    BOOST_CHECK(iter == output.begin() + 4);
+    CHECK_RANGE_EQUAL(int, 7, output, (1, 3, 2, 4, -1, -1, -1));
+}
+
+BOOST_AUTO_TEST_CASE(copy_if_device_count)
+{
+    int data[] = { 1, 6, 3, 5, 8, 2, 4 };
+    bc::vector<int> input(data, data + 7, queue);
+
+    bc::vector<int> filtered(input.size(), context);
+    bc::vector<int> output(input.size(), context);
+    bc::fill(output.begin(), output.end(), -1, queue);
+
+    using ::boost::compute::_1;
+
+    // filter, transform and copy without reading the count in between
+    bc::detail::scalar<bc::uint_> count(context);
+    bc::copy_if(input.begin(), input.end(), filtered.begin(), _1 < 5, count, queue);
+    bc::transform(
+        filtered.begin(), filtered.end(), count, filtered.begin(), _1 * 10, queue
+    );
+    bc::copy(filtered.begin(), filtered.end(), count, output.begin(), queue);
+
+    BOOST_CHECK_EQUAL(count.read(queue), bc::uint_(4));
+    CHECK_RANGE_EQUAL(int, 7, output, (10, 30, 20, 40, -1, -1, -1));
+
+    // empty input
+    bc::copy_if(input.begin(), input.begin(), filtered.begin(), _1 < 5, count, queue);
+    BOOST_CHECK_EQUAL(count.read(queue), bc::uint_(0));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -12,9 +12,11 @@
 #include <boost/test/unit_test.hpp>
 
 #include <string>
+#include <cstdlib>
 
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/function.hpp>
+#include <boost/compute/host_dispatch.hpp>
 #include <boost/compute/lambda.hpp>
 #include <boost/compute/system.hpp>
 #include <boost/compute/algorithm/copy.hpp>
@@ -29,6 +31,24 @@
 namespace bc = boost::compute;
 namespace compute = boost::compute;
 
+BOOST_AUTO_TEST_CASE(count_host_dispatch_env)
+{
+    using boost::compute::host_dispatch;
+
+    // the environment variables are read when the thresholds of a device
+    // are first used, so this case has to run before the others
+#ifdef _WIN32
+    _putenv_s("BOOST_COMPUTE_HOST_DISPATCH_COUNT", "7");
+#else
+    setenv("BOOST_COMPUTE_HOST_DISPATCH_COUNT", "7", 1);
+#endif
+
+    BOOST_CHECK_EQUAL(
+        host_dispatch::threshold(device, host_dispatch::count_algorithm),
+        size_t(7)
+    );
+}
+
 BOOST_AUTO_TEST_CASE(count_int)
 {
     int data[] = { 1, 2, 1, 2, 3 };
@@ -216,4 +236,57 @@ BOOST_AUTO_TEST_CASE(count_if_with_reduce)
     );
 }
 
+BOOST_AUTO_TEST_CASE(count_if_async)
+{
+    int data[] = { 1, 2, 1, 2, 3, 1 };
+    bc::vector<int> vector(data, data + 6, queue);
+
+    using ::boost::compute::_1;
+
+    bc::future<size_t> ones =
+        bc::count_if_async(vector.begin(), vector.end(), _1 == 1, queue);
+    bc::future<size_t> none =
+        bc::count_if_async(vector.begin(), vector.end(), _1 > 5, queue);
+
+    BOOST_CHECK_EQUAL(ones.get(), size_t(3));
+    BOOST_CHECK_EQUAL(none.get(), size_t(0));
+}
+
+BOOST_AUTO_TEST_CASE(count_host_dispatch)
+{
+    using boost::compute::host_dispatch;
+
+    const size_t threshold =
+        host_dispatch::threshold(device, host_dispatch::count_algorithm);
+
+    int data[] = { 1, 2, 1, 2, 3, 2, 2 };
+    bc::vector<int> vector(data, data + 7, queue);
+
+    // counted on the device and then on the host
+    const size_t thresholds[] = { 0, 1024 };
+    for(size_t i = 0; i < 2; i++){
+        host_dispatch::set_threshold(
+            device, host_dispatch::count_algorithm, thresholds[i]
+        );
+        BOOST_CHECK_EQUAL(
+            host_dispatch::threshold(device, host_dispatch::count_algorithm),
+            thresholds[i]
+        );
+
+        BOOST_CHECK_EQUAL(
+            bc::count(vector.begin(), vector.end(), 2, queue), size_t(4)
+        );
+        BOOST_CHECK_EQUAL(
+            bc::count(vector.begin() + 1, vector.end() - 1, 1, queue), size_t(1)
+        );
+
+        // the value is not converted to the value type of the range
+        BOOST_CHECK_EQUAL(
+            bc::count(vector.begin(), vector.end(), 2.5f, queue), size_t(0)
+        );
+    }
+
+    host_dispatch::set_threshold(device, host_dispatch::count_algorithm, threshold);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -66,20 +66,6 @@ BOOST_AUTO_TEST_CASE(get_max_work_item_sizes)
 
 #ifdef CL_VERSION_1_2
 
-// returns true if the device supports the partitioning type
-bool supports_partition_type(const boost::compute::device &device,
-                             cl_device_partition_property type)
-{
-    const std::vector<cl_device_partition_property> properties =
-        device.get_info<std::vector<cl_device_partition_property> >(
-            CL_DEVICE_PARTITION_PROPERTIES
-        );
-
-    return std::find(properties.begin(),
-                     properties.end(),
-                     type) != properties.end();
-}
-
 BOOST_AUTO_TEST_CASE(partition_device_equally)
 {
     // get default device and ensure it has at least two compute units
@@ -98,7 +84,7 @@ BOOST_AUTO_TEST_CASE(partition_device_equally)
     BOOST_CHECK(device.is_subdevice() == false);
 
     // check that the device supports partitioning equally
-    if(!supports_partition_type(device, CL_DEVICE_PARTITION_EQUALLY)){
+    if(!device.supports_partition_type(CL_DEVICE_PARTITION_EQUALLY)){
         std::cout << "skipping test: "
                   << "device does not support CL_DEVICE_PARTITION_EQUALLY"
                   << std::endl;
@@ -149,7 +135,7 @@ BOOST_AUTO_TEST_CASE(partition_by_counts)
     }
 
     // check that the device supports partitioning by counts
-    if(!supports_partition_type(device, CL_DEVICE_PARTITION_BY_COUNTS)){
+    if(!device.supports_partition_type(CL_DEVICE_PARTITION_BY_COUNTS)){
         std::cout << "skipping test: "
                   << "device does not support CL_DEVICE_PARTITION_BY_COUNTS"
                   << std::endl;
@@ -197,7 +183,7 @@ BOOST_AUTO_TEST_CASE(partition_by_affinity_domain)
     BOOST_CHECK(device.is_subdevice() == false);
 
     // check that the device supports splitting by affinity domains
-    if(!supports_partition_type(device, CL_DEVICE_AFFINITY_DOMAIN_NEXT_PARTITIONABLE)){
+    if(!device.supports_affinity_domain(CL_DEVICE_AFFINITY_DOMAIN_NEXT_PARTITIONABLE)){
         std::cout << "skipping test: "
                   << "device does not support partitioning by affinity domain"
                   << std::endl;
@@ -209,6 +195,30 @@ BOOST_AUTO_TEST_CASE(partition_by_affinity_domain)
             CL_DEVICE_AFFINITY_DOMAIN_NEXT_PARTITIONABLE);
     BOOST_CHECK(sub_devices.size() > 0);
     BOOST_CHECK(sub_devices[0].is_subdevice() == true);
+    BOOST_CHECK(sub_devices[0].parent_device() == device);
+}
+
+BOOST_AUTO_TEST_CASE(partition_by_numa_node)
+{
+    boost::compute::device device = boost::compute::system::default_device();
+
+    REQUIRES_OPENCL_VERSION(1,2);
+
+    std::vector<boost::compute::device> nodes = device.partition_by_numa_node();
+    BOOST_CHECK(nodes.size() > 0);
+
+    if(!device.supports_affinity_domain(CL_DEVICE_AFFINITY_DOMAIN_NUMA)){
+        // falls back to the device itself
+        BOOST_CHECK_EQUAL(nodes.size(), size_t(1));
+        BOOST_CHECK(nodes[0] == device);
+        return;
+    }
+
+    BOOST_CHECK_LE(nodes.size(), size_t(device.partition_max_sub_devices()));
+    for(size_t i = 0; i < nodes.size(); i++){
+        BOOST_CHECK(nodes[i].is_subdevice() == true);
+        BOOST_CHECK(nodes[i].parent_device() == device);
+    }
 }
 #endif // CL_VERSION_1_2
 
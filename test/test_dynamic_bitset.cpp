@@ -13,6 +13,7 @@
 
 #include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/container/dynamic_bitset.hpp>
+#include <boost/compute/container/rank_select_index.hpp>
 
 #include "check_macros.hpp"
 #include "context_setup.hpp"
@@ -93,4 +94,82 @@ BOOST_AUTO_TEST_CASE(none_and_any)
     BOOST_CHECK(bits.none(queue) == true);
 }
 
+BOOST_AUTO_TEST_CASE(bulk_set_and_test)
+{
+    compute::dynamic_bitset<> bits(300, queue);
+
+    compute::uint_ data[] = { 3, 64, 65, 200, 299 };
+    compute::vector<compute::uint_> positions(data, data + 5, queue);
+    bits.set(positions, queue);
+    BOOST_CHECK_EQUAL(bits.count(queue), size_t(5));
+    BOOST_CHECK(bits.test(65, queue) == true);
+    BOOST_CHECK(bits.test(66, queue) == false);
+
+    compute::uint_ flip_data[] = { 3, 4 };
+    compute::vector<compute::uint_> flips(flip_data, flip_data + 2, queue);
+    bits.flip(flips, queue);
+
+    compute::uint_ test_data[] = { 3, 4, 64, 100 };
+    compute::vector<compute::uint_> tests(test_data, test_data + 4, queue);
+    compute::vector<compute::uchar_> results(context);
+    bits.test(tests, results, queue);
+    CHECK_RANGE_EQUAL(compute::uchar_, 4, results, (0, 1, 1, 0));
+
+    bits.reset(positions, queue);
+    BOOST_CHECK_EQUAL(bits.count(queue), size_t(1));
+}
+
+BOOST_AUTO_TEST_CASE(bitwise_and_find)
+{
+    compute::dynamic_bitset<> a(500, queue);
+    compute::dynamic_bitset<> b(500, queue);
+    a.set(10, queue);
+    a.set(130, queue);
+    a.set(400, queue);
+    b.set(130, queue);
+    b.set(450, queue);
+
+    compute::dynamic_bitset<> c(a);
+    c.bitwise_and(b, queue);
+    BOOST_CHECK_EQUAL(c.count(queue), size_t(1));
+    BOOST_CHECK_EQUAL(c.find_first(queue), size_t(130));
+    BOOST_CHECK_EQUAL(c.find_next(130, queue), size_t(c.npos));
+
+    c = a;
+    c.bitwise_andnot(b, queue);
+    BOOST_CHECK_EQUAL(c.find_first(queue), size_t(10));
+    BOOST_CHECK_EQUAL(c.find_next(10, queue), size_t(400));
+
+    a.bitwise_or(b, queue);
+    BOOST_CHECK_EQUAL(a.find_next(130, queue), size_t(400));
+    BOOST_CHECK_EQUAL(a.find_next(400, queue), size_t(450));
+    BOOST_CHECK_EQUAL(a.find_next(450, queue), size_t(a.npos));
+}
+
+BOOST_AUTO_TEST_CASE(rank_and_select)
+{
+    compute::dynamic_bitset<> bits(1000, queue);
+    bits.set(5, queue);
+    bits.set(63, queue);
+    bits.set(64, queue);
+    bits.set(700, queue);
+
+    compute::rank_select_index<> index(bits, queue);
+    BOOST_CHECK_EQUAL(index.count(), size_t(4));
+    BOOST_CHECK_EQUAL(index.rank(0, queue), size_t(0));
+    BOOST_CHECK_EQUAL(index.rank(64, queue), size_t(2));
+    BOOST_CHECK_EQUAL(index.rank(1000, queue), size_t(4));
+
+    compute::uint_ rank_data[] = { 0, 1, 2, 3, 4 };
+    compute::vector<compute::uint_> ranks(rank_data, rank_data + 5, queue);
+    compute::vector<compute::uint_> positions(context);
+    index.select(ranks, positions, queue);
+    CHECK_RANGE_EQUAL(
+        compute::uint_, 5, positions, (5, 63, 64, 700, compute::uint_(-1))
+    );
+
+    BOOST_CHECK_EQUAL(index.select(2, queue), size_t(64));
+    BOOST_CHECK_EQUAL(index.select(4, queue), size_t(index.npos));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
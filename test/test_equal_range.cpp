@@ -18,6 +18,7 @@
 #include <boost/compute/algorithm/equal_range.hpp>
 #include <boost/compute/container/vector.hpp>
 
+#include "check_macros.hpp"
 #include "context_setup.hpp"
 
 BOOST_AUTO_TEST_CASE(equal_range_int)
@@ -70,4 +71,22 @@ BOOST_AUTO_TEST_CASE(equal_range_int)
     BOOST_CHECK_EQUAL(std::distance(range6.first, range6.second), ptrdiff_t(0));
 }
 
+BOOST_AUTO_TEST_CASE(equal_range_many_values)
+{
+    int data[] = { 1, 2, 2, 2, 3, 3, 4, 5 };
+    boost::compute::vector<int> vector(data, data + 8, queue);
+
+    int values_data[] = { 2, 6, 3, 0 };
+    boost::compute::vector<int> values(values_data, values_data + 4, queue);
+
+    boost::compute::vector<boost::compute::uint_> lower(4, context);
+    boost::compute::vector<boost::compute::uint_> upper(4, context);
+    boost::compute::equal_range(
+        vector.begin(), vector.end(), values.begin(), values.end(),
+        lower.begin(), upper.begin(), queue
+    );
+    CHECK_RANGE_EQUAL(boost::compute::uint_, 4, lower, (1, 8, 4, 0));
+    CHECK_RANGE_EQUAL(boost::compute::uint_, 4, upper, (4, 8, 6, 0));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -12,11 +12,13 @@
 #include <boost/test/unit_test.hpp>
 
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/host_dispatch.hpp>
 #include <boost/compute/lambda.hpp>
 #include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/find.hpp>
 #include <boost/compute/algorithm/find_if.hpp>
 #include <boost/compute/algorithm/find_if_not.hpp>
+#include <boost/compute/algorithm/iota.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/iterator/constant_buffer_iterator.hpp>
 
@@ -103,4 +105,62 @@ BOOST_AUTO_TEST_CASE(find_point_by_distance)
     BOOST_CHECK_EQUAL(value, float2_(4, 4));
 }
 
+BOOST_AUTO_TEST_CASE(find_large_range)
+{
+    // large enough to be searched in windows with early exit
+    compute::vector<int> vec(3 * 1024 * 1024, context);
+    compute::iota(vec.begin(), vec.end(), 0, queue);
+
+    BOOST_CHECK(compute::find(vec.begin(), vec.end(), 0, queue) == vec.begin());
+    BOOST_CHECK(compute::find(vec.begin(), vec.end(), 70000, queue) == vec.begin() + 70000);
+    BOOST_CHECK(compute::find(vec.begin(), vec.end(), 3000000, queue) == vec.begin() + 3000000);
+    BOOST_CHECK(compute::find(vec.begin(), vec.end(), -1, queue) == vec.end());
+
+    // the first match is returned when many elements match
+    BOOST_CHECK(
+        compute::find_if(vec.begin(), vec.end(), compute::lambda::_1 > 100000, queue) ==
+            vec.begin() + 100001
+    );
+}
+
+BOOST_AUTO_TEST_CASE(find_host_dispatch)
+{
+    using boost::compute::host_dispatch;
+
+    const size_t threshold =
+        host_dispatch::threshold(device, host_dispatch::find_algorithm);
+
+    int data[] = { 9, 15, 1, 4, 9, 9, 4, 15, 12, 1 };
+    bc::vector<int> vector(data, data + 10, queue);
+
+    // searched on the device and then on the host
+    const size_t thresholds[] = { 0, 1024 };
+    for(size_t i = 0; i < 2; i++){
+        host_dispatch::set_threshold(
+            device, host_dispatch::find_algorithm, thresholds[i]
+        );
+        BOOST_CHECK_EQUAL(
+            host_dispatch::threshold(device, host_dispatch::find_algorithm),
+            thresholds[i]
+        );
+
+        BOOST_CHECK(
+            bc::find(vector.begin(), vector.end(), 4, queue) == vector.begin() + 3
+        );
+        BOOST_CHECK(
+            bc::find(vector.begin() + 4, vector.end(), 1, queue) == vector.begin() + 9
+        );
+        BOOST_CHECK(
+            bc::find(vector.begin(), vector.end(), 7, queue) == vector.end()
+        );
+
+        // the value is not converted to the value type of the range
+        BOOST_CHECK(
+            bc::find(vector.begin(), vector.end(), 4.5f, queue) == vector.end()
+        );
+    }
+
+    host_dispatch::set_threshold(device, host_dispatch::find_algorithm, threshold);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
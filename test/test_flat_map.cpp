@@ -12,11 +12,13 @@
 #include <boost/test/unit_test.hpp>
 
 #include <utility>
+#include <vector>
 
 #include <boost/concept_check.hpp>
 
 #include <boost/compute/container/flat_map.hpp>
 
+#include "check_macros.hpp"
 #include "context_setup.hpp"
 
 BOOST_AUTO_TEST_CASE(concept_check)
@@ -71,4 +73,53 @@ BOOST_AUTO_TEST_CASE(index_operator)
     BOOST_CHECK_EQUAL(float(map[4]), float(4.4f));
 }
 
+BOOST_AUTO_TEST_CASE(insert_range)
+{
+    boost::compute::flat_map<int, float> map(context);
+    map.insert(std::make_pair(2, 2.2f), queue);
+
+    std::vector<std::pair<int, float> > pairs;
+    pairs.push_back(std::make_pair(4, 4.4f));
+    pairs.push_back(std::make_pair(1, 1.1f));
+    pairs.push_back(std::make_pair(2, -2.2f));
+    pairs.push_back(std::make_pair(3, 3.3f));
+    map.insert(pairs.begin(), pairs.end(), queue);
+    queue.finish();
+
+    // the existing value for key 2 is not replaced
+    BOOST_CHECK_EQUAL(map.size(), size_t(4));
+    BOOST_CHECK(map.find(1, queue) == map.begin() + 0);
+    BOOST_CHECK(map.find(4, queue) == map.begin() + 3);
+    BOOST_CHECK_EQUAL(float(map.at(2)), float(2.2f));
+    BOOST_CHECK_EQUAL(float(map.at(3)), float(3.3f));
+}
+
+BOOST_AUTO_TEST_CASE(erase_keys)
+{
+    boost::compute::flat_map<int, float> map(context);
+    map.insert(std::make_pair(1, 1.1f), queue);
+    map.insert(std::make_pair(2, 2.2f), queue);
+    map.insert(std::make_pair(3, 3.3f), queue);
+
+    int keys[] = { 3, 1, 5 };
+    BOOST_CHECK_EQUAL(map.erase_keys(keys, keys + 3, queue), size_t(2));
+    BOOST_CHECK_EQUAL(map.size(), size_t(1));
+    BOOST_CHECK_EQUAL(float(map.at(2)), float(2.2f));
+}
+
+BOOST_AUTO_TEST_CASE(find_range)
+{
+    boost::compute::flat_map<int, float> map(context);
+    map.insert(std::make_pair(7, 7.7f), queue);
+    map.insert(std::make_pair(3, 3.3f), queue);
+    map.insert(std::make_pair(5, 5.5f), queue);
+
+    int query_data[] = { 5, 4, 7, 3 };
+    boost::compute::vector<int> queries(query_data, query_data + 4, queue);
+    boost::compute::vector<boost::compute::uint_> result(4, context);
+
+    map.find(queries.begin(), queries.end(), result.begin(), queue);
+    CHECK_RANGE_EQUAL(boost::compute::uint_, 4, result, (1, 3, 2, 0));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
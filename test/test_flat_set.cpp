@@ -19,6 +19,7 @@
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/container/flat_set.hpp>
 
+#include "check_macros.hpp"
 #include "context_setup.hpp"
 
 namespace bc = boost::compute;
@@ -122,4 +123,58 @@ BOOST_AUTO_TEST_CASE(clear)
     BOOST_CHECK_EQUAL(set.size(), size_t(0));
 }
 
+BOOST_AUTO_TEST_CASE(insert_range)
+{
+    bc::flat_set<int> set(context);
+    set.insert(5, queue);
+    set.insert(1, queue);
+
+    int data[] = { 4, 1, 9, 4, 0, 5, 7 };
+    set.insert(data, data + 7, queue);
+    BOOST_CHECK_EQUAL(set.size(), size_t(6));
+    CHECK_RANGE_EQUAL(int, 6, set, (0, 1, 4, 5, 7, 9));
+
+    // inserting existing values has no effect
+    set.insert(data, data + 3, queue);
+    BOOST_CHECK_EQUAL(set.size(), size_t(6));
+}
+
+BOOST_AUTO_TEST_CASE(erase_keys)
+{
+    bc::flat_set<int> set(context);
+    int data[] = { 1, 2, 3, 4, 5, 6 };
+    set.insert(data, data + 6, queue);
+
+    int keys[] = { 6, 2, 8, 2, 3 };
+    BOOST_CHECK_EQUAL(set.erase_keys(keys, keys + 5, queue), size_t(3));
+    BOOST_CHECK_EQUAL(set.size(), size_t(3));
+    CHECK_RANGE_EQUAL(int, 3, set, (1, 4, 5));
+}
+
+BOOST_AUTO_TEST_CASE(find_range)
+{
+    bc::flat_set<int> set(context);
+    int data[] = { 10, 20, 30, 40 };
+    set.insert(data, data + 4, queue);
+
+    BOOST_CHECK(set.find(30, queue) == set.begin() + 2);
+    BOOST_CHECK(set.find(35, queue) == set.end());
+
+    int query_data[] = { 40, 5, 10, 25 };
+    bc::vector<int> queries(query_data, query_data + 4, queue);
+    bc::vector<bc::uint_> result(4, context);
+
+    set.find(queries.begin(), queries.end(), result.begin(), queue);
+    CHECK_RANGE_EQUAL(bc::uint_, 4, result, (3, 4, 0, 4));
+
+    set.count(queries.begin(), queries.end(), result.begin(), queue);
+    CHECK_RANGE_EQUAL(bc::uint_, 4, result, (1, 0, 1, 0));
+
+    set.lower_bound(queries.begin(), queries.end(), result.begin(), queue);
+    CHECK_RANGE_EQUAL(bc::uint_, 4, result, (3, 0, 0, 2));
+
+    set.upper_bound(queries.begin(), queries.end(), result.begin(), queue);
+    CHECK_RANGE_EQUAL(bc::uint_, 4, result, (4, 0, 1, 2));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
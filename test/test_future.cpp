@@ -0,0 +1,209 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestFuture
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+
+#include <boost/compute/user_event.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/async/coroutine.hpp>
+#include <boost/compute/async/when_all.hpp>
+#include <boost/compute/async/when_any.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+}
+
+#ifdef CL_VERSION_1_1
+int add_one(compute::future<int> &f)
+{
+    return f.get() + 1;
+}
+
+int throw_error(compute::future<int> &)
+{
+    throw std::runtime_error("continuation error");
+}
+
+struct counting_executor
+{
+    counting_executor(int *count)
+        : m_count(count)
+    {
+    }
+
+    void operator()(const boost::function<void()> &function) const
+    {
+        (*m_count)++;
+        function();
+    }
+
+    int *m_count;
+};
+
+BOOST_AUTO_TEST_CASE(then)
+{
+    compute::user_event event(context);
+    compute::future<int> future(41, event);
+
+    compute::future<int> result = future.then(add_one);
+    BOOST_CHECK(result.get_event().status() != CL_COMPLETE);
+
+    event.set_status(CL_COMPLETE);
+    BOOST_CHECK_EQUAL(result.get(), 42);
+
+    // chained continuations
+    compute::future<int> chained = future.then(add_one).then(add_one);
+    BOOST_CHECK_EQUAL(chained.get(), 43);
+}
+
+BOOST_AUTO_TEST_CASE(then_device_result)
+{
+    int data[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    compute::vector<int> vector(data, data + 8, queue);
+
+    // the continuation reads the sum from the event callback without
+    // blocking
+    compute::future<int> sum =
+        compute::reduce_async(vector.begin(), vector.end(), queue);
+    compute::future<int> result = sum.then(add_one);
+
+    BOOST_CHECK_EQUAL(result.get(), 37);
+    BOOST_CHECK_EQUAL(sum.get(), 36);
+}
+
+BOOST_AUTO_TEST_CASE(then_executor)
+{
+    int count = 0;
+
+    compute::user_event event(context);
+    compute::future<int> future(1, event);
+    compute::future<int> result =
+        future.then(add_one, counting_executor(&count));
+
+    event.set_status(CL_COMPLETE);
+    BOOST_CHECK_EQUAL(result.get(), 2);
+    BOOST_CHECK_EQUAL(count, 1);
+}
+
+BOOST_AUTO_TEST_CASE(then_exception)
+{
+    compute::user_event event(context);
+    compute::future<int> future(1, event);
+    compute::future<int> result = future.then(throw_error);
+
+    event.set_status(CL_COMPLETE);
+    BOOST_CHECK_THROW(result.get(), std::runtime_error);
+}
+
+int deferred_calls = 0;
+
+int count_deferred_call()
+{
+    return ++deferred_calls;
+}
+
+BOOST_AUTO_TEST_CASE(void_future_keeps_deferred)
+{
+    compute::user_event event(context);
+    compute::future<int> future(
+        event, boost::function<int()>(count_deferred_call)
+    );
+
+    // the deferred part of the result still runs through future<void>
+    compute::future<void> void_future = future;
+    event.set_status(CL_COMPLETE);
+    void_future.get();
+    BOOST_CHECK_EQUAL(deferred_calls, 1);
+}
+
+BOOST_AUTO_TEST_CASE(when_all)
+{
+    compute::user_event a(context);
+    compute::user_event b(context);
+
+    compute::wait_list events;
+    events.insert(a);
+    events.insert(b);
+
+    compute::future<void> all = compute::when_all(events);
+    BOOST_CHECK(all.get_event().status() != CL_COMPLETE);
+
+    a.set_status(CL_COMPLETE);
+    BOOST_CHECK(all.get_event().status() != CL_COMPLETE);
+
+    b.set_status(CL_COMPLETE);
+    all.wait();
+    BOOST_CHECK(all.get_event().status() == CL_COMPLETE);
+}
+
+BOOST_AUTO_TEST_CASE(when_any)
+{
+    compute::user_event a(context);
+    compute::user_event b(context);
+
+    compute::wait_list events;
+    events.insert(a);
+    events.insert(b);
+
+    compute::future<size_t> any = compute::when_any(events);
+
+    b.set_status(CL_COMPLETE);
+    BOOST_CHECK_EQUAL(any.get(), size_t(1));
+
+    a.set_status(CL_COMPLETE);
+    BOOST_CHECK_EQUAL(any.get(), size_t(1));
+}
+#endif // CL_VERSION_1_1
+
+#ifdef BOOST_COMPUTE_HAVE_COROUTINES
+struct detached_task
+{
+    struct promise_type
+    {
+        detached_task get_return_object() { return detached_task(); }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() { }
+        void unhandled_exception() { }
+    };
+};
+
+detached_task await_value(compute::future<int> future, int *result,
+                          compute::user_event done)
+{
+    *result = co_await future;
+    done.set_status(CL_COMPLETE);
+}
+
+BOOST_AUTO_TEST_CASE(coroutine_await)
+{
+    compute::user_event event(context);
+    compute::user_event done(context);
+
+    int result = 0;
+    await_value(compute::future<int>(7, event), &result, done);
+    BOOST_CHECK_EQUAL(result, 0);
+
+    event.set_status(CL_COMPLETE);
+    done.wait();
+    BOOST_CHECK_EQUAL(result, 7);
+}
+#endif // BOOST_COMPUTE_HAVE_COROUTINES
+
+BOOST_AUTO_TEST_SUITE_END()
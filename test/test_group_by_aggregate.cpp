@@ -0,0 +1,130 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestGroupByAggregate
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/group_by_aggregate.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/integer.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/iterator/constant_iterator.hpp>
+
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+// copies the (unordered) groups to a map for comparison
+template<class Key, class T>
+std::map<Key, T> to_map(const compute::vector<Key> &keys,
+                        const compute::vector<T> &values,
+                        compute::command_queue &queue)
+{
+    std::vector<Key> host_keys(keys.size());
+    std::vector<T> host_values(values.size());
+    compute::copy(keys.begin(), keys.end(), host_keys.begin(), queue);
+    compute::copy(values.begin(), values.end(), host_values.begin(), queue);
+
+    std::map<Key, T> result;
+    for(size_t i = 0; i < host_keys.size(); i++){
+        result[host_keys[i]] = host_values[i];
+    }
+    return result;
+}
+
+BOOST_AUTO_TEST_CASE(sum_int)
+{
+    int keys_data[] = { 4, 1, 4, 7, 1, 4, 2 };
+    int values_data[] = { 1, 2, 3, 4, 5, 6, 7 };
+    compute::vector<int> keys(keys_data, keys_data + 7, queue);
+    compute::vector<int> values(values_data, values_data + 7, queue);
+
+    compute::vector<int> keys_result(context);
+    compute::vector<int> values_result(context);
+    size_t groups = compute::group_by_aggregate(
+        keys.begin(), keys.end(), values.begin(),
+        keys_result, values_result, compute::plus<int>(), queue
+    );
+    BOOST_CHECK_EQUAL(groups, size_t(4));
+    BOOST_CHECK_EQUAL(keys_result.size(), size_t(4));
+    BOOST_CHECK_EQUAL(values_result.size(), size_t(4));
+
+    std::map<int, int> result = to_map(keys_result, values_result, queue);
+    BOOST_CHECK_EQUAL(result[1], 7);
+    BOOST_CHECK_EQUAL(result[2], 7);
+    BOOST_CHECK_EQUAL(result[4], 10);
+    BOOST_CHECK_EQUAL(result[7], 4);
+}
+
+BOOST_AUTO_TEST_CASE(count_and_max_uint)
+{
+    // many rows over few keys exercises the local pre-aggregation
+    std::vector<compute::uint_> host_keys(4096);
+    std::vector<compute::uint_> host_values(4096);
+    for(size_t i = 0; i < host_keys.size(); i++){
+        host_keys[i] = static_cast<compute::uint_>(i % 5);
+        host_values[i] = static_cast<compute::uint_>(i);
+    }
+    compute::vector<compute::uint_> keys(host_keys.begin(), host_keys.end(), queue);
+    compute::vector<compute::uint_> values(host_values.begin(), host_values.end(), queue);
+
+    compute::vector<compute::uint_> keys_result(context);
+    compute::vector<compute::uint_> counts(context);
+    size_t groups = compute::group_by_aggregate(
+        keys.begin(), keys.end(),
+        compute::make_constant_iterator<compute::uint_>(1),
+        keys_result, counts, compute::plus<compute::uint_>(), queue
+    );
+    BOOST_CHECK_EQUAL(groups, size_t(5));
+
+    std::map<compute::uint_, compute::uint_> count_map =
+        to_map(keys_result, counts, queue);
+    BOOST_CHECK_EQUAL(count_map[0], compute::uint_(820));
+    BOOST_CHECK_EQUAL(count_map[4], compute::uint_(819));
+
+    compute::vector<compute::uint_> maximums(context);
+    compute::group_by_aggregate(
+        keys.begin(), keys.end(), values.begin(),
+        keys_result, maximums, compute::max<compute::uint_>(), queue
+    );
+
+    std::map<compute::uint_, compute::uint_> max_map =
+        to_map(keys_result, maximums, queue);
+    BOOST_CHECK_EQUAL(max_map[0], compute::uint_(4095));
+    BOOST_CHECK_EQUAL(max_map[1], compute::uint_(4091));
+    BOOST_CHECK_EQUAL(max_map[4], compute::uint_(4094));
+}
+
+BOOST_AUTO_TEST_CASE(min_float)
+{
+    int keys_data[] = { 3, 3, 9, 9, 9, 3 };
+    float values_data[] = { 2.5f, -1.0f, 4.0f, 8.0f, 0.5f, 7.0f };
+    compute::vector<int> keys(keys_data, keys_data + 6, queue);
+    compute::vector<float> values(values_data, values_data + 6, queue);
+
+    compute::vector<int> keys_result(context);
+    compute::vector<float> values_result(context);
+    size_t groups = compute::group_by_aggregate(
+        keys.begin(), keys.end(), values.begin(),
+        keys_result, values_result, compute::min<float>(), queue
+    );
+    BOOST_CHECK_EQUAL(groups, size_t(2));
+
+    std::map<int, float> result = to_map(keys_result, values_result, queue);
+    BOOST_CHECK_EQUAL(result[3], -1.0f);
+    BOOST_CHECK_EQUAL(result[9], 0.5f);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,220 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestHalf
+#include <boost/test/unit_test.hpp>
+
+#include <limits>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/functional.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/types/half.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+using compute::half_;
+
+BOOST_AUTO_TEST_CASE(half_type_name)
+{
+    BOOST_CHECK(std::strcmp(compute::type_name<half_>(), "half") == 0);
+    BOOST_CHECK_EQUAL(sizeof(half_), size_t(2));
+}
+
+BOOST_AUTO_TEST_CASE(host_conversions)
+{
+    BOOST_CHECK_EQUAL(half_(1.0f).bits(), 0x3c00);
+    BOOST_CHECK_EQUAL(half_(-2.0f).bits(), 0xc000);
+    BOOST_CHECK_EQUAL(half_(65504.0f).bits(), 0x7bff);
+    BOOST_CHECK_EQUAL(half_(0.0f).bits(), 0x0000);
+
+    // rounds to the nearest half, ties to even
+    BOOST_CHECK_EQUAL(half_(1.0f + 1.0f / 4096).bits(), 0x3c00);
+    BOOST_CHECK_EQUAL(half_(1.0f + 3.0f / 4096).bits(), 0x3c02);
+
+    // overflows to infinity
+    BOOST_CHECK_EQUAL(half_(65520.0f).bits(), 0x7c00);
+    BOOST_CHECK_EQUAL(
+        half_(-std::numeric_limits<float>::infinity()).bits(), 0xfc00
+    );
+
+    // subnormals
+    BOOST_CHECK_EQUAL(half_(5.9604645e-8f).bits(), 0x0001);
+    BOOST_CHECK_EQUAL(float(half_::from_bits(0x0001)), 5.9604645e-8f);
+
+    // every half value converts to float and back exactly
+    for(compute::uint_ bits = 0; bits < 0x7c00; bits++){
+        const half_ value = half_::from_bits(compute::ushort_(bits));
+        BOOST_CHECK_EQUAL(half_(float(value)).bits(), bits);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(copy_half_to_float)
+{
+    float data[] = { 1.0f, -0.5f, 2.25f, 1024.0f, -3.0f };
+    std::vector<half_> halves(data, data + 5);
+
+    compute::vector<half_> input(halves.begin(), halves.end(), queue);
+    compute::vector<float> output(5, context);
+
+    // half -> float
+    compute::copy(input.begin(), input.end(), output.begin(), queue);
+
+    std::vector<float> host_output(5);
+    compute::copy(output.begin(), output.end(), host_output.begin(), queue);
+    for(size_t i = 0; i < 5; i++){
+        BOOST_CHECK_EQUAL(host_output[i], data[i]);
+    }
+
+    // float -> half
+    compute::vector<half_> halves_output(5, context);
+    compute::copy(output.begin(), output.end(), halves_output.begin(), queue);
+
+    std::vector<half_> host_halves(5);
+    compute::copy(
+        halves_output.begin(), halves_output.end(), host_halves.begin(), queue
+    );
+    for(size_t i = 0; i < 5; i++){
+        BOOST_CHECK_EQUAL(host_halves[i].bits(), halves[i].bits());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(fill_half)
+{
+    compute::vector<half_> vector(10, context);
+    compute::fill(vector.begin(), vector.end(), half_(1.5f), queue);
+
+    std::vector<half_> host_vector(10);
+    compute::copy(vector.begin(), vector.end(), host_vector.begin(), queue);
+    for(size_t i = 0; i < 10; i++){
+        BOOST_CHECK_EQUAL(float(host_vector[i]), 1.5f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(transform_half)
+{
+    using compute::lambda::_1;
+    using compute::lambda::_2;
+
+    // large enough for vector loads and stores with a partial tail
+    const size_t size = 1001;
+
+    std::vector<half_> host_x(size);
+    std::vector<float> host_y(size);
+    for(size_t i = 0; i < size; i++){
+        host_x[i] = half_(float(i % 64) * 0.25f);
+        host_y[i] = float(i % 7);
+    }
+
+    compute::vector<half_> x(host_x.begin(), host_x.end(), queue);
+    compute::vector<float> y(host_y.begin(), host_y.end(), queue);
+    compute::vector<half_> z(size, context);
+
+    // z <- 2 * x + y, computed in float and rounded once when stored
+    compute::transform(
+        x.begin(), x.end(), y.begin(), z.begin(), 2.0f * _1 + _2, queue
+    );
+
+    std::vector<half_> host_z(size);
+    compute::copy(z.begin(), z.end(), host_z.begin(), queue);
+    for(size_t i = 0; i < size; i++){
+        const half_ expected(2.0f * float(host_x[i]) + host_y[i]);
+        BOOST_CHECK_EQUAL(host_z[i].bits(), expected.bits());
+    }
+
+    // x <- x * x, with an unaligned start
+    compute::transform(
+        x.begin() + 1, x.end(), x.begin() + 1, _1 * _1, queue
+    );
+
+    std::vector<half_> host_squares(size);
+    compute::copy(x.begin(), x.end(), host_squares.begin(), queue);
+    BOOST_CHECK_EQUAL(host_squares[0].bits(), host_x[0].bits());
+    for(size_t i = 1; i < size; i++){
+        const half_ expected(float(host_x[i]) * float(host_x[i]));
+        BOOST_CHECK_EQUAL(host_squares[i].bits(), expected.bits());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(reduce_half)
+{
+    // sums of halves are accumulated in float
+    std::vector<half_> host_vector(10000, half_(0.5f));
+    compute::vector<half_> vector(
+        host_vector.begin(), host_vector.end(), queue
+    );
+
+    float sum = 0;
+    compute::reduce(vector.begin(), vector.end(), &sum, queue);
+    BOOST_CHECK_EQUAL(sum, 5000.0f);
+
+    float max = 0;
+    compute::reduce(
+        vector.begin(), vector.end(), &max, compute::max<float>(), queue
+    );
+    BOOST_CHECK_EQUAL(max, 0.5f);
+}
+
+BOOST_AUTO_TEST_CASE(reduce_async_half)
+{
+    // reduce_async() accumulates in float like reduce()
+    std::vector<half_> host_vector(10000, half_(0.5f));
+    compute::vector<half_> vector(
+        host_vector.begin(), host_vector.end(), queue
+    );
+
+    compute::future<float> sum =
+        compute::reduce_async(vector.begin(), vector.end(), queue);
+    BOOST_CHECK_EQUAL(sum.get(), 5000.0f);
+
+    compute::future<float> max = compute::reduce_async(
+        vector.begin(), vector.end(), compute::max<float>(), queue
+    );
+    BOOST_CHECK_EQUAL(max.get(), 0.5f);
+}
+
+BOOST_AUTO_TEST_CASE(sort_half)
+{
+    const size_t size = 1000;
+
+    std::vector<half_> host_vector(size);
+    for(size_t i = 0; i < size; i++){
+        host_vector[i] = half_(float((i * 37) % 101) - 50.0f);
+    }
+    host_vector[7] = half_(-std::numeric_limits<float>::infinity());
+    host_vector[8] = half_(std::numeric_limits<float>::infinity());
+
+    compute::vector<half_> vector(
+        host_vector.begin(), host_vector.end(), queue
+    );
+    compute::sort(vector.begin(), vector.end(), queue);
+
+    std::vector<half_> sorted(size);
+    compute::copy(vector.begin(), vector.end(), sorted.begin(), queue);
+
+    std::vector<float> expected(host_vector.begin(), host_vector.end());
+    std::sort(expected.begin(), expected.end());
+    for(size_t i = 0; i < size; i++){
+        BOOST_CHECK_EQUAL(float(sorted[i]), expected[i]);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
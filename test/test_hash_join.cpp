@@ -0,0 +1,119 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestHashJoin
+#include <boost/test/unit_test.hpp>
+
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/hash_join.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+typedef std::set<std::pair<compute::uint_, compute::uint_> > pair_set;
+
+pair_set to_pairs(const compute::vector<compute::uint_> &build_indices,
+                  const compute::vector<compute::uint_> &probe_indices,
+                  compute::command_queue &queue)
+{
+    std::vector<compute::uint_> build(build_indices.size());
+    std::vector<compute::uint_> probe(probe_indices.size());
+    compute::copy(build_indices.begin(), build_indices.end(), build.begin(), queue);
+    compute::copy(probe_indices.begin(), probe_indices.end(), probe.begin(), queue);
+
+    pair_set pairs;
+    for(size_t i = 0; i < build.size(); i++){
+        pairs.insert(std::make_pair(build[i], probe[i]));
+    }
+    return pairs;
+}
+
+BOOST_AUTO_TEST_CASE(join_unique_keys)
+{
+    int build_data[] = { 10, 20, 30, 40 };
+    int probe_data[] = { 30, 50, 10, 30 };
+    compute::vector<int> build(build_data, build_data + 4, queue);
+    compute::vector<int> probe(probe_data, probe_data + 4, queue);
+
+    compute::vector<compute::uint_> build_indices(context);
+    compute::vector<compute::uint_> probe_indices(context);
+    size_t count = compute::hash_join(
+        build.begin(), build.end(), probe.begin(), probe.end(),
+        build_indices, probe_indices, queue
+    );
+    BOOST_CHECK_EQUAL(count, size_t(3));
+    BOOST_CHECK_EQUAL(build_indices.size(), size_t(3));
+    BOOST_CHECK_EQUAL(probe_indices.size(), size_t(3));
+
+    pair_set pairs = to_pairs(build_indices, probe_indices, queue);
+    BOOST_CHECK(pairs.count(std::make_pair(2u, 0u)) == 1);
+    BOOST_CHECK(pairs.count(std::make_pair(0u, 2u)) == 1);
+    BOOST_CHECK(pairs.count(std::make_pair(2u, 3u)) == 1);
+}
+
+BOOST_AUTO_TEST_CASE(join_duplicate_keys)
+{
+    // key 1 appears twice on each side giving four matches
+    compute::uint_ build_data[] = { 1, 2, 1, 3 };
+    compute::uint_ probe_data[] = { 1, 3, 1, 4 };
+    compute::vector<compute::uint_> build(build_data, build_data + 4, queue);
+    compute::vector<compute::uint_> probe(probe_data, probe_data + 4, queue);
+
+    compute::vector<compute::uint_> build_indices(context);
+    compute::vector<compute::uint_> probe_indices(context);
+    size_t count = compute::hash_join(
+        build.begin(), build.end(), probe.begin(), probe.end(),
+        build_indices, probe_indices, queue
+    );
+    BOOST_CHECK_EQUAL(count, size_t(5));
+
+    pair_set pairs = to_pairs(build_indices, probe_indices, queue);
+    BOOST_CHECK_EQUAL(pairs.size(), size_t(5));
+    BOOST_CHECK(pairs.count(std::make_pair(0u, 0u)) == 1);
+    BOOST_CHECK(pairs.count(std::make_pair(2u, 0u)) == 1);
+    BOOST_CHECK(pairs.count(std::make_pair(0u, 2u)) == 1);
+    BOOST_CHECK(pairs.count(std::make_pair(2u, 2u)) == 1);
+    BOOST_CHECK(pairs.count(std::make_pair(3u, 1u)) == 1);
+
+    // results are ordered by probe row
+    std::vector<compute::uint_> probe_rows(count);
+    compute::copy(
+        probe_indices.begin(), probe_indices.end(), probe_rows.begin(), queue
+    );
+    BOOST_CHECK_EQUAL(probe_rows[0], 0u);
+    BOOST_CHECK_EQUAL(probe_rows[2], 1u);
+    BOOST_CHECK_EQUAL(probe_rows[4], 2u);
+}
+
+BOOST_AUTO_TEST_CASE(join_no_matches)
+{
+    int build_data[] = { 1, 2, 3 };
+    int probe_data[] = { 4, 5 };
+    compute::vector<int> build(build_data, build_data + 3, queue);
+    compute::vector<int> probe(probe_data, probe_data + 2, queue);
+
+    compute::vector<compute::uint_> build_indices(context);
+    compute::vector<compute::uint_> probe_indices(context);
+    size_t count = compute::hash_join(
+        build.begin(), build.end(), probe.begin(), probe.end(),
+        build_indices, probe_indices, queue
+    );
+    BOOST_CHECK_EQUAL(count, size_t(0));
+    BOOST_CHECK(build_indices.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,110 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestHistogram
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/function.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/histogram.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(histogram_int_keys)
+{
+    int data[] = { 0, 2, 2, 1, 4, 2, 7, -1, 0 };
+    compute::vector<int> input(data, data + 9, queue);
+    compute::vector<compute::uint_> bins(5, context);
+
+    // 7 and -1 are outside of the bins
+    compute::histogram(input.begin(), input.end(), bins.begin(), 5, queue);
+    CHECK_RANGE_EQUAL(compute::uint_, 5, bins, (2, 1, 3, 0, 1));
+}
+
+BOOST_AUTO_TEST_CASE(histogram_function)
+{
+    std::vector<int> data(10000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<int>(i);
+    }
+    compute::vector<int> input(data.begin(), data.end(), queue);
+    compute::vector<compute::uint_> bins(10, context);
+
+    BOOST_COMPUTE_FUNCTION(compute::uint_, last_digit, (int x),
+    {
+        return x % 10;
+    });
+
+    compute::histogram(
+        input.begin(), input.end(), bins.begin(), 10, last_digit, queue
+    );
+    CHECK_RANGE_EQUAL(
+        compute::uint_, 10, bins,
+        (1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000)
+    );
+}
+
+BOOST_AUTO_TEST_CASE(histogram_even_float)
+{
+    float data[] = { 0.5f, 1.5f, 9.99f, 10.0f, -0.1f, 5.0f, 4.99f, 0.0f };
+    compute::vector<float> input(data, data + 8, queue);
+    compute::vector<compute::uint_> bins(5, context);
+
+    compute::histogram_even(
+        input.begin(), input.end(), bins.begin(), 5, 0.0f, 10.0f, queue
+    );
+    CHECK_RANGE_EQUAL(compute::uint_, 5, bins, (3, 0, 2, 0, 1));
+}
+
+BOOST_AUTO_TEST_CASE(histogram_range_int)
+{
+    int data[] = { 1, 5, 10, 50, 100, 500, 1000, 0 };
+    compute::vector<int> input(data, data + 8, queue);
+
+    // logarithmic bins [1, 10) [10, 100) [100, 1000)
+    int edges_data[] = { 1, 10, 100, 1000 };
+    compute::vector<int> edges(edges_data, edges_data + 4, queue);
+    compute::vector<compute::uint_> bins(3, context);
+
+    compute::histogram_range(
+        input.begin(), input.end(), bins.begin(),
+        edges.begin(), edges.end(), queue
+    );
+    CHECK_RANGE_EQUAL(compute::uint_, 3, bins, (2, 2, 2));
+}
+
+BOOST_AUTO_TEST_CASE(weighted_histogram_float)
+{
+    int keys_data[] = { 0, 1, 0, 2, 1, 0 };
+    float weights_data[] = { 0.5f, 1.0f, 1.5f, 2.0f, 3.0f, 4.0f };
+    compute::vector<int> keys(keys_data, keys_data + 6, queue);
+    compute::vector<float> weights(weights_data, weights_data + 6, queue);
+    compute::vector<float> bins(3, context);
+
+    compute::weighted_histogram(
+        keys.begin(), keys.end(), weights.begin(), bins.begin(), 3, queue
+    );
+    CHECK_RANGE_EQUAL(float, 3, bins, (6.0f, 4.0f, 2.0f));
+
+    compute::weighted_histogram_even(
+        keys.begin(), keys.end(), weights.begin(), bins.begin(),
+        3, 0.0f, 3.0f, queue
+    );
+    CHECK_RANGE_EQUAL(float, 3, bins, (6.0f, 4.0f, 2.0f));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
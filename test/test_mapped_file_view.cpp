@@ -0,0 +1,93 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestMappedFileView
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/mapped_file_view.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(write_and_map_file)
+{
+    const char *path = "test_mapped_file_view.bin";
+
+    compute::vector<int> values(1000, context);
+    compute::iota(values.begin(), values.end(), 0, queue);
+    compute::write_to_file(values.begin(), values.end(), path, queue);
+
+    // read_only views are only accessed through their const members
+    const compute::mapped_file_view<int> view(path, context);
+    BOOST_CHECK_EQUAL(view.size(), size_t(1000));
+    BOOST_CHECK_EQUAL(view.data()[0], 0);
+    BOOST_CHECK_EQUAL(view.data()[999], 999);
+
+    // stream in chunks smaller than the file
+    compute::vector<int> result(1000, context);
+    view.copy_to(result.begin(), queue, 1024);
+
+    int sum = 0;
+    compute::reduce(result.begin(), result.end(), &sum, queue);
+    BOOST_CHECK_EQUAL(sum, 999 * 1000 / 2);
+
+    if(view.is_device_accessible()){
+        compute::reduce(view.begin(), view.end(), &sum, queue);
+        BOOST_CHECK_EQUAL(sum, 999 * 1000 / 2);
+    }
+
+    std::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(copy_on_write_file)
+{
+    const char *path = "test_mapped_file_view_cow.bin";
+
+    compute::vector<int> values(100, context);
+    compute::iota(values.begin(), values.end(), 0, queue);
+    compute::write_to_file(values.begin(), values.end(), path, queue);
+
+    compute::mapped_file_view<int> view(
+        path, context, compute::mapped_file_view<int>::copy_on_write
+    );
+    BOOST_CHECK_EQUAL(view.size(), size_t(100));
+
+    // writes go to private copies of the pages
+    view.data()[0] = 42;
+    BOOST_CHECK_EQUAL(view.data()[0], 42);
+
+    const compute::mapped_file_view<int> file(path, context);
+    BOOST_CHECK_EQUAL(file.data()[0], 0);
+
+    std::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(map_empty_file)
+{
+    const char *path = "test_mapped_file_view_empty.bin";
+
+    compute::vector<int> values(context);
+    compute::write_to_file(values.begin(), values.end(), path, queue);
+
+    compute::mapped_file_view<int> view(path, context);
+    BOOST_CHECK(view.empty());
+
+    std::remove(path);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,105 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestMultiReduce
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <iostream>
+
+#include <boost/tuple/tuple.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/multi_reduce.hpp>
+#include <boost/compute/algorithm/minmax_element.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(min_max_sum_count_int)
+{
+    int data[] = { 4, -2, 9, 7, -5, 3, 9, 0 };
+    compute::vector<int> vector(data, data + 8, queue);
+
+    boost::tuple<int, int, compute::long_, compute::ulong_, compute::uint_> r =
+        compute::multi_reduce(
+            vector.begin(), vector.end(),
+            boost::make_tuple(compute::min_reducer<int>(),
+                              compute::max_reducer<int>(),
+                              compute::sum_reducer<compute::long_>(),
+                              compute::count_reducer(),
+                              compute::argmax_reducer<int>()),
+            queue
+        );
+    BOOST_CHECK_EQUAL(boost::get<0>(r), -5);
+    BOOST_CHECK_EQUAL(boost::get<1>(r), 9);
+    BOOST_CHECK_EQUAL(boost::get<2>(r), compute::long_(25));
+    BOOST_CHECK_EQUAL(boost::get<3>(r), compute::ulong_(8));
+
+    // first of the two maximums
+    BOOST_CHECK_EQUAL(boost::get<4>(r), compute::uint_(2));
+}
+
+BOOST_AUTO_TEST_CASE(statistics_large_range)
+{
+    if(!device.supports_extension("cl_khr_fp64")){
+        std::cout << "skipping test: device does not support double" << std::endl;
+        return;
+    }
+
+    // spans several work-groups to exercise merging of the partials
+    const int n = 100000;
+    compute::vector<float> vector(n, context);
+    compute::iota(vector.begin(), vector.end(), 1.0f, queue);
+
+    boost::tuple<float, float, double, double, compute::uint_> r =
+        compute::multi_reduce(
+            vector.begin(), vector.end(),
+            boost::make_tuple(compute::min_reducer<float>(),
+                              compute::max_reducer<float>(),
+                              compute::mean_reducer<double>(),
+                              compute::variance_reducer<double>(),
+                              compute::argmin_reducer<float>()),
+            queue
+        );
+    BOOST_CHECK_EQUAL(boost::get<0>(r), 1.0f);
+    BOOST_CHECK_EQUAL(boost::get<1>(r), float(n));
+    BOOST_CHECK_CLOSE(boost::get<2>(r), (n + 1) / 2.0, 1e-6);
+    BOOST_CHECK_CLOSE(boost::get<3>(r), (double(n) * n - 1) / 12.0, 1e-4);
+    BOOST_CHECK_EQUAL(boost::get<4>(r), compute::uint_(0));
+}
+
+BOOST_AUTO_TEST_CASE(minmax_element_single_pass)
+{
+    int data[] = { 3, 8, -1, 8, 5, -1, 2 };
+    compute::vector<int> vector(data, data + 7, queue);
+
+    std::pair<compute::vector<int>::iterator, compute::vector<int>::iterator>
+        result = compute::minmax_element(vector.begin(), vector.end(), queue);
+    BOOST_CHECK(result.first == vector.begin() + 2);
+    BOOST_CHECK(result.second == vector.begin() + 1);
+}
+
+BOOST_AUTO_TEST_CASE(minmax_element_char)
+{
+    // types without multi_reduce limits use a pass per extremum
+    char data[] = { 'f', 'c', 'x', 'a', 'm' };
+    compute::vector<char> vector(data, data + 5, queue);
+
+    std::pair<compute::vector<char>::iterator, compute::vector<char>::iterator>
+        result = compute::minmax_element(vector.begin(), vector.end(), queue);
+    BOOST_CHECK(result.first == vector.begin() + 3);
+    BOOST_CHECK(result.second == vector.begin() + 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
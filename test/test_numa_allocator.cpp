@@ -0,0 +1,43 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestNumaAllocator
+#include <boost/test/unit_test.hpp>
+
+#include <boost/compute/allocator/numa_allocator.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(vector_with_numa_allocator)
+{
+    compute::vector<int, compute::numa_allocator<int> > vector(context);
+    vector.push_back(12, queue);
+    vector.push_back(15, queue);
+    CHECK_RANGE_EQUAL(int, 2, vector, (12, 15));
+}
+
+BOOST_AUTO_TEST_CASE(allocate_is_zeroed)
+{
+    compute::numa_allocator<int> allocator(context);
+    compute::numa_allocator<int>::pointer p = allocator.allocate(4);
+
+    int data[4] = { -1, -1, -1, -1 };
+    queue.enqueue_read_buffer(p.get_buffer(), 0, sizeof(data), data);
+    BOOST_CHECK_EQUAL(data[0], 0);
+    BOOST_CHECK_EQUAL(data[3], 0);
+
+    allocator.deallocate(p, 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
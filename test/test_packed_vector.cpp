@@ -0,0 +1,198 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestPackedVector
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <numeric>
+#include <algorithm>
+
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/count_if.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/packed_vector.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+using compute::uint_;
+using compute::int_;
+using compute::ulong_;
+
+template<size_t Bits>
+void check_packed_width(compute::command_queue &queue)
+{
+    const uint_ mask = 0xffffffffu >> (32 - Bits);
+
+    std::vector<uint_> host(300);
+    for(size_t i = 0; i < host.size(); i++){
+        host[i] = uint_(i * 2654435761u) & mask;
+    }
+
+    // pack from a device range
+    compute::vector<uint_> device(host.begin(), host.end(), queue);
+    compute::packed_vector<uint_, Bits> packed(device.begin(), device.end(), queue);
+
+    std::vector<uint_> result(host.size());
+    compute::copy(packed.begin(), packed.end(), result.begin(), queue);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        result.begin(), result.end(), host.begin(), host.end()
+    );
+}
+
+BOOST_AUTO_TEST_CASE(pack_and_copy)
+{
+    std::vector<uint_> host(1000);
+    for(size_t i = 0; i < host.size(); i++){
+        host[i] = uint_((i * 2654435761u) % 4096);
+    }
+
+    compute::packed_vector<uint_, 12> packed(host.begin(), host.end(), queue);
+    BOOST_CHECK_EQUAL(packed.size(), size_t(1000));
+    BOOST_CHECK_EQUAL(packed.num_words(), size_t(376));
+
+    std::vector<uint_> result(host.size());
+    compute::copy(packed.begin(), packed.end(), result.begin(), queue);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        result.begin(), result.end(), host.begin(), host.end()
+    );
+
+    // unaligned sub-range to the device
+    compute::vector<uint_> device(10, context);
+    compute::copy(packed.begin() + 37, packed.begin() + 47, device.begin(), queue);
+
+    std::vector<uint_> sub(10);
+    compute::copy(device.begin(), device.end(), sub.begin(), queue);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        sub.begin(), sub.end(), host.begin() + 37, host.begin() + 47
+    );
+}
+
+BOOST_AUTO_TEST_CASE(pack_widths)
+{
+    check_packed_width<1>(queue);
+    check_packed_width<7>(queue);
+    check_packed_width<16>(queue);
+    check_packed_width<31>(queue);
+    check_packed_width<32>(queue);
+}
+
+BOOST_AUTO_TEST_CASE(signed_values)
+{
+    int_ data[] = { -16, -1, 0, 1, 15, -8, 7, 3, -3 };
+    compute::packed_vector<int_, 5> packed(data, data + 9, queue);
+
+    compute::vector<int_> result(9, context);
+    compute::copy(packed.begin(), packed.end(), result.begin(), queue);
+    CHECK_RANGE_EQUAL(int_, 9, result, (-16, -1, 0, 1, 15, -8, 7, 3, -3));
+}
+
+BOOST_AUTO_TEST_CASE(frame_of_reference)
+{
+    // timestamps which are far too large for 8 bits but increase by less
+    // than 256 within each block
+    std::vector<ulong_> host(1000);
+    host[0] = 1400000000000ul;
+    for(size_t i = 1; i < host.size(); i++){
+        host[i] = host[i-1] + (i % 3);
+    }
+
+    compute::packed_vector<ulong_, 8, true> packed(host.begin(), host.end(), queue);
+    BOOST_CHECK_EQUAL(packed.num_words(), size_t(251));
+
+    std::vector<ulong_> result(host.size());
+    compute::copy(packed.begin(), packed.end(), result.begin(), queue);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        result.begin(), result.end(), host.begin(), host.end()
+    );
+}
+
+bool less_than_100(uint_ x)
+{
+    return x < 100;
+}
+
+BOOST_AUTO_TEST_CASE(algorithms)
+{
+    using compute::lambda::_1;
+
+    std::vector<uint_> host(2000);
+    for(size_t i = 0; i < host.size(); i++){
+        host[i] = uint_((i * 7919) % 1000);
+    }
+
+    compute::packed_vector<uint_, 10> packed(host.begin(), host.end(), queue);
+
+    uint_ sum = 0;
+    compute::reduce(packed.begin(), packed.end(), &sum, queue);
+    BOOST_CHECK_EQUAL(sum, std::accumulate(host.begin(), host.end(), uint_(0)));
+
+    size_t count = compute::count_if(packed.begin(), packed.end(), _1 < 100, queue);
+    BOOST_CHECK_EQUAL(
+        count, size_t(std::count_if(host.begin(), host.end(), less_than_100))
+    );
+
+    compute::vector<uint_> doubled(host.size(), context);
+    compute::transform(
+        packed.begin(), packed.end(), doubled.begin(), _1 * 2, queue
+    );
+    std::vector<uint_> result(host.size());
+    compute::copy(doubled.begin(), doubled.end(), result.begin(), queue);
+    for(size_t i = 0; i < host.size(); i++){
+        BOOST_CHECK_EQUAL(result[i], host[i] * 2);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sort_packed)
+{
+    std::vector<uint_> host(1000);
+    for(size_t i = 0; i < host.size(); i++){
+        host[i] = uint_((i * 2654435761u) % 20000);
+    }
+
+    compute::packed_vector<uint_, 15> packed(host.begin(), host.end(), queue);
+    compute::sort(packed.begin(), packed.end(), queue);
+
+    std::vector<uint_> result(host.size());
+    compute::copy(packed.begin(), packed.end(), result.begin(), queue);
+
+    std::sort(host.begin(), host.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        result.begin(), result.end(), host.begin(), host.end()
+    );
+}
+
+BOOST_AUTO_TEST_CASE(sort_packed_frame_of_reference)
+{
+    std::vector<int_> host(500);
+    for(size_t i = 0; i < host.size(); i++){
+        host[i] = int_(1000000 - (i * 37) % 200);
+    }
+
+    compute::packed_vector<int_, 8, true> packed(host.begin(), host.end(), queue);
+    compute::sort(packed.begin(), packed.end(), queue);
+
+    std::vector<int_> result(host.size());
+    compute::copy(packed.begin(), packed.end(), result.begin(), queue);
+
+    std::sort(host.begin(), host.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        result.begin(), result.end(), host.begin(), host.end()
+    );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
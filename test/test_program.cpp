@@ -11,10 +11,14 @@
 #define BOOST_TEST_MODULE TestProgram
 #include <boost/test/unit_test.hpp>
 
+#include <cstdio>
+
 #include <boost/compute/kernel.hpp>
 #include <boost/compute/source.hpp>
 #include <boost/compute/system.hpp>
 #include <boost/compute/program.hpp>
+#include <boost/compute/kernel_bundle.hpp>
+#include <boost/compute/prefetch_kernels.hpp>
 
 #include "context_setup.hpp"
 
@@ -175,4 +179,86 @@ BOOST_AUTO_TEST_CASE(build_log)
     }
 }
 
+BOOST_AUTO_TEST_CASE(build_from_kernel_bundle)
+{
+    const char bundle_source[] =
+        "__kernel void bundled(__global int *x) { x[0] = 42; }\n";
+
+    // record the binary of the program
+    compute::kernel_bundle::clear();
+    compute::kernel_bundle::set_recording(true);
+    compute::program::build_with_source(bundle_source, context);
+    compute::kernel_bundle::set_recording(false);
+    BOOST_CHECK_EQUAL(compute::kernel_bundle::size(), size_t(1));
+
+    // save and reload the bundle
+    BOOST_CHECK(compute::kernel_bundle::save("test_program.bundle"));
+    compute::kernel_bundle::clear();
+    BOOST_CHECK(compute::kernel_bundle::load("test_program.bundle"));
+    BOOST_CHECK_EQUAL(compute::kernel_bundle::size(), size_t(1));
+    std::remove("test_program.bundle");
+
+    // the program is now created from the bundled binary
+    compute::program program =
+        compute::program::build_with_source(bundle_source, context);
+    compute::kernel kernel = program.create_kernel("bundled");
+    BOOST_CHECK_EQUAL(kernel.name(), "bundled");
+
+    compute::kernel_bundle::clear();
+}
+
+#ifdef CL_VERSION_1_1
+BOOST_AUTO_TEST_CASE(build_with_source_async)
+{
+    REQUIRES_OPENCL_VERSION(1, 1);
+
+    compute::program_future future =
+        compute::program::build_with_source_async(source, context);
+
+    compute::program program = future.get();
+    compute::kernel foo = program.create_kernel("foo");
+    BOOST_CHECK_EQUAL(foo.name(), "foo");
+
+    // the build error is reported by get()
+    const char invalid_source[] =
+        "__kernel void foo(__global int *input) { !@#$%^&*() }";
+    compute::program_future invalid =
+        compute::program::build_with_source_async(invalid_source, context);
+    BOOST_CHECK_THROW(invalid.get(), compute::opencl_error);
+}
+
+BOOST_AUTO_TEST_CASE(prefetch_kernels)
+{
+    REQUIRES_OPENCL_VERSION(1, 1);
+
+    std::vector<std::string> sources(
+        1, "__kernel void prefetched(__global int *x) { x[0] = 1; }\n"
+    );
+
+    // prefetching the same source again either waits for the same build
+    // or finds the built program in the cache
+    std::vector<compute::program_future> first =
+        compute::prefetch_kernels(sources, context);
+    std::vector<compute::program_future> second =
+        compute::prefetch_kernels(sources, context);
+    BOOST_CHECK_EQUAL(first.size(), size_t(1));
+
+    compute::program program = first[0].get();
+    BOOST_CHECK(program.get() != 0);
+    BOOST_CHECK(program.get() == second[0].get().get());
+
+    // algorithms run after the build has completed use the prefetched
+    // program instead of building it again
+    boost::shared_ptr<compute::detail::program_cache> cache =
+        compute::detail::get_program_cache(context);
+    compute::program cached = cache->get_or_build(
+        compute::detail::sha1(sources[0]), std::string(), sources[0], context
+    );
+    BOOST_CHECK(cached.get() == program.get());
+    BOOST_CHECK(
+        cache->get(compute::detail::sha1(sources[0])).get() == program.get()
+    );
+}
+#endif // CL_VERSION_1_1
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -266,4 +266,35 @@ BOOST_AUTO_TEST_CASE(reduce_complex)
     BOOST_CHECK(result == std::complex<float>(-168, -576));
 }
 
+BOOST_AUTO_TEST_CASE(reduce_async_int)
+{
+    int data[] = { 1, 5, 9, 13, 17 };
+    compute::vector<int> vector(data, data + 5, queue);
+
+    compute::future<int> sum =
+        compute::reduce_async(vector.begin(), vector.end(), queue);
+    compute::future<int> product =
+        compute::reduce_async(
+            vector.begin(), vector.end(), compute::multiplies<int>(), queue
+        );
+
+    BOOST_CHECK_EQUAL(sum.get(), 45);
+    BOOST_CHECK_EQUAL(product.get(), 9945);
+}
+
+BOOST_AUTO_TEST_CASE(reduce_async_wait_list)
+{
+    int data[] = { 1, 2, 3, 4 };
+    compute::vector<int> vector(4, context);
+
+    compute::event write = queue.enqueue_write_buffer_async(
+        vector.get_buffer(), 0, 4 * sizeof(int), data
+    );
+
+    compute::future<int> sum = compute::reduce_async(
+        vector.begin(), vector.end(), compute::plus<int>(), queue, write
+    );
+    BOOST_CHECK_EQUAL(sum.get(), 10);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -175,4 +175,21 @@ boost::compute::exclusive_scan(
     CHECK_RANGE_EQUAL(int, 4, output, (0, 1, 3, 6));
 }
 
+BOOST_AUTO_TEST_CASE(scan_async_int)
+{
+    int data[] = { 1, 2, 1, 2, 3 };
+    bc::vector<int> vector(data, data + 5, queue);
+    bc::vector<int> result(5, context);
+
+    bc::future<bc::vector<int>::iterator> future =
+        bc::inclusive_scan_async(vector.begin(), vector.end(), result.begin(), queue);
+    BOOST_CHECK(future.get() == result.end());
+    CHECK_RANGE_EQUAL(int, 5, result, (1, 3, 4, 6, 9));
+
+    bc::exclusive_scan_async(
+        vector.begin(), vector.end(), result.begin(), queue, future.get_event()
+    ).wait();
+    CHECK_RANGE_EQUAL(int, 5, result, (0, 1, 3, 4, 6));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
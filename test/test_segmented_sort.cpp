@@ -0,0 +1,133 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestSegmentedSort
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/segmented_sort.hpp>
+#include <boost/compute/algorithm/segmented_sort_by_key.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/operator.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(sort_small_segments)
+{
+    int data[] = { 5, 2, 9, 7, 1, 3, 8, 6, 4, 0 };
+    compute::vector<int> vector(data, data + 10, queue);
+
+    // segments: [0,3) [3,3) [3,4) [4,10)
+    int offsets_data[] = { 0, 3, 3, 4, 10 };
+    compute::vector<int> offsets(offsets_data, offsets_data + 5, queue);
+
+    compute::segmented_sort(
+        vector.begin(), vector.end(), offsets.begin(), offsets.end(), queue
+    );
+    CHECK_RANGE_EQUAL(int, 10, vector, (2, 5, 9, 7, 0, 1, 3, 4, 6, 8));
+}
+
+BOOST_AUTO_TEST_CASE(sort_greater)
+{
+    float data[] = { 1.5f, 3.5f, 2.5f, 0.5f, 4.5f };
+    compute::vector<float> vector(data, data + 5, queue);
+
+    compute::uint_ offsets_data[] = { 0, 2, 5 };
+    compute::vector<compute::uint_> offsets(offsets_data, offsets_data + 3, queue);
+
+    compute::segmented_sort(
+        vector.begin(), vector.end(), offsets.begin(), offsets.end(),
+        compute::greater<float>(), queue
+    );
+    CHECK_RANGE_EQUAL(float, 5, vector, (3.5f, 1.5f, 4.5f, 2.5f, 0.5f));
+}
+
+BOOST_AUTO_TEST_CASE(sort_large_segments)
+{
+    // segments longer than one tile are sorted by merging
+    std::vector<int> offsets_data;
+    offsets_data.push_back(0);
+    offsets_data.push_back(7);
+    offsets_data.push_back(1000);
+    offsets_data.push_back(1257);
+    offsets_data.push_back(3000);
+
+    std::vector<int> data(3000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = std::rand() % 500;
+    }
+    compute::vector<int> vector(data.begin(), data.end(), queue);
+    compute::vector<int> offsets(offsets_data.begin(), offsets_data.end(), queue);
+
+    compute::segmented_sort(
+        vector.begin(), vector.end(), offsets.begin(), offsets.end(), queue
+    );
+    for(size_t i = 0; i + 1 < offsets_data.size(); i++){
+        std::sort(data.begin() + offsets_data[i], data.begin() + offsets_data[i+1]);
+    }
+
+    std::vector<int> result(data.size());
+    compute::copy(vector.begin(), vector.end(), result.begin(), queue);
+    BOOST_CHECK(result == data);
+}
+
+BOOST_AUTO_TEST_CASE(sort_by_key_segments)
+{
+    int keys_data[] = { 3, 1, 2, 9, 8, 7, 6 };
+    char values_data[] = { 'c', 'a', 'b', 'z', 'y', 'x', 'w' };
+    compute::vector<int> keys(keys_data, keys_data + 7, queue);
+    compute::vector<char> values(values_data, values_data + 7, queue);
+
+    int offsets_data[] = { 0, 3, 7 };
+    compute::vector<int> offsets(offsets_data, offsets_data + 3, queue);
+
+    compute::segmented_sort_by_key(
+        keys.begin(), keys.end(), values.begin(),
+        offsets.begin(), offsets.end(), queue
+    );
+    CHECK_RANGE_EQUAL(int, 7, keys, (1, 2, 3, 6, 7, 8, 9));
+    CHECK_RANGE_EQUAL(char, 7, values, ('a', 'b', 'c', 'w', 'x', 'y', 'z'));
+}
+
+BOOST_AUTO_TEST_CASE(sort_by_key_large_segment)
+{
+    std::vector<compute::uint_> keys_data(1500);
+    std::vector<compute::uint_> values_data(1500);
+    for(size_t i = 0; i < keys_data.size(); i++){
+        keys_data[i] = static_cast<compute::uint_>(keys_data.size() - i);
+        values_data[i] = static_cast<compute::uint_>(i);
+    }
+    compute::vector<compute::uint_> keys(keys_data.begin(), keys_data.end(), queue);
+    compute::vector<compute::uint_> values(values_data.begin(), values_data.end(), queue);
+
+    int offsets_data[] = { 0, 1500 };
+    compute::vector<int> offsets(offsets_data, offsets_data + 2, queue);
+
+    compute::segmented_sort_by_key(
+        keys.begin(), keys.end(), values.begin(),
+        offsets.begin(), offsets.end(), queue
+    );
+
+    std::vector<compute::uint_> result(values_data.size());
+    compute::copy(values.begin(), values.end(), result.begin(), queue);
+    for(size_t i = 0; i < result.size(); i++){
+        BOOST_CHECK_EQUAL(result[i], compute::uint_(result.size() - 1 - i));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
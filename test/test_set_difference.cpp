@@ -59,4 +59,23 @@ BOOST_AUTO_TEST_CASE(set_difference_string)
     BOOST_VERIFY(iter == result.begin()+7);
 }
 
+BOOST_AUTO_TEST_CASE(set_difference_int_device_count)
+{
+    int dataset1[] = {1, 1, 2, 2, 2, 2, 3, 3, 4, 5, 6, 10};
+    bc::vector<bc::int_> set1(dataset1, dataset1 + 12, queue);
+
+    int dataset2[] = {0, 2, 2, 4, 5, 6, 8, 8, 9, 9, 9, 13};
+    bc::vector<bc::int_> set2(dataset2, dataset2 + 12, queue);
+
+    bc::vector<bc::int_> result(12, queue.get_context());
+
+    bc::detail::scalar<bc::uint_> count(queue.get_context());
+    bc::set_difference(set1.begin(), set1.end(),
+                       set2.begin(), set2.end(),
+                       result.begin(), count, queue);
+
+    BOOST_CHECK_EQUAL(count.read(queue), bc::uint_(7));
+    CHECK_RANGE_EQUAL(int, 7, result, (1, 1, 2, 2, 3, 3, 10));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -12,6 +12,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include <boost/compute/system.hpp>
+#include <boost/compute/host_dispatch.hpp>
 #include <boost/compute/algorithm/sort.hpp>
 #include <boost/compute/algorithm/is_sorted.hpp>
 #include <boost/compute/container/vector.hpp>
@@ -277,4 +278,42 @@ BOOST_AUTO_TEST_CASE(sort_host_vector)
     CHECK_RANGE_EQUAL(int, 8, vector, (0, 1, 2, 3, 4, 5, 6, 7));
 }
 
+BOOST_AUTO_TEST_CASE(sort_async_int)
+{
+    int data[] = { 5, 2, 7, 1, 4, 3, 6, 0 };
+    bc::vector<int> vector(data, data + 8, queue);
+
+    bc::future<void> future = bc::sort_async(vector.begin(), vector.end(), queue);
+    future.wait();
+    CHECK_RANGE_EQUAL(int, 8, vector, (0, 1, 2, 3, 4, 5, 6, 7));
+
+    bc::sort_async(
+        vector.begin(), vector.end(), bc::greater<int>(), queue, future.get_event()
+    ).wait();
+    CHECK_RANGE_EQUAL(int, 8, vector, (7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+BOOST_AUTO_TEST_CASE(sort_host_dispatch)
+{
+    using boost::compute::host_dispatch;
+
+    const size_t threshold =
+        host_dispatch::threshold(device, host_dispatch::sort_algorithm);
+
+    int data[] = { 5, 2, 7, 1, 4, 3, 6, 0 };
+    bc::vector<int> vector(data, data + 8, queue);
+
+    // sorted on the host
+    host_dispatch::set_threshold(device, host_dispatch::sort_algorithm, 8);
+    bc::sort(vector.begin() + 2, vector.end(), queue);
+    CHECK_RANGE_EQUAL(int, 8, vector, (5, 2, 0, 1, 3, 4, 6, 7));
+
+    // sorted on the device
+    host_dispatch::set_threshold(device, host_dispatch::sort_algorithm, 0);
+    bc::sort(vector.begin(), vector.end(), queue);
+    CHECK_RANGE_EQUAL(int, 8, vector, (0, 1, 2, 3, 4, 5, 6, 7));
+
+    host_dispatch::set_threshold(device, host_dispatch::sort_algorithm, threshold);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
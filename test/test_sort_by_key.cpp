@@ -15,6 +15,8 @@
 #include <boost/compute/algorithm/sort_by_key.hpp>
 #include <boost/compute/algorithm/is_sorted.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/iterator/zip_iterator.hpp>
 
 #include "check_macros.hpp"
 #include "context_setup.hpp"
@@ -102,4 +104,37 @@ BOOST_AUTO_TEST_CASE(sort_int_and_float)
     BOOST_CHECK(compute::is_sorted(values.begin(), values.end(), queue) == true);
 }
 
+BOOST_AUTO_TEST_CASE(sort_int_with_zip_values)
+{
+    int keys_data[] = { 3, 1, 4, 2 };
+    float prices_data[] = { 3.5f, 1.5f, 4.5f, 2.5f };
+    char codes_data[] = { 'c', 'a', 'd', 'b' };
+    compute::vector<int> keys(keys_data, keys_data + 4, queue);
+    compute::vector<float> prices(prices_data, prices_data + 4, queue);
+    compute::vector<char> codes(codes_data, codes_data + 4, queue);
+
+    compute::sort_by_key(
+        keys.begin(), keys.end(),
+        compute::make_zip_iterator(
+            boost::make_tuple(prices.begin(), codes.begin())
+        ),
+        queue
+    );
+    CHECK_RANGE_EQUAL(int, 4, keys, (1, 2, 3, 4));
+    CHECK_RANGE_EQUAL(float, 4, prices, (1.5f, 2.5f, 3.5f, 4.5f));
+    CHECK_RANGE_EQUAL(char, 4, codes, ('a', 'b', 'c', 'd'));
+
+    compute::sort_by_key(
+        keys.begin(), keys.end(),
+        compute::make_zip_iterator(
+            boost::make_tuple(prices.begin(), codes.begin())
+        ),
+        compute::greater<int>(),
+        queue
+    );
+    CHECK_RANGE_EQUAL(int, 4, keys, (4, 3, 2, 1));
+    CHECK_RANGE_EQUAL(float, 4, prices, (4.5f, 3.5f, 2.5f, 1.5f));
+    CHECK_RANGE_EQUAL(char, 4, codes, ('d', 'c', 'b', 'a'));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
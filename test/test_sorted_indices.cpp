@@ -0,0 +1,99 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestSortedIndices
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/sorted_indices.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/iterator/zip_iterator.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(sorted_indices_int)
+{
+    int data[] = { 40, 10, 30, 20, 10 };
+    compute::vector<int> input(data, data + 5, queue);
+    compute::vector<compute::uint_> indices(5, context);
+
+    compute::sorted_indices(
+        input.begin(), input.end(), indices.begin(), queue
+    );
+    CHECK_RANGE_EQUAL(compute::uint_, 5, indices, (1, 4, 3, 2, 0));
+
+    // the input is left unchanged
+    CHECK_RANGE_EQUAL(int, 5, input, (40, 10, 30, 20, 10));
+}
+
+BOOST_AUTO_TEST_CASE(sorted_indices_large_float)
+{
+    std::vector<float> data(1000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<float>((i * 7919) % 1000);
+    }
+    compute::vector<float> input(data.begin(), data.end(), queue);
+    compute::vector<compute::uint_> indices(data.size(), context);
+
+    compute::sorted_indices(
+        input.begin(), input.end(), indices.begin(), queue
+    );
+
+    std::vector<compute::uint_> host_indices(data.size());
+    compute::copy(indices.begin(), indices.end(), host_indices.begin(), queue);
+    for(size_t i = 0; i < host_indices.size(); i++){
+        BOOST_CHECK_EQUAL(data[host_indices[i]], static_cast<float>(i));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sorted_indices_greater)
+{
+    float data[] = { 1.5f, 4.5f, 2.5f, 3.5f };
+    compute::vector<float> input(data, data + 4, queue);
+    compute::vector<compute::uint_> indices(4, context);
+
+    compute::sorted_indices(
+        input.begin(), input.end(), indices.begin(),
+        compute::greater<float>(), queue
+    );
+    CHECK_RANGE_EQUAL(compute::uint_, 4, indices, (1, 3, 2, 0));
+}
+
+BOOST_AUTO_TEST_CASE(sorted_indices_lexicographic)
+{
+    int years_data[] = { 2014, 2013, 2014, 2013, 2014 };
+    int months_data[] = { 3, 7, 1, 2, 3 };
+    compute::vector<int> years(years_data, years_data + 5, queue);
+    compute::vector<int> months(months_data, months_data + 5, queue);
+    compute::vector<compute::uint_> indices(5, context);
+
+    compute::sorted_indices(
+        compute::make_zip_iterator(
+            boost::make_tuple(years.begin(), months.begin())
+        ),
+        compute::make_zip_iterator(
+            boost::make_tuple(years.end(), months.end())
+        ),
+        indices.begin(),
+        queue
+    );
+
+    // equal keys (rows 0 and 4) keep their order
+    CHECK_RANGE_EQUAL(compute::uint_, 5, indices, (3, 1, 2, 0, 4));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
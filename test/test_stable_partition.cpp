@@ -35,4 +35,16 @@ BOOST_AUTO_TEST_CASE(partition_int)
     BOOST_VERIFY(iter == vector.begin()+5);
 }
 
+BOOST_AUTO_TEST_CASE(partition_int_device_count)
+{
+    int dataset[] = {1, 1, -2, 0, 5, -1, 2, 4, 0, -1};
+    bc::vector<bc::int_> vector(dataset, dataset + 10, queue);
+
+    bc::detail::scalar<bc::uint_> count(context);
+    bc::stable_partition(vector.begin(), vector.end(), bc::_1 > 0, count, queue);
+
+    CHECK_RANGE_EQUAL(int, 10, vector, (1, 1, 5, 2, 4, -2, 0, -1, 0, -1));
+    BOOST_CHECK_EQUAL(count.read(queue), bc::uint_(5));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,153 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestTaskGraph
+#include <boost/test/unit_test.hpp>
+
+#include <boost/compute/async/task_graph.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/operator.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+// fills a vector with a value
+struct fill_task
+{
+    fill_task(compute::vector<int> &vector, int value)
+        : vector(vector), value(value)
+    {
+    }
+
+    void operator()(compute::command_queue &queue) const
+    {
+        compute::fill(vector.begin(), vector.end(), value, queue);
+    }
+
+    compute::vector<int> &vector;
+    int value;
+};
+
+// stores the sum of two vectors in a third
+struct plus_task
+{
+    plus_task(compute::vector<int> &a,
+              compute::vector<int> &b,
+              compute::vector<int> &result)
+        : a(a), b(b), result(result)
+    {
+    }
+
+    void operator()(compute::command_queue &queue) const
+    {
+        compute::transform(
+            a.begin(), a.end(), b.begin(), result.begin(),
+            compute::plus<int>(), queue
+        );
+    }
+
+    compute::vector<int> &a;
+    compute::vector<int> &b;
+    compute::vector<int> &result;
+};
+
+BOOST_AUTO_TEST_CASE(derive_dependencies)
+{
+    compute::vector<int> a(4, context);
+    compute::vector<int> b(4, context);
+    compute::vector<int> c(4, context);
+
+    std::vector<compute::buffer> a_set(1, a.get_buffer());
+    std::vector<compute::buffer> b_set(1, b.get_buffer());
+    std::vector<compute::buffer> c_set(1, c.get_buffer());
+    std::vector<compute::buffer> ab_set(a_set);
+    ab_set.push_back(b.get_buffer());
+    std::vector<compute::buffer> none;
+
+    compute::task_graph graph(queue);
+    compute::task_graph::task_id fill_a =
+        graph.add_task(fill_task(a, 1), none, a_set);
+    compute::task_graph::task_id fill_b =
+        graph.add_task(fill_task(b, 2), none, b_set);
+    compute::task_graph::task_id sum =
+        graph.add_task(plus_task(a, b, c), ab_set, c_set);
+    compute::task_graph::task_id refill_a =
+        graph.add_task(fill_task(a, 3), none, a_set);
+
+    BOOST_CHECK_EQUAL(graph.size(), size_t(4));
+    BOOST_CHECK(graph.dependencies(fill_a).empty());
+    BOOST_CHECK(graph.dependencies(fill_b).empty());
+
+    // read-after-write
+    BOOST_CHECK_EQUAL(graph.dependencies(sum).size(), size_t(2));
+    BOOST_CHECK_EQUAL(graph.dependencies(sum)[0], fill_a);
+    BOOST_CHECK_EQUAL(graph.dependencies(sum)[1], fill_b);
+
+    // write-after-read and write-after-write
+    BOOST_CHECK_EQUAL(graph.dependencies(refill_a).size(), size_t(2));
+    BOOST_CHECK_EQUAL(graph.dependencies(refill_a)[0], fill_a);
+    BOOST_CHECK_EQUAL(graph.dependencies(refill_a)[1], sum);
+
+    graph.wait();
+    CHECK_RANGE_EQUAL(int, 4, a, (3, 3, 3, 3));
+    CHECK_RANGE_EQUAL(int, 4, c, (3, 3, 3, 3));
+}
+
+BOOST_AUTO_TEST_CASE(run_on_multiple_queues)
+{
+    compute::vector<int> a(4, context);
+    compute::vector<int> b(4, context);
+    compute::vector<int> c(4, context);
+
+    std::vector<compute::buffer> a_set(1, a.get_buffer());
+    std::vector<compute::buffer> b_set(1, b.get_buffer());
+    std::vector<compute::buffer> c_set(1, c.get_buffer());
+    std::vector<compute::buffer> ab_set(a_set);
+    ab_set.push_back(b.get_buffer());
+    std::vector<compute::buffer> none;
+
+    compute::task_graph graph(context, 2);
+    compute::task_graph::task_id fill_a =
+        graph.add_task(fill_task(a, 4), none, a_set);
+    compute::task_graph::task_id fill_b =
+        graph.add_task(fill_task(b, 5), none, b_set);
+    graph.add_task(plus_task(a, b, c), ab_set, c_set);
+
+    compute::event done = graph.run();
+    done.wait();
+
+    // independent tasks are spread over both queues
+    BOOST_CHECK(graph.queue_index(fill_a) != graph.queue_index(fill_b));
+
+    CHECK_RANGE_EQUAL(int, 4, c, (9, 9, 9, 9));
+}
+
+BOOST_AUTO_TEST_CASE(explicit_dependency)
+{
+    compute::vector<int> a(4, context);
+    compute::vector<int> b(4, context);
+
+    compute::task_graph graph(queue);
+    compute::task_graph::task_id first = graph.add_task(fill_task(a, 1));
+    compute::task_graph::task_id second = graph.add_task(fill_task(b, 2));
+    BOOST_CHECK(graph.dependencies(second).empty());
+
+    graph.add_dependency(first, second);
+    BOOST_CHECK_EQUAL(graph.dependencies(second).size(), size_t(1));
+
+    graph.wait();
+    CHECK_RANGE_EQUAL(int, 4, b, (2, 2, 2, 2));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
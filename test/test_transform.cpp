@@ -11,10 +11,14 @@
 #define BOOST_TEST_MODULE TestTransform
 #include <boost/test/unit_test.hpp>
 
+#include <vector>
+
 #include <boost/compute/lambda.hpp>
 #include <boost/compute/system.hpp>
 #include <boost/compute/function.hpp>
 #include <boost/compute/functional.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
 #include <boost/compute/algorithm/transform.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/iterator/counting_iterator.hpp>
@@ -279,4 +283,71 @@ BOOST_AUTO_TEST_CASE(field)
     BOOST_CHECK_EQUAL(uint2_(output[1]), uint2_(5, 7));
 }
 
+BOOST_AUTO_TEST_CASE(transform_unaligned_ranges)
+{
+    using compute::lambda::_1;
+    using compute::lambda::_2;
+
+    // odd sizes and offsets so that the ranges have unaligned heads and
+    // partial tails around the vector loads and stores
+    const size_t size = 1003;
+
+    std::vector<int> host_x(size + 3);
+    std::vector<float> host_y(size + 1);
+    for(size_t i = 0; i < host_x.size(); i++){
+        host_x[i] = static_cast<int>(i);
+    }
+    for(size_t i = 0; i < host_y.size(); i++){
+        host_y[i] = 0.5f * i;
+    }
+
+    compute::vector<int> x(host_x.begin(), host_x.end(), queue);
+    compute::vector<float> y(host_y.begin(), host_y.end(), queue);
+    compute::vector<float> z(size + 2, context);
+    compute::fill(z.begin(), z.end(), -1.0f, queue);
+
+    // z <- 2 * x + y
+    compute::transform(
+        x.begin() + 3, x.end(), y.begin() + 1, z.begin() + 1,
+        2.0f * _1 + _2, queue
+    );
+
+    std::vector<float> host_z(size + 2);
+    compute::copy(z.begin(), z.end(), host_z.begin(), queue);
+    BOOST_CHECK_EQUAL(host_z[0], -1.0f);
+    BOOST_CHECK_EQUAL(host_z[size + 1], -1.0f);
+    for(size_t i = 0; i < size; i++){
+        BOOST_CHECK_EQUAL(host_z[i + 1], 2.0f * host_x[i + 3] + host_y[i + 1]);
+    }
+
+    // x <- -x
+    compute::transform(x.begin() + 1, x.end(), x.begin() + 1, _1 * -1, queue);
+
+    compute::copy(x.begin(), x.end(), host_x.begin(), queue);
+    BOOST_CHECK_EQUAL(host_x[0], 0);
+    for(size_t i = 1; i < host_x.size(); i++){
+        BOOST_CHECK_EQUAL(host_x[i], -static_cast<int>(i));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(transform_async_int)
+{
+    int data[] = { -1, -2, 3, 4 };
+    bc::vector<int> input(data, data + 4, queue);
+    bc::vector<int> output(4, context);
+
+    bc::future<bc::vector<int>::iterator> future =
+        bc::transform_async(
+            input.begin(), input.end(), output.begin(), bc::abs<int>(), queue
+        );
+    BOOST_CHECK(future.get() == output.end());
+    CHECK_RANGE_EQUAL(int, 4, output, (1, 2, 3, 4));
+
+    bc::transform_async(
+        input.begin(), input.end(), output.begin(), output.begin(),
+        bc::plus<int>(), queue, future.get_event()
+    ).wait();
+    CHECK_RANGE_EQUAL(int, 4, output, (0, 0, 6, 8));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -34,4 +34,18 @@ BOOST_AUTO_TEST_CASE(unique_copy_int)
     CHECK_RANGE_EQUAL(int, 5, result, (1, 6, 4, 2, 4));
 }
 
+BOOST_AUTO_TEST_CASE(unique_copy_int_device_count)
+{
+    int data[] = {1, 6, 6, 4, 2, 2, 4};
+
+    bc::vector<int> input(data, data + 7, queue);
+    bc::vector<int> result(7, context);
+
+    bc::detail::scalar<bc::uint_> count(context);
+    bc::unique_copy(input.begin(), input.end(), result.begin(), count, queue);
+
+    BOOST_CHECK_EQUAL(count.read(queue), bc::uint_(5));
+    CHECK_RANGE_EQUAL(int, 5, result, (1, 6, 4, 2, 4));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
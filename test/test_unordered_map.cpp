@@ -0,0 +1,107 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestUnorderedMap
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/unordered_map.hpp>
+#include <boost/compute/types/struct.hpp>
+
+// mapped value struct
+struct record
+{
+    int id;
+    float score;
+};
+
+BOOST_COMPUTE_ADAPT_STRUCT(record, record, (id, score))
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(insert_find)
+{
+    compute::unordered_map<int, float> map(context);
+
+    int key_data[] = { 7, 2, 9, 2 };
+    float value_data[] = { 7.5f, 2.5f, 9.5f, -1.f };
+    compute::vector<int> keys(key_data, key_data + 4, queue);
+    compute::vector<float> values(value_data, value_data + 4, queue);
+
+    BOOST_CHECK_EQUAL(
+        map.insert(keys.begin(), keys.end(), values.begin(), queue), size_t(3)
+    );
+    BOOST_CHECK_EQUAL(map.size(), size_t(3));
+
+    int query_data[] = { 9, 3, 7 };
+    compute::vector<int> queries(query_data, query_data + 3, queue);
+    compute::vector<float> result(3, context);
+
+    BOOST_CHECK_EQUAL(
+        map.find(queries.begin(), queries.end(), result.begin(), 0.f, queue),
+        size_t(2)
+    );
+    CHECK_RANGE_EQUAL(float, 3, result, (9.5f, 0.f, 7.5f));
+
+    // missing keys get a default-constructed value
+    compute::fill(result.begin(), result.end(), -1.f, queue);
+    BOOST_CHECK_EQUAL(
+        map.find(queries.begin(), queries.end(), result.begin(), queue),
+        size_t(2)
+    );
+    CHECK_RANGE_EQUAL(float, 3, result, (9.5f, 0.f, 7.5f));
+
+    compute::vector<compute::uint_> found(3, context);
+    map.contains(queries.begin(), queries.end(), found.begin(), queue);
+    CHECK_RANGE_EQUAL(compute::uint_, 3, found, (1, 0, 1));
+
+    BOOST_CHECK_EQUAL(map.erase(queries.begin(), queries.end(), queue), size_t(2));
+    BOOST_CHECK_EQUAL(map.size(), size_t(1));
+}
+
+BOOST_AUTO_TEST_CASE(struct_values)
+{
+    compute::unordered_map<compute::uint_, record> map(context);
+
+    compute::vector<compute::uint_> keys(1000, context);
+    compute::iota(keys.begin(), keys.end(), compute::uint_(0), queue);
+
+    std::vector<record> host_records(1000);
+    for(size_t i = 0; i < host_records.size(); i++){
+        host_records[i].id = static_cast<int>(i);
+        host_records[i].score = static_cast<float>(i) / 2.f;
+    }
+    compute::vector<record> records(host_records.begin(), host_records.end(), queue);
+
+    BOOST_CHECK_EQUAL(
+        map.insert(keys.begin(), keys.end(), records.begin(), queue), size_t(1000)
+    );
+
+    record missing = { -1, 0.f };
+    compute::vector<record> result(1000, context);
+    map.find(keys.begin(), keys.end(), result.begin(), missing, queue);
+
+    std::vector<record> host_result(1000);
+    compute::copy(result.begin(), result.end(), host_result.begin(), queue);
+    for(size_t i = 0; i < host_result.size(); i++){
+        BOOST_CHECK_EQUAL(host_result[i].id, static_cast<int>(i));
+        BOOST_CHECK_EQUAL(host_result[i].score, static_cast<float>(i) / 2.f);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
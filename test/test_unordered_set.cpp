@@ -0,0 +1,101 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestUnorderedSet
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/unordered_set.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(insert_contains)
+{
+    compute::unordered_set<int> set(context);
+    BOOST_CHECK(set.empty());
+
+    int data[] = { 5, 3, 9, 3, 1, 5 };
+    compute::vector<int> keys(data, data + 6, queue);
+
+    BOOST_CHECK_EQUAL(set.insert(keys.begin(), keys.end(), queue), size_t(4));
+    BOOST_CHECK_EQUAL(set.size(), size_t(4));
+
+    // inserting existing keys has no effect
+    BOOST_CHECK_EQUAL(set.insert(keys.begin(), keys.begin() + 2, queue), size_t(0));
+    BOOST_CHECK_EQUAL(set.size(), size_t(4));
+
+    int query_data[] = { 1, 2, 3, 4, 5, 9 };
+    compute::vector<int> queries(query_data, query_data + 6, queue);
+    compute::vector<compute::uint_> result(6, context);
+
+    BOOST_CHECK_EQUAL(
+        set.contains(queries.begin(), queries.end(), result.begin(), queue),
+        size_t(4)
+    );
+    CHECK_RANGE_EQUAL(compute::uint_, 6, result, (1, 0, 1, 0, 1, 1));
+}
+
+BOOST_AUTO_TEST_CASE(erase)
+{
+    compute::unordered_set<compute::uint_> set(context);
+
+    compute::uint_ data[] = { 10, 20, 30, 40 };
+    compute::vector<compute::uint_> keys(data, data + 4, queue);
+    set.insert(keys.begin(), keys.end(), queue);
+
+    BOOST_CHECK_EQUAL(set.erase(keys.begin() + 1, keys.begin() + 3, queue), size_t(2));
+    BOOST_CHECK_EQUAL(set.size(), size_t(2));
+
+    // erasing again finds nothing
+    BOOST_CHECK_EQUAL(set.erase(keys.begin() + 1, keys.begin() + 3, queue), size_t(0));
+
+    compute::vector<compute::uint_> result(4, context);
+    set.count(keys.begin(), keys.end(), result.begin(), queue);
+    CHECK_RANGE_EQUAL(compute::uint_, 4, result, (1, 0, 0, 1));
+
+    // erased keys can be inserted again
+    BOOST_CHECK_EQUAL(set.insert(keys.begin(), keys.end(), queue), size_t(2));
+    set.count(keys.begin(), keys.end(), result.begin(), queue);
+    CHECK_RANGE_EQUAL(compute::uint_, 4, result, (1, 1, 1, 1));
+}
+
+BOOST_AUTO_TEST_CASE(rehash)
+{
+    compute::unordered_set<int> set(context);
+    const size_t initial_buckets = set.bucket_count();
+
+    compute::vector<int> keys(4096, context);
+    compute::iota(keys.begin(), keys.end(), 0, queue);
+
+    BOOST_CHECK_EQUAL(set.insert(keys.begin(), keys.end(), queue), size_t(4096));
+    BOOST_CHECK(set.bucket_count() > initial_buckets);
+    BOOST_CHECK(set.load_factor() <= set.max_load_factor());
+
+    compute::vector<compute::uint_> result(4096, context);
+    BOOST_CHECK_EQUAL(
+        set.contains(keys.begin(), keys.end(), result.begin(), queue),
+        size_t(4096)
+    );
+
+    set.clear(queue);
+    BOOST_CHECK(set.empty());
+    BOOST_CHECK_EQUAL(
+        set.contains(keys.begin(), keys.end(), result.begin(), queue),
+        size_t(0)
+    );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,64 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestZeroCopyAllocator
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/allocator/pinned_allocator.hpp>
+#include <boost/compute/allocator/zero_copy_allocator.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(copy_with_zero_copy_allocator)
+{
+    compute::vector<int, compute::zero_copy_allocator<int> > vector(8, context);
+
+    int data[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    compute::copy(data, data + 8, vector.begin(), queue);
+    CHECK_RANGE_EQUAL(int, 8, vector, (1, 2, 3, 4, 5, 6, 7, 8));
+
+    // modify on the device and copy part of the vector back
+    compute::iota(vector.begin() + 2, vector.begin() + 6, 10, queue);
+
+    std::vector<int> host(4);
+    compute::copy(vector.begin() + 1, vector.begin() + 5, host.begin(), queue);
+    BOOST_CHECK_EQUAL(host[0], 2);
+    BOOST_CHECK_EQUAL(host[1], 10);
+    BOOST_CHECK_EQUAL(host[2], 11);
+    BOOST_CHECK_EQUAL(host[3], 12);
+}
+
+BOOST_AUTO_TEST_CASE(copy_by_mapping_buffers)
+{
+    namespace detail = compute::detail;
+
+    // only buffers from zero_copy_allocator are copied by mapping them
+    compute::vector<int, compute::zero_copy_allocator<int> > zero_copy(8, context);
+    BOOST_CHECK_EQUAL(
+        detail::can_copy_by_mapping(zero_copy.get_buffer()),
+        detail::is_host_unified_device(device)
+    );
+
+    compute::vector<int, compute::pinned_allocator<int> > pinned(8, context);
+    BOOST_CHECK(!detail::can_copy_by_mapping(pinned.get_buffer()));
+
+    compute::vector<int> vector(8, context);
+    BOOST_CHECK(!detail::can_copy_by_mapping(vector.get_buffer()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,264 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+// Builds a kernel bundle with the programs used by a list of algorithms for
+// a list of value types on every available device. Each algorithm is run
+// for several input sizes so that the programs for each of its code paths
+// are built (and recorded).
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/program_options.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/host_dispatch.hpp>
+#include <boost/compute/kernel_bundle.hpp>
+#include <boost/compute/algorithm.hpp>
+#include <boost/compute/container/vector.hpp>
+
+namespace compute = boost::compute;
+namespace po = boost::program_options;
+
+// runs algorithm on size random values of type T, returns false if the
+// algorithm is not known
+template<class T>
+bool run_algorithm(const std::string &algorithm,
+                   size_t size,
+                   compute::command_queue &queue)
+{
+    std::vector<T> host_data(size);
+    for(size_t i = 0; i < size; i++){
+        host_data[i] = static_cast<T>(std::rand() % 128);
+    }
+
+    compute::vector<T> data(host_data.begin(), host_data.end(), queue);
+    compute::vector<T> result(size, queue.get_context());
+
+    if(algorithm == "accumulate"){
+        compute::accumulate(data.begin(), data.end(), T(0), queue);
+    }
+    else if(algorithm == "count"){
+        compute::count(data.begin(), data.end(), T(1), queue);
+    }
+    else if(algorithm == "exclusive_scan"){
+        compute::exclusive_scan(data.begin(), data.end(), result.begin(), queue);
+    }
+    else if(algorithm == "fill"){
+        compute::fill(data.begin(), data.end(), T(1), queue);
+    }
+    else if(algorithm == "find"){
+        compute::find(data.begin(), data.end(), T(1), queue);
+    }
+    else if(algorithm == "inclusive_scan"){
+        compute::inclusive_scan(data.begin(), data.end(), result.begin(), queue);
+    }
+    else if(algorithm == "max_element"){
+        compute::max_element(data.begin(), data.end(), queue);
+    }
+    else if(algorithm == "min_element"){
+        compute::min_element(data.begin(), data.end(), queue);
+    }
+    else if(algorithm == "reduce"){
+        T sum;
+        compute::reduce(data.begin(), data.end(), &sum, queue);
+    }
+    else if(algorithm == "reverse"){
+        compute::reverse(data.begin(), data.end(), queue);
+    }
+    else if(algorithm == "sort"){
+        compute::sort(data.begin(), data.end(), queue);
+    }
+    else if(algorithm == "sort_by_key"){
+        compute::vector<compute::uint_> values(size, queue.get_context());
+        compute::sort_by_key(data.begin(), data.end(), values.begin(), queue);
+    }
+    else if(algorithm == "stable_sort"){
+        compute::stable_sort(data.begin(), data.end(), queue);
+    }
+    else if(algorithm == "unique"){
+        compute::sort(data.begin(), data.end(), queue);
+        compute::unique(data.begin(), data.end(), queue);
+    }
+    else {
+        return false;
+    }
+
+    queue.finish();
+    return true;
+}
+
+// runs algorithm for the type named type_name, returns false if either is
+// not known or the type is not supported by the device
+bool run_algorithm(const std::string &algorithm,
+                   const std::string &type_name,
+                   size_t size,
+                   compute::command_queue &queue)
+{
+    if(type_name == "char"){
+        return run_algorithm<compute::char_>(algorithm, size, queue);
+    }
+    else if(type_name == "uchar"){
+        return run_algorithm<compute::uchar_>(algorithm, size, queue);
+    }
+    else if(type_name == "short"){
+        return run_algorithm<compute::short_>(algorithm, size, queue);
+    }
+    else if(type_name == "ushort"){
+        return run_algorithm<compute::ushort_>(algorithm, size, queue);
+    }
+    else if(type_name == "int"){
+        return run_algorithm<compute::int_>(algorithm, size, queue);
+    }
+    else if(type_name == "uint"){
+        return run_algorithm<compute::uint_>(algorithm, size, queue);
+    }
+    else if(type_name == "long"){
+        return run_algorithm<compute::long_>(algorithm, size, queue);
+    }
+    else if(type_name == "ulong"){
+        return run_algorithm<compute::ulong_>(algorithm, size, queue);
+    }
+    else if(type_name == "float"){
+        return run_algorithm<compute::float_>(algorithm, size, queue);
+    }
+    else if(type_name == "double"){
+        if(!queue.get_device().supports_extension("cl_khr_fp64")){
+            return false;
+        }
+        return run_algorithm<compute::double_>(algorithm, size, queue);
+    }
+
+    return false;
+}
+
+// writes the bundle at bundle_path as a c++ header defining the array
+// boost_compute_kernel_bundle_data
+bool write_header(const std::string &bundle_path, const std::string &header_path)
+{
+    std::ifstream input(bundle_path.c_str(), std::ios::in | std::ios::binary);
+    std::vector<unsigned char> data(
+        (std::istreambuf_iterator<char>(input)),
+        std::istreambuf_iterator<char>()
+    );
+
+    std::ofstream output(header_path.c_str());
+    if(!input || !output){
+        return false;
+    }
+
+    output << "// generated by build_kernel_bundle, do not edit\n"
+           << "static const unsigned char boost_compute_kernel_bundle_data[] = {";
+    for(size_t i = 0; i < data.size(); i++){
+        output << (i % 12 == 0 ? "\n    " : " ")
+               << "0x" << std::hex << std::setw(2) << std::setfill('0')
+               << static_cast<unsigned int>(data[i]) << ",";
+    }
+    output << "\n};\n";
+
+    return static_cast<bool>(output);
+}
+
+int main(int argc, char *argv[])
+{
+    // setup command line arguments
+    po::options_description options("options");
+    options.add_options()
+        ("help", "show usage instructions")
+        ("output", po::value<std::string>()->default_value("boost_compute_kernels.bundle"),
+            "bundle file to write")
+        ("header", po::value<std::string>(),
+            "c++ header with the embedded bundle to write")
+        ("algorithms", po::value<std::string>()->default_value(
+            "accumulate,exclusive_scan,inclusive_scan,reduce,sort,sort_by_key"),
+            "comma-separated list of algorithms")
+        ("types", po::value<std::string>()->default_value("int,uint,float"),
+            "comma-separated list of value types")
+        ("sizes", po::value<std::string>()->default_value("16,1024,1048576"),
+            "comma-separated list of input sizes")
+    ;
+
+    // parse command line
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, options), vm);
+    po::notify(vm);
+
+    // check command line arguments
+    if(vm.count("help")){
+        std::cout << options << std::endl;
+        return 0;
+    }
+
+    std::vector<std::string> algorithms;
+    std::vector<std::string> types;
+    std::vector<std::string> sizes;
+    boost::split(algorithms, vm["algorithms"].as<std::string>(), boost::is_any_of(","));
+    boost::split(types, vm["types"].as<std::string>(), boost::is_any_of(","));
+    boost::split(sizes, vm["sizes"].as<std::string>(), boost::is_any_of(","));
+
+    compute::kernel_bundle::clear();
+    compute::kernel_bundle::set_recording(true);
+
+    std::vector<compute::device> devices = compute::system::devices();
+    for(size_t d = 0; d < devices.size(); d++){
+        const compute::device &device = devices[d];
+        std::cout << "device: " << device.name() << std::endl;
+
+        compute::context context(device);
+        compute::command_queue queue(context, device);
+
+        // always run the algorithms on the device
+        for(size_t i = 0; i < compute::host_dispatch::algorithm_count; i++){
+            compute::host_dispatch::set_threshold(
+                device, static_cast<compute::host_dispatch::algorithm>(i), 0
+            );
+        }
+
+        for(size_t a = 0; a < algorithms.size(); a++){
+            for(size_t t = 0; t < types.size(); t++){
+                for(size_t s = 0; s < sizes.size(); s++){
+                    const size_t size =
+                        static_cast<size_t>(std::strtoul(sizes[s].c_str(), 0, 10));
+
+                    if(!run_algorithm(algorithms[a], types[t], size, queue)){
+                        std::cerr << "  skipping " << algorithms[a]
+                                  << "<" << types[t] << ">" << std::endl;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    compute::kernel_bundle::set_recording(false);
+
+    const std::string output = vm["output"].as<std::string>();
+    if(!compute::kernel_bundle::save(output)){
+        std::cerr << "failed to write " << output << std::endl;
+        return -1;
+    }
+    std::cout << "wrote " << compute::kernel_bundle::size()
+              << " programs to " << output << std::endl;
+
+    if(vm.count("header")){
+        const std::string header = vm["header"].as<std::string>();
+        if(!write_header(output, header)){
+            std::cerr << "failed to write " << header << std::endl;
+            return -1;
+        }
+    }
+
+    return 0;
+}